@@ -0,0 +1,64 @@
+# Compiles a shader to SPIR-V through a content-addressed cache
+#
+# Run in script mode with:
+# - GLSLANG_VALIDATOR: the compiler
+# - COMPILER_ID:       identifies the version of the compiler
+# - SHADER:            the shader to compile
+# - INCLUDE_DIR:       the directory of the <...> includes
+# - OUTPUT:            the SPIR-V file to write
+# - DEPFILE:           the depfile to write, listing the shader and its includes
+# - CACHE_DIR:         the cache directory
+#
+# The key of the cache is the hash of the compiler, of the shader and of all its includes,
+# a shader is compiled only if no identical one was compiled before, by any sample.
+
+include(${CMAKE_CURRENT_LIST_DIR}/ShaderIncludes.cmake)
+
+lug_shader_includes(${SHADER} ${INCLUDE_DIR} includes)
+
+set(key_input "${COMPILER_ID}")
+
+foreach(file ${SHADER} ${includes})
+    file(SHA256 ${file} file_hash)
+    set(key_input "${key_input};${file_hash}")
+endforeach()
+
+string(SHA256 key "${key_input}")
+set(cached ${CACHE_DIR}/${key}.spv)
+
+if(NOT EXISTS ${cached})
+    file(MAKE_DIRECTORY ${CACHE_DIR})
+
+    # Compile to a temporary file that is then renamed, a concurrent build never sees a partial entry
+    string(RANDOM LENGTH 8 suffix)
+    set(temporary ${cached}.${suffix})
+
+    execute_process(
+        COMMAND ${GLSLANG_VALIDATOR} -V -I${INCLUDE_DIR} ${SHADER} -o ${temporary}
+        RESULT_VARIABLE result
+        OUTPUT_VARIABLE output
+        ERROR_VARIABLE output
+    )
+
+    if(NOT result EQUAL 0)
+        file(REMOVE ${temporary})
+        message(FATAL_ERROR "Can't compile ${SHADER}:\n${output}")
+    endif()
+
+    file(RENAME ${temporary} ${cached})
+endif()
+
+# The output must be rewritten to be newer than its dependencies
+get_filename_component(output_directory ${OUTPUT} DIRECTORY)
+file(MAKE_DIRECTORY ${output_directory})
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy ${cached} ${OUTPUT})
+
+set(dependencies)
+
+foreach(file ${SHADER} ${includes})
+    string(REPLACE " " "\\ " file ${file})
+    set(dependencies "${dependencies} ${file}")
+endforeach()
+
+string(REPLACE " " "\\ " escaped_output ${OUTPUT})
+file(WRITE ${DEPFILE} "${escaped_output}:${dependencies}\n")
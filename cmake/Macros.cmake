@@ -1,5 +1,13 @@
 include(CMakeParseArguments)
 
+set(LUG_CMAKE_DIR ${CMAKE_CURRENT_LIST_DIR})
+include(${LUG_CMAKE_DIR}/ShaderIncludes.cmake)
+
+# the depfiles of the shaders list absolute paths
+if(POLICY CMP0116)
+    cmake_policy(SET CMP0116 NEW)
+endif()
+
 set(LUG_SHADERS_DIR "shaders")
 set(PROJECT_SHADERS_ROOT "shaders")
 
@@ -31,7 +39,195 @@ macro(lug_add_compile_options target)
     endif()
 endmacro()
 
+# unity build and precompiled headers, both need CMake 3.16
+set(LUG_SAMPLES_PRECOMPILED_HEADERS_LIST
+    <memory>
+    <string>
+    <vector>
+    <lug/Core/Application.hpp>
+    <lug/Graphics/Renderer.hpp>
+    <lug/System/Logger/Logger.hpp>
+)
+
+macro(lug_add_build_speedups target)
+    if(NOT CMAKE_VERSION VERSION_LESS 3.16)
+        if(LUG_SAMPLES_UNITY_BUILD)
+            set_target_properties(${target} PROPERTIES UNITY_BUILD ON)
+        endif()
+
+        if(LUG_SAMPLES_PRECOMPILED_HEADERS)
+            target_precompile_headers(${target} PRIVATE ${LUG_SAMPLES_PRECOMPILED_HEADERS_LIST})
+        endif()
+    endif()
+endmacro()
+
+# library shared by the samples
+function(lug_add_samples_common)
+    # Built once, by the first sample, the others link to it
+    if(TARGET lug_samples_common)
+        return()
+    endif()
+
+    set(common_directory ${LUG_CMAKE_DIR}/../sample_common)
+
+    set(SRC
+        ${common_directory}/src/Archive.cpp
+        ${common_directory}/src/ArchiveWriter.cpp
+        ${common_directory}/src/AsyncHandler.cpp
+        ${common_directory}/src/BlockCompress.cpp
+        ${common_directory}/src/FramePacer.cpp
+        ${common_directory}/src/ImageFile.cpp
+        ${common_directory}/src/InputRecording.cpp
+        ${common_directory}/src/LoggingBenchmark.cpp
+        ${common_directory}/src/Lz4.cpp
+        ${common_directory}/src/MipFileWriter.cpp
+        ${common_directory}/src/MipGenerator.cpp
+        ${common_directory}/src/MipStreamer.cpp
+        ${common_directory}/src/PerfOverlay.cpp
+        ${common_directory}/src/PixelConvert.cpp
+        ${common_directory}/src/ProceduralMesh.cpp
+        ${common_directory}/src/ResourceFileSystem.cpp
+        ${common_directory}/src/SampleApplication.cpp
+        ${common_directory}/src/SampleRuntime.cpp
+        ${common_directory}/src/SampleScene.cpp
+        ${common_directory}/src/SampleTest.cpp
+        ${common_directory}/src/SpinAnimation.cpp
+        ${common_directory}/src/TextureCache.cpp
+        ${common_directory}/src/TextureResidency.cpp
+        ${common_directory}/src/Trace.cpp
+    )
+    source_group("src" FILES ${SRC})
+
+    set(INC
+        ${common_directory}/include/Archive.hpp
+        ${common_directory}/include/ArchiveFormat.hpp
+        ${common_directory}/include/ArchiveWriter.hpp
+        ${common_directory}/include/AsyncHandler.hpp
+        ${common_directory}/include/BlockCompress.hpp
+        ${common_directory}/include/FramePacer.hpp
+        ${common_directory}/include/ImageFile.hpp
+        ${common_directory}/include/InputRecording.hpp
+        ${common_directory}/include/LoggingBenchmark.hpp
+        ${common_directory}/include/Lz4.hpp
+        ${common_directory}/include/MipFileWriter.hpp
+        ${common_directory}/include/MipGenerator.hpp
+        ${common_directory}/include/MipFormat.hpp
+        ${common_directory}/include/MipStreamer.hpp
+        ${common_directory}/include/PerfOverlay.hpp
+        ${common_directory}/include/PixelConvert.hpp
+        ${common_directory}/include/ProceduralMesh.hpp
+        ${common_directory}/include/ResourceFileSystem.hpp
+        ${common_directory}/include/SampleApplication.hpp
+        ${common_directory}/include/SampleRuntime.hpp
+        ${common_directory}/include/SampleScene.hpp
+        ${common_directory}/include/SampleTest.hpp
+        ${common_directory}/include/SpinAnimation.hpp
+        ${common_directory}/include/TextureCache.hpp
+        ${common_directory}/include/TextureResidency.hpp
+        ${common_directory}/include/Trace.hpp
+    )
+    source_group("inc" FILES ${INC})
+
+    add_library(lug_samples_common STATIC ${SRC} ${INC})
+
+    # The library is created by the first sample, it must not see the include directories of that sample
+    set_property(TARGET lug_samples_common PROPERTY INCLUDE_DIRECTORIES "")
+
+    target_include_directories(lug_samples_common PUBLIC ${common_directory}/include)
+    target_include_directories(lug_samples_common PRIVATE
+        ${VULKAN_INCLUDE_DIR}
+        ${FMT_INCLUDE_DIR}
+        ${IMGUI_INCLUDE_DIR}
+        ${LUG_INCLUDE_DIR}
+    )
+
+    # AsyncHandler, LoggingBenchmark, the mip generation and streaming and Trace run threads
+    find_package(Threads REQUIRED)
+    target_link_libraries(lug_samples_common PUBLIC Threads::Threads)
+
+    # stb decodes the images read by the samples themselves
+    if (NOT EXISTS "${LUG_THIRDPARTY_DIR}/stb")
+        message(FATAL_ERROR "Can't find stb in the thirdparty directory")
+    endif()
+
+    target_include_directories(lug_samples_common PRIVATE ${LUG_THIRDPARTY_DIR}/stb/include)
+
+    # linked in the shared libraries of the samples on android
+    set_target_properties(lug_samples_common PROPERTIES POSITION_INDEPENDENT_CODE ON)
+
+    lug_add_compile_options(lug_samples_common)
+    lug_add_build_speedups(lug_samples_common)
+
+    if(LUG_SAMPLES_TRACE)
+        target_compile_definitions(lug_samples_common PUBLIC SAMPLE_TRACE)
+    endif()
+endfunction()
+
 # shaders
+function(lug_add_shared_shader shader shader_target shader_output)
+    string(MAKE_C_IDENTIFIER ${shader} shader_id)
+
+    set(target "shader-${shader_id}")
+    set(output ${CMAKE_BINARY_DIR}/shaders-spirv/${shader}.spv)
+
+    # The first sample using a shader creates the target, the others depend on it
+    if(NOT TARGET ${target})
+        lug_set_option(LUG_SHADERS_CACHE_DIR "${CMAKE_BINARY_DIR}/shaders-cache" PATH "Choose the directory of the compiled shaders cache")
+
+        find_program(LUG_GLSLANG_VALIDATOR glslangValidator HINTS $ENV{VULKAN_SDK}/bin)
+        if(NOT LUG_GLSLANG_VALIDATOR)
+            set(LUG_GLSLANG_VALIDATOR glslangValidator)
+        endif()
+
+        # Part of the cache key, a new compiler doesn't reuse the shaders of the previous one
+        get_property(compiler_id GLOBAL PROPERTY LUG_SHADERS_COMPILER_ID)
+        if(NOT compiler_id)
+            execute_process(COMMAND ${LUG_GLSLANG_VALIDATOR} --version OUTPUT_VARIABLE compiler_version ERROR_QUIET)
+            string(MD5 compiler_id "${LUG_GLSLANG_VALIDATOR} ${compiler_version}")
+            set_property(GLOBAL PROPERTY LUG_SHADERS_COMPILER_ID ${compiler_id})
+        endif()
+
+        set(source ${LUG_RESOURCES_DIR}/${LUG_SHADERS_DIR}/${shader})
+        set(include_directory ${LUG_RESOURCES_DIR}/${LUG_SHADERS_DIR})
+        set(depfile ${output}.d)
+
+        # Without depfile support, the includes found at configure time are the dependencies. The
+        # depfiles work with Ninja from CMake 3.7, the Makefiles from 3.20 and the other generators
+        # (Visual Studio, Xcode) from 3.21
+        if((CMAKE_GENERATOR MATCHES "Ninja" AND NOT CMAKE_VERSION VERSION_LESS 3.7)
+            OR (CMAKE_GENERATOR MATCHES "Makefiles" AND NOT CMAKE_VERSION VERSION_LESS 3.20)
+            OR NOT CMAKE_VERSION VERSION_LESS 3.21)
+            set(depfile_option DEPFILE ${depfile})
+            set(includes)
+        else()
+            set(depfile_option)
+            lug_shader_includes(${source} ${include_directory} includes)
+        endif()
+
+        add_custom_command(
+            OUTPUT ${output}
+            DEPENDS ${source} ${includes} ${LUG_CMAKE_DIR}/CompileShader.cmake
+            ${depfile_option}
+            COMMAND ${CMAKE_COMMAND}
+                -DGLSLANG_VALIDATOR=${LUG_GLSLANG_VALIDATOR}
+                -DCOMPILER_ID=${compiler_id}
+                -DSHADER=${source}
+                -DINCLUDE_DIR=${include_directory}
+                -DOUTPUT=${output}
+                -DDEPFILE=${depfile}
+                -DCACHE_DIR=${LUG_SHADERS_CACHE_DIR}
+                -P ${LUG_CMAKE_DIR}/CompileShader.cmake
+
+            COMMENT "Compiling shader ${source}"
+        )
+
+        add_custom_target(${target} DEPENDS ${output})
+    endif()
+
+    set(${shader_target} ${target} PARENT_SCOPE)
+    set(${shader_output} ${output} PARENT_SCOPE)
+endfunction()
+
 macro(add_shader shader)
     # Select where to copy the resource
     if(LUG_OS_ANDROID)
@@ -54,15 +250,18 @@ macro(add_shader shader)
             COMMENT "Copying shader ${old_path} to ${new_path}"
         )
     else()
-        # Compile the shader
+        # The shader is compiled once for all the samples, and linked
+        lug_add_shared_shader(${shader} shared_target shared_path)
+
         add_custom_command(
             OUTPUT ${new_path}
-            DEPENDS ${old_path}
-            COMMAND ${CMAKE_COMMAND} -E make_directory ${new_path_directory}
-            COMMAND glslangValidator -V ${old_path} -o ${new_path}
+            DEPENDS ${shared_path}
+            COMMAND ${CMAKE_COMMAND} -DSOURCE=${shared_path} -DDESTINATION=${new_path} -DLINK=ON -P ${LUG_CMAKE_DIR}/StageFile.cmake
 
-            COMMENT "Compiling shader ${old_path} to ${new_path}"
+            COMMENT "Linking shader ${shared_path} to ${new_path}"
         )
+
+        list(APPEND SHADERS_TARGETS ${shared_target})
     endif()
 
     list(APPEND SHADERS_DEPENDS ${new_path})
@@ -81,29 +280,70 @@ macro(add_shaders target)
 
     add_custom_target(${target_shaders} DEPENDS ${SHADERS_DEPENDS})
     add_dependencies(${target} ${target_shaders})
+
+    if(SHADERS_TARGETS)
+        add_dependencies(${target_shaders} ${SHADERS_TARGETS})
+    endif()
 endmacro()
 
 # resources
+function(lug_add_staged_resource directory resource resource_target resource_output)
+    # The same relative path can exist in the Lugdunum resources and in the samples' ones
+    string(MD5 directory_hash ${directory})
+    string(SUBSTRING ${directory_hash} 0 8 directory_id)
+    string(MAKE_C_IDENTIFIER "${directory_id}_${resource}" resource_id)
+
+    set(target "resource-${resource_id}")
+    set(output ${CMAKE_BINARY_DIR}/resources-staged/${directory_id}/${resource})
+
+    # Copied once for the whole build tree, the samples link to this copy and never to the source tree
+    if(NOT TARGET ${target})
+        add_custom_command(
+            OUTPUT ${output}
+            DEPENDS ${directory}/${resource}
+            COMMAND ${CMAKE_COMMAND} -DSOURCE=${directory}/${resource} -DDESTINATION=${output} -P ${LUG_CMAKE_DIR}/StageFile.cmake
+
+            COMMENT "Staging ${directory}/${resource}"
+        )
+
+        add_custom_target(${target} DEPENDS ${output})
+    endif()
+
+    set(${resource_target} ${target} PARENT_SCOPE)
+    set(${resource_output} ${output} PARENT_SCOPE)
+endfunction()
+
 macro(add_resource target_resources directory resource)
-    # Select where to copy the resource
     if(LUG_OS_ANDROID)
         set(new_path ${ANDROID_PROJECT_ASSETS}/${resource})
+        set(old_path ${directory}/${resource})
+        get_filename_component(new_path_directory ${new_path} DIRECTORY)
+
+        # Custom command to create the directory and copy the resource
+        add_custom_command(
+            OUTPUT ${new_path}
+            DEPENDS ${old_path}
+            COMMAND ${CMAKE_COMMAND} -E make_directory ${new_path_directory}
+            COMMAND ${CMAKE_COMMAND} -E copy ${old_path} ${new_path}
+
+            COMMENT "Copying ${old_path} to ${new_path}"
+        )
     else()
         set(new_path ${CMAKE_CURRENT_BINARY_DIR}/${resource})
-    endif()
 
-    set(old_path ${directory}/${resource})
-    get_filename_component(new_path_directory ${new_path} DIRECTORY)
+        # Hard link the staged resource, copied only if it can't be linked
+        lug_add_staged_resource(${directory} ${resource} staged_target staged_path)
 
-    # Custom command to create the directory and copy the resource
-    add_custom_command(
-        OUTPUT ${new_path}
-        DEPENDS ${old_path}
-        COMMAND ${CMAKE_COMMAND} -E make_directory ${new_path_directory}
-        COMMAND ${CMAKE_COMMAND} -E copy ${old_path} ${new_path}
+        add_custom_command(
+            OUTPUT ${new_path}
+            DEPENDS ${staged_path}
+            COMMAND ${CMAKE_COMMAND} -DSOURCE=${staged_path} -DDESTINATION=${new_path} -DLINK=ON -P ${LUG_CMAKE_DIR}/StageFile.cmake
 
-        COMMENT "Copying ${old_path} to ${new_path}"
-    )
+            COMMENT "Linking ${staged_path} to ${new_path}"
+        )
+
+        list(APPEND ${target_resources}_TARGETS ${staged_target})
+    endif()
 
     list(APPEND ${target_resources}_DEPENDS ${new_path})
 endmacro()
@@ -117,12 +357,108 @@ macro(add_resources target target_resources directory)
     # Link new resources files to the target
     add_custom_target(${target_resources} DEPENDS ${${target_resources}_DEPENDS})
     add_dependencies(${target} ${target_resources})
+
+    if(${target_resources}_TARGETS)
+        add_dependencies(${target_resources} ${${target_resources}_TARGETS})
+    endif()
+endmacro()
+
+# resource archives
+macro(add_packed_resources target directory)
+    set(archive ${CMAKE_CURRENT_BINARY_DIR}/resources.luga)
+
+    set(packed_sources)
+    foreach(resource ${ARGN})
+        list(APPEND packed_sources ${directory}/${resource})
+    endforeach(resource)
+
+    # The packer runs on the host, built once for all the samples
+    if(NOT TARGET lug-pack-resources)
+        add_executable(lug-pack-resources
+            ${LUG_CMAKE_DIR}/../tools/PackResources.cpp
+            ${LUG_CMAKE_DIR}/../sample_common/src/ArchiveWriter.cpp
+            ${LUG_CMAKE_DIR}/../sample_common/src/Lz4.cpp
+        )
+
+        target_include_directories(lug-pack-resources PRIVATE ${LUG_CMAKE_DIR}/../sample_common/include)
+        lug_add_compile_options(lug-pack-resources)
+    endif()
+
+    # The entries that don't shrink are stored as is either way
+    lug_set_option(LUG_SAMPLES_COMPRESS_RESOURCES FALSE BOOL "Compress the packed resources")
+
+    set(pack_options)
+    if(LUG_SAMPLES_COMPRESS_RESOURCES)
+        set(pack_options --compress)
+    endif()
+
+    add_custom_command(
+        OUTPUT ${archive}
+        DEPENDS lug-pack-resources ${packed_sources}
+        COMMAND lug-pack-resources ${pack_options} ${archive} ${directory} ${ARGN}
+
+        COMMENT "Packing the resources of ${target} in ${archive}"
+    )
+
+    add_custom_target("packed-resources-${target}" DEPENDS ${archive})
+    add_dependencies(${target} "packed-resources-${target}")
+endmacro()
+
+# cooked textures
+macro(add_cooked_texture cooked_textures directory content texture)
+    # textures/name.jpg is cooked in textures/name.lugm
+    string(REGEX REPLACE "\\.[^./]*$" ".lugm" cooked ${CMAKE_CURRENT_BINARY_DIR}/${texture})
+    get_filename_component(cooked_directory ${cooked} DIRECTORY)
+
+    add_custom_command(
+        OUTPUT ${cooked}
+        DEPENDS lug-cook-mips ${directory}/${texture}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${cooked_directory}
+        COMMAND lug-cook-mips --content ${content} --format ${LUG_COOKED_TEXTURE_FORMAT} --quality ${LUG_COOKED_TEXTURE_QUALITY} ${cooked} ${directory}/${texture}
+
+        COMMENT "Cooking the ${content} mips of ${texture} in ${cooked}"
+    )
+
+    list(APPEND ${cooked_textures} ${cooked})
+endmacro()
+
+# the content of the textures decides how their mips are filtered: COLOR (sRGB), LINEAR or NORMAL (normal maps)
+macro(add_cooked_textures target directory)
+    cmake_parse_arguments(COOKED "" "" "COLOR;LINEAR;NORMAL" ${ARGN})
+
+    # auto compresses the normal maps in BC5, the translucent textures in BC3 and the others in BC1
+    lug_set_option(LUG_COOKED_TEXTURE_FORMAT auto STRING "Choose the format of the cooked textures (rgba8, auto, bc1, bc3 or bc5)")
+    lug_set_option(LUG_COOKED_TEXTURE_QUALITY normal STRING "Choose the quality of the block compression of the cooked textures (fast, normal or high)")
+
+    # The cooker runs on the host, built once for all the samples, it decodes the images with ImageFile
+    if(NOT TARGET lug-cook-mips)
+        add_executable(lug-cook-mips ${LUG_CMAKE_DIR}/../tools/CookMips.cpp)
+        target_link_libraries(lug-cook-mips lug_samples_common ${LUG_LIBRARIES})
+        lug_add_compile_options(lug-cook-mips)
+    endif()
+
+    set(cooked_textures)
+
+    foreach(texture ${COOKED_COLOR})
+        add_cooked_texture(cooked_textures ${directory} color ${texture})
+    endforeach(texture)
+
+    foreach(texture ${COOKED_LINEAR})
+        add_cooked_texture(cooked_textures ${directory} linear ${texture})
+    endforeach(texture)
+
+    foreach(texture ${COOKED_NORMAL})
+        add_cooked_texture(cooked_textures ${directory} normal ${texture})
+    endforeach(texture)
+
+    add_custom_target("cooked-textures-${target}" DEPENDS ${cooked_textures})
+    add_dependencies(${target} "cooked-textures-${target}")
 endmacro()
 
 # macro to add a sample
 macro(lug_add_sample target)
     # parse the arguments
-    cmake_parse_arguments(THIS "" "" "SOURCES;DEPENDS;SHADERS;EXTERNAL_LIBS;LUG_RESOURCES;OTHER_RESOURCES" ${ARGN})
+    cmake_parse_arguments(THIS "" "" "SOURCES;DEPENDS;SHADERS;EXTERNAL_LIBS;LUG_RESOURCES;OTHER_RESOURCES;PACKED_RESOURCES;COOKED_TEXTURES;COOKED_LINEAR_TEXTURES;COOKED_NORMAL_MAPS" ${ARGN})
 
     # find Vulkan
     find_package(Vulkan)
@@ -177,6 +513,19 @@ macro(lug_add_sample target)
 
     lug_add_compile_options(${target})
 
+    # trace zones of the samples, compiled out when disabled
+    lug_set_option(LUG_SAMPLES_TRACE TRUE BOOL "Record the trace zones of the samples")
+
+    # faster builds of the samples and of their common library
+    lug_set_option(LUG_SAMPLES_UNITY_BUILD FALSE BOOL "Build the sources of each sample as one translation unit (CMake 3.16)")
+    lug_set_option(LUG_SAMPLES_PRECOMPILED_HEADERS FALSE BOOL "Precompile the headers included by all the samples (CMake 3.16)")
+
+    if((LUG_SAMPLES_UNITY_BUILD OR LUG_SAMPLES_PRECOMPILED_HEADERS) AND CMAKE_VERSION VERSION_LESS 3.16)
+        message(STATUS "Unity builds and precompiled headers need CMake 3.16, they are disabled")
+    endif()
+
+    lug_add_build_speedups(${target})
+
     # link the target to its external dependencies
     if(THIS_EXTERNAL_LIBS)
         target_link_libraries(${target} ${THIS_EXTERNAL_LIBS})
@@ -184,7 +533,10 @@ macro(lug_add_sample target)
 
     # use lugdunum
     include_directories(${LUG_INCLUDE_DIR})
-    target_link_libraries(${target} ${LUG_LIBRARIES})
+
+    # use the common library, before lugdunum that it depends on
+    lug_add_samples_common()
+    target_link_libraries(${target} lug_samples_common ${LUG_LIBRARIES})
 
     # copy / build shaders
     if(THIS_SHADERS)
@@ -200,4 +552,37 @@ macro(lug_add_sample target)
     if(THIS_OTHER_RESOURCES)
         add_resources(${target} "sample-resources-${target}" "${CMAKE_SOURCE_DIR}/resources" ${THIS_OTHER_RESOURCES})
     endif()
+
+    # pack the resources the sample reads itself, the assets of android are packed by the apk
+    if(THIS_PACKED_RESOURCES AND NOT LUG_OS_ANDROID)
+        add_packed_resources(${target} "${CMAKE_SOURCE_DIR}/resources" ${THIS_PACKED_RESOURCES})
+    endif()
+
+    # cook the textures the sample streams itself in mip order
+    if((THIS_COOKED_TEXTURES OR THIS_COOKED_LINEAR_TEXTURES OR THIS_COOKED_NORMAL_MAPS) AND NOT LUG_OS_ANDROID)
+        add_cooked_textures(${target} "${CMAKE_SOURCE_DIR}/resources"
+            COLOR ${THIS_COOKED_TEXTURES}
+            LINEAR ${THIS_COOKED_LINEAR_TEXTURES}
+            NORMAL ${THIS_COOKED_NORMAL_MAPS}
+        )
+    endif()
+endmacro()
+
+# macro to add a test of a sample, an executable checking the CPU side of the sample and run by ctest
+macro(lug_add_sample_test name)
+    # parse the arguments
+    cmake_parse_arguments(THIS "" "" "SOURCES" ${ARGN})
+
+    if(NOT LUG_OS_ANDROID)
+        # the root of the samples enables the tests, a sample built alone enables its own
+        if(CMAKE_SOURCE_DIR STREQUAL CMAKE_CURRENT_SOURCE_DIR)
+            enable_testing()
+        endif()
+
+        add_executable(${SAMPLE_NAME}_${name} ${THIS_SOURCES})
+        target_link_libraries(${SAMPLE_NAME}_${name} lug_samples_common ${LUG_LIBRARIES})
+        lug_add_compile_options(${SAMPLE_NAME}_${name})
+
+        add_test(NAME ${SAMPLE_NAME}_${name} COMMAND ${SAMPLE_NAME}_${name})
+    endif()
 endmacro()
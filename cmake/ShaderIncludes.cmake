@@ -0,0 +1,41 @@
+# Lists the files included by a GLSL shader, recursively (GL_GOOGLE_include_directive)
+#
+# "file" is searched next to the including file, <file> in the include directory.
+# The result has no duplicates, in the order they are first included.
+function(lug_shader_includes shader include_directory result)
+    set(includes)
+    set(pending ${shader})
+
+    while(pending)
+        list(GET pending 0 current)
+        list(REMOVE_AT pending 0)
+
+        get_filename_component(current_directory ${current} DIRECTORY)
+        file(STRINGS ${current} lines REGEX "^[ \t]*#[ \t]*include[ \t]*[\"<][^\">]+[\">]")
+
+        foreach(line ${lines})
+            string(REGEX REPLACE "^[ \t]*#[ \t]*include[ \t]*([\"<])([^\">]+)[\">].*$" "\\1;\\2" include "${line}")
+            list(GET include 0 delimiter)
+            list(GET include 1 name)
+
+            if(delimiter STREQUAL "<")
+                set(path ${include_directory}/${name})
+            else()
+                set(path ${current_directory}/${name})
+            endif()
+
+            get_filename_component(path ${path} ABSOLUTE)
+
+            if(EXISTS ${path})
+                list(FIND includes ${path} index)
+
+                if(index EQUAL -1)
+                    list(APPEND includes ${path})
+                    list(APPEND pending ${path})
+                endif()
+            endif()
+        endforeach()
+    endwhile()
+
+    set(${result} ${includes} PARENT_SCOPE)
+endfunction()
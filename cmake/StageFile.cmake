@@ -0,0 +1,27 @@
+# Copies or hard links a file
+#
+# Run in script mode with:
+# - SOURCE:      the file to stage
+# - DESTINATION: the staged file
+# - LINK:        hard link instead of copying, copied anyway if it can't be linked (other file
+#                system, no support). Only for the files the build owns: a link to the source tree
+#                would let a write to the build tree modify the sources
+#
+# A link shares the modification time of its source, so it is never older than it. A copy is
+# newer than its source.
+
+get_filename_component(destination_directory ${DESTINATION} DIRECTORY)
+file(MAKE_DIRECTORY ${destination_directory})
+
+# Replace the previous link, not the content of the file it points to
+file(REMOVE ${DESTINATION})
+
+if(LINK AND NOT CMAKE_VERSION VERSION_LESS 3.14)
+    file(CREATE_LINK ${SOURCE} ${DESTINATION} RESULT result COPY_ON_ERROR)
+else()
+    execute_process(COMMAND ${CMAKE_COMMAND} -E copy ${SOURCE} ${DESTINATION} RESULT_VARIABLE result)
+endif()
+
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Can't stage ${SOURCE} to ${DESTINATION}: ${result}")
+endif()
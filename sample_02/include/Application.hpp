@@ -17,7 +17,6 @@ public:
     ~Application() override final = default;
 
     bool init(int argc, char* argv[]);
-    bool initCubeMesh();
 
     void onEvent(const lug::Window::Event& event) override final;
     void onFrame(const lug::System::Time& elapsedTime) override final;
@@ -1,11 +1,13 @@
 #pragma once
 
-#include <lug/Core/Application.hpp>
-#include <lug/Core/FreeMovement.hpp>
 #include <lug/Graphics/Render/Mesh.hpp>
 #include <lug/Graphics/Scene/Scene.hpp>
+#include <lug/Math/Geometry/Trigonometry.hpp>
 
-class Application : public ::lug::Core::Application {
+#include "SampleApplication.hpp"
+#include "SpinAnimation.hpp"
+
+class Application : public SampleApplication {
 public:
     Application();
 
@@ -18,13 +20,14 @@ public:
     ~Application() override final = default;
 
     bool init(int argc, char* argv[]);
-    bool initCubeMesh();
 
-    void onEvent(const lug::Window::Event& event) override final;
-    void onFrame(const lug::System::Time& elapsedTime) override final;
+private:
+    void onSampleFrame(const lug::System::Time& elapsedTime) override final;
 
 private:
     lug::Graphics::Resource::SharedPtr<lug::Graphics::Scene::Scene> _scene;
     lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Mesh> _cubeMesh;
-    lug::Core::FreeMovement _mover;
+
+    // A quarter turn per second
+    SpinAnimation _cubeSpin{lug::Math::Geometry::radians(90.0f)};
 };
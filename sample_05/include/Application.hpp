@@ -1,11 +1,14 @@
 #pragma once
 
-#include <lug/Core/Application.hpp>
-#include <lug/Core/FreeMovement.hpp>
 #include <lug/Graphics/Render/Mesh.hpp>
 #include <lug/Graphics/Scene/Scene.hpp>
+#include <lug/Math/Geometry/Trigonometry.hpp>
 
-class Application : public ::lug::Core::Application {
+#include "SampleApplication.hpp"
+#include "ShadowAtlas.hpp"
+#include "SpinAnimation.hpp"
+
+class Application : public SampleApplication {
 public:
     Application();
 
@@ -18,13 +21,27 @@ public:
     ~Application() override final = default;
 
     bool init(int argc, char* argv[]);
-    bool initCubeMesh();
 
-    void onEvent(const lug::Window::Event& event) override final;
-    void onFrame(const lug::System::Time& elapsedTime) override final;
+private:
+    void onSampleFrame(const lug::System::Time& elapsedTime) override final;
+
+    /**
+     * @brief      Requests the shadow maps of the lights from the atlas.
+     */
+    void updateShadows();
 
 private:
     lug::Graphics::Resource::SharedPtr<lug::Graphics::Scene::Scene> _scene;
     lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Mesh> _cubeMesh;
-    lug::Core::FreeMovement _mover;
+
+    ShadowAtlas _shadowAtlas{4096, 256};
+
+    // Incremented each time a shadow caster moves, invalidates the cached shadow maps
+    uint64_t _casterVersion{0};
+    bool _rotateCube{true};
+
+    uint32_t _perfShadowsSection;
+
+    // A quarter turn per second
+    SpinAnimation _cubeSpin{lug::Math::Geometry::radians(90.0f)};
 };
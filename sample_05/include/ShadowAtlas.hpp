@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief      Allocates the shadow maps of the lights in a single square atlas, and remembers
+ *             what each of them contains.
+ *
+ *             Tiles are power of two squares handed out by a quadtree buddy allocator. A light
+ *             keeps its tile between frames, and as long as its resolution and content key
+ *             (light transform and casters state) are unchanged its shadow map doesn't have to be
+ *             rendered again.
+ */
+class ShadowAtlas {
+public:
+    struct Tile {
+        uint32_t x;
+        uint32_t y;
+        uint32_t size;
+    };
+
+    struct Stats {
+        uint32_t requests{0};
+        uint32_t hits{0};
+        uint32_t renders{0};
+        uint32_t failures{0};
+    };
+
+public:
+    /**
+     * @param[in]  size         The size of the atlas in texels, a power of two.
+     * @param[in]  minTileSize  The smallest tile, a power of two.
+     */
+    ShadowAtlas(uint32_t size, uint32_t minTileSize);
+
+    /**
+     * @brief      Requests the shadow map of a light for this frame.
+     *
+     *             If the atlas is full the resolution is halved until the tile fits.
+     *
+     * @param[in]  lightId      Identifier of the light.
+     * @param[in]  resolution   The wanted resolution, a power of two.
+     * @param[in]  contentKey   Changes whenever what the light sees changes.
+     * @param[out] tile         The tile of the light.
+     * @param[out] needsRender  false if the tile already contains this content.
+     *
+     * @return     false if no tile could be allocated, the light has no shadow this frame.
+     */
+    bool request(uint32_t lightId, uint32_t resolution, uint64_t contentKey, Tile& tile, bool& needsRender);
+
+    /**
+     * @brief      Requests the shadow map of a light, for the callers that don't render it themselves
+     *             and only keep the tiles and the statistics of the atlas up to date.
+     */
+    bool request(uint32_t lightId, uint32_t resolution, uint64_t contentKey);
+
+    /**
+     * @brief      Releases the tiles of the lights that were not requested since the last call.
+     */
+    void endFrame();
+
+    void release(uint32_t lightId);
+
+    uint32_t getSize() const;
+    uint64_t getUsedTexels() const;
+    const Stats& getStats() const;
+    float getHitRate() const;
+
+private:
+    struct Entry {
+        Tile tile;
+        uint32_t resolution; // The requested one, the tile is smaller if the atlas was full
+        uint64_t contentKey;
+        bool used;
+    };
+
+    uint32_t getLevel(uint32_t tileSize) const;
+
+    bool allocate(uint32_t tileSize, Tile& tile);
+    void free(const Tile& tile);
+
+private:
+    uint32_t _size;
+    uint32_t _minTileSize;
+
+    // Free tiles for each level, level 0 is the whole atlas
+    std::vector<std::vector<Tile>> _freeTiles;
+
+    std::unordered_map<uint32_t, Entry> _entries;
+
+    uint64_t _usedTexels{0};
+    Stats _stats;
+};
@@ -2,16 +2,17 @@
 
 #include <imgui.h>
 
-#include <lug/Graphics/Builder/Camera.hpp>
 #include <lug/Graphics/Builder/Light.hpp>
 #include <lug/Graphics/Builder/Material.hpp>
-#include <lug/Graphics/Builder/Mesh.hpp>
 #include <lug/Graphics/Builder/Scene.hpp>
 #include <lug/Graphics/Renderer.hpp>
 #include <lug/Graphics/Vulkan/Renderer.hpp>
-#include <lug/Math/Geometry/Trigonometry.hpp>
 
-Application::Application() : lug::Core::Application::Application{{"sample_05", {0, 1, 0}}} {
+#include "ProceduralMesh.hpp"
+#include "SampleScene.hpp"
+#include "Trace.hpp"
+
+Application::Application() : SampleApplication{{"sample_05", {0, 1, 0}}} {
     getRenderWindowInfo().windowInitInfo.title = "Sample 05";
 
     getRenderWindowInfo().renderViewsInitInfo.push_back({
@@ -69,13 +70,18 @@ Application::Application() : lug::Core::Application::Application{{"sample_05", {
         },
         nullptr                                             // camera
     });
+
+    // The cube spins by the ticks of the fixed step mode
+    _framePacer.setFixedStepSupported(true);
 }
 
 bool Application::init(int argc, char* argv[]) {
-    if (!lug::Core::Application::init(argc, argv)) {
+    if (!SampleApplication::init(argc, argv)) {
         return false;
     }
 
+    _perfShadowsSection = _perfOverlay.addSection("shadows");
+
     lug::Graphics::Renderer* renderer = _graphics.getRenderer();
 
     // Build the scene
@@ -90,55 +96,19 @@ bool Application::init(int argc, char* argv[]) {
         }
     }
 
-    // Attach cameras
+    // Attach cameras, the first one moved by the mouse and the keyboard
     {
-        lug::Graphics::Builder::Camera cameraBuilder(*renderer);
-
-        cameraBuilder.setFovY(45.0f);
-        cameraBuilder.setZNear(0.1f);
-        cameraBuilder.setZFar(100.0f);
-
-        // Camera 1
-        lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Camera::Camera> camera = cameraBuilder.build();
-        if (!camera) {
-            LUG_LOG.error("Application: Can't create the camera");
+        lug::Graphics::Scene::Node* node = SampleScene::attachCamera(*renderer, *_scene, "camera", 0);
+        if (!node || !SampleScene::attachCamera(*renderer, *_scene, "camera2", 1)) {
             return false;
         }
 
-        lug::Graphics::Scene::Node* node = _scene->createSceneNode("camera");
-        _scene->getRoot().attachChild(*node);
-
-        node->attachCamera(camera);
-
-        // Attach a mover to the first camera
-        _mover.setTargetNode(*node);
-        _mover.setEventSource(*renderer->getWindow());
-
-        // Camera 2
-        lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Camera::Camera> camera2 = cameraBuilder.build();
-        if (!camera) {
-            LUG_LOG.error("Application: Can't create the camera");
-            return false;
-        }
-
-        lug::Graphics::Scene::Node* node2 = _scene->createSceneNode("camera2");
-        _scene->getRoot().attachChild(*node2);
-
-        node2->attachCamera(camera2);
-
-        // Attach camera to RenderView
-        {
-            auto& renderViews = _graphics.getRenderer()->getWindow()->getRenderViews();
-
-            LUG_ASSERT(renderViews.size() > 1, "There should be at least 2 render view");
-
-            renderViews[0]->attachCamera(camera);
-            renderViews[1]->attachCamera(camera2);
-        }
+        setMovedCamera(*node);
     }
 
     // Create the cube mesh
-    if (!initCubeMesh()) {
+    _cubeMesh = ProceduralMesh::buildCube(*renderer);
+    if (!_cubeMesh) {
         return false;
     }
 
@@ -206,209 +176,46 @@ bool Application::init(int argc, char* argv[]) {
     return true;
 }
 
-bool Application::initCubeMesh() {
-    const std::vector<lug::Math::Vec3f> positions = {
-        // Back
-        {-1.0f, -1.0f, -1.0f},
-        {1.0f, -1.0f, -1.0f},
-        {-1.0f, 1.0f, -1.0f},
-        {1.0f, 1.0f, -1.0f},
-
-        // Front
-        {-1.0f, -1.0f, 1.0f},
-        {1.0f, -1.0f, 1.0f},
-        {-1.0f, 1.0f, 1.0f},
-        {1.0f, 1.0f, 1.0f},
-
-        // Left
-        {-1.0f, -1.0f, -1.0f},
-        {-1.0f, -1.0f, 1.0f},
-        {-1.0f, 1.0f, -1.0f},
-        {-1.0f, 1.0f, 1.0f},
-
-        // Right
-        {1.0f, -1.0f, -1.0f},
-        {1.0f, -1.0f, 1.0f},
-        {1.0f, 1.0f, -1.0f},
-        {1.0f, 1.0f, 1.0f},
-
-        // Bottom
-        {-1.0f, -1.0f, -1.0f},
-        {-1.0f, -1.0f, 1.0f},
-        {1.0f, -1.0f, -1.0f},
-        {1.0f, -1.0f, 1.0f},
-
-        // Top
-        {-1.0f, 1.0f, -1.0f},
-        {-1.0f, 1.0f, 1.0f},
-        {1.0f, 1.0f, -1.0f},
-        {1.0f, 1.0f, 1.0}
-    };
-
-    const std::vector<lug::Math::Vec3f> normals = {
-        // Back
-        {0.0f, 0.0f, -1.0f},
-        {0.0f, 0.0f, -1.0f},
-        {0.0f, 0.0f, -1.0f},
-        {0.0f, 0.0f, -1.0f},
-
-        // Front
-        {0.0f, 0.0f, 1.0f},
-        {0.0f, 0.0f, 1.0f},
-        {0.0f, 0.0f, 1.0f},
-        {0.0f, 0.0f, 1.0f},
-
-        // Left
-        {-1.0f, 0.0f, 0.0f},
-        {-1.0f, 0.0f, 0.0f},
-        {-1.0f, 0.0f, 0.0f},
-        {-1.0f, 0.0f, 0.0f},
-
-        // Right
-        {1.0f, 0.0f, 0.0f},
-        {1.0f, 0.0f, 0.0f},
-        {1.0f, 0.0f, 0.0f},
-        {1.0f, 0.0f, 0.0f},
-
-        // Bottom
-        {0.0f, -1.0f, 0.0f},
-        {0.0f, -1.0f, 0.0f},
-        {0.0f, -1.0f, 0.0f},
-        {0.0f, -1.0f, 0.0f},
-
-        // Top
-        {0.0f, 1.0f, 0.0f},
-        {0.0f, 1.0f, 0.0f},
-        {0.0f, 1.0f, 0.0f},
-        {0.0f, 1.0f, 0.0f}
-    };
-
-    const std::vector<lug::Math::Vec4f> colors = {
-        // Back
-        {0.0f, 0.0f, 1.0f, 1.0f},
-        {0.0f, 0.0f, 1.0f, 1.0f},
-        {0.0f, 0.0f, 1.0f, 1.0f},
-        {0.0f, 0.0f, 1.0f, 1.0f},
-
-        // Front
-        {1.0f, 0.0f, 1.0, 1.0f},
-        {1.0f, 0.0f, 1.0, 1.0f},
-        {1.0f, 0.0f, 1.0, 1.0f},
-        {1.0f, 0.0f, 1.0, 1.0f},
-
-        // Left
-        {1.0f, 0.0f, 0.0, 1.0f},
-        {1.0f, 0.0f, 0.0, 1.0f},
-        {1.0f, 0.0f, 0.0, 1.0f},
-        {1.0f, 0.0f, 0.0, 1.0f},
-
-        // Right
-        {1.0f, 1.0f, 0.0f, 1.0f},
-        {1.0f, 1.0f, 0.0f, 1.0f},
-        {1.0f, 1.0f, 0.0f, 1.0f},
-        {1.0f, 1.0f, 0.0f, 1.0f},
-
-        // Bottom
-        {0.0f, 1.0f, 0.0f, 1.0f},
-        {0.0f, 1.0f, 0.0f, 1.0f},
-        {0.0f, 1.0f, 0.0f, 1.0f},
-        {0.0f, 1.0f, 0.0f, 1.0f},
-
-        // Top
-        {0.0f, 1.0f, 1.0f, 1.0f},
-        {0.0f, 1.0f, 1.0f, 1.0f},
-        {0.0f, 1.0f, 1.0f, 1.0f},
-        {0.0f, 1.0f, 1.0f, 1.0f}
-    };
-
-    const std::vector<uint16_t> indices = {
-        // Back
-        0, 2, 1,
-        1, 2, 3,
-
-        // Front
-        6, 4, 5,
-        7, 6, 5,
-
-        // Left
-        10, 8, 9,
-        11, 10, 9,
-
-        // Right
-        14, 13, 12,
-        15, 13, 14,
-
-        // Bottom
-        17, 16, 19,
-        19, 16, 18,
-
-        // Top
-        23, 20, 21,
-        22, 20, 23
-    };
-
-    // Build the mesh
-    {
-        lug::Graphics::Builder::Mesh meshBuilder(*_graphics.getRenderer());
-        meshBuilder.setName("cube");
-
-        lug::Graphics::Builder::Mesh::PrimitiveSet* primitiveSet = meshBuilder.addPrimitiveSet();
+void Application::updateShadows() {
+    // The directional light covers the whole scene, it gets the biggest tile. The point light
+    // would need six faces and is not a shadow caster here.
+    _shadowAtlas.request(0, 2048, _casterVersion);
 
-        primitiveSet->setMode(lug::Graphics::Render::Mesh::PrimitiveSet::Mode::Triangles);
+    _shadowAtlas.endFrame();
+}
 
-        primitiveSet->addAttributeBuffer(
-            indices.data(),
-            sizeof(uint16_t),
-            static_cast<uint32_t>(indices.size()),
-            lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Indice
-        );
+void Application::onSampleFrame(const lug::System::Time& elapsedTime) {
+    // The replay rotates the cube with the recorded frame times
+    const lug::System::Time simulationTime = getSimulationTime(elapsedTime);
 
-        primitiveSet->addAttributeBuffer(
-            positions.data(),
-            sizeof(lug::Math::Vec3f),
-            static_cast<uint32_t>(positions.size()),
-            lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Position
+    if (_rotateCube) {
+        _scene->getSceneNode("cube")->rotate(
+            _cubeSpin.update(_framePacer, simulationTime.getSeconds<float>()),
+            {0.0f, 0.0f, 1.0f},
+            lug::Graphics::Node::TransformSpace::World
         );
 
-        primitiveSet->addAttributeBuffer(
-            normals.data(),
-            sizeof(lug::Math::Vec3f),
-            static_cast<uint32_t>(normals.size()),
-            lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Normal
-        );
-
-        primitiveSet->addAttributeBuffer(
-            colors.data(),
-            sizeof(lug::Math::Vec4f),
-            static_cast<uint32_t>(colors.size()),
-            lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Color
-        );
-
-        _cubeMesh = meshBuilder.build();
-
-        if (!_cubeMesh) {
-            LUG_LOG.error("Application: Can't create the cube mesh");
-            return false;
-        }
+        ++_casterVersion;
     }
 
-    return true;
-}
-
-void Application::onEvent(const lug::Window::Event& event) {
-    if (event.type == lug::Window::Event::Type::Close) {
-        close();
+    {
+        PerfOverlay::ScopedSection section(_perfOverlay, _perfShadowsSection);
+        updateShadows();
     }
-}
 
-void Application::onFrame(const lug::System::Time& elapsedTime) {
-    _mover.onFrame(elapsedTime);
+    ImGui::Begin("Shadows");
+    {
+        ImGui::SetWindowSize({250, 120});
+        ImGui::SetWindowPos({10, 10});
+
+        const float atlasTexels = static_cast<float>(_shadowAtlas.getSize()) * _shadowAtlas.getSize();
 
-    _scene->getSceneNode("cube")->rotate(
-        ::lug::Math::Geometry::radians(90.0f) * elapsedTime.getSeconds<float>(),
-        {0.0f, 0.0f, 1.0f},
-        lug::Graphics::Node::TransformSpace::World
-    );
+        ImGui::Checkbox("Rotate cube", &_rotateCube);
+        ImGui::Text("Atlas used: %.1f%%", 100.0f * _shadowAtlas.getUsedTexels() / atlasTexels);
+        ImGui::Text("Cache hit rate: %.1f%%", 100.0f * _shadowAtlas.getHitRate());
+        ImGui::Text("Shadow maps rendered: %u", _shadowAtlas.getStats().renders);
+    }
+    ImGui::End();
 
     ImGui::Begin("Light");
     {
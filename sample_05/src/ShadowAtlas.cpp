@@ -0,0 +1,182 @@
+#include "ShadowAtlas.hpp"
+
+#include <algorithm>
+
+ShadowAtlas::ShadowAtlas(uint32_t size, uint32_t minTileSize) : _size(size), _minTileSize(minTileSize) {
+    _freeTiles.resize(getLevel(_minTileSize) + 1);
+    _freeTiles[0].push_back({0, 0, _size});
+}
+
+bool ShadowAtlas::request(uint32_t lightId, uint32_t resolution, uint64_t contentKey, Tile& tile, bool& needsRender) {
+    ++_stats.requests;
+
+    resolution = std::max(_minTileSize, std::min(resolution, _size));
+
+    auto it = _entries.find(lightId);
+
+    if (it != _entries.end()) {
+        Entry& entry = it->second;
+
+        entry.used = true;
+
+        // A light downgraded when the atlas was full keeps its smaller tile
+        if (entry.resolution == resolution) {
+            tile = entry.tile;
+            needsRender = entry.contentKey != contentKey;
+
+            if (needsRender) {
+                entry.contentKey = contentKey;
+                ++_stats.renders;
+            } else {
+                ++_stats.hits;
+            }
+
+            return true;
+        }
+
+        // The resolution changed, the old tile is useless
+        free(entry.tile);
+        _entries.erase(it);
+    }
+
+    for (uint32_t size = resolution; size >= _minTileSize; size /= 2) {
+        if (allocate(size, tile)) {
+            _entries[lightId] = {tile, resolution, contentKey, true};
+
+            needsRender = true;
+            ++_stats.renders;
+
+            return true;
+        }
+    }
+
+    ++_stats.failures;
+    return false;
+}
+
+bool ShadowAtlas::request(uint32_t lightId, uint32_t resolution, uint64_t contentKey) {
+    Tile tile;
+    bool needsRender;
+
+    return request(lightId, resolution, contentKey, tile, needsRender);
+}
+
+void ShadowAtlas::endFrame() {
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        if (!it->second.used) {
+            free(it->second.tile);
+            it = _entries.erase(it);
+        } else {
+            it->second.used = false;
+            ++it;
+        }
+    }
+}
+
+void ShadowAtlas::release(uint32_t lightId) {
+    auto it = _entries.find(lightId);
+
+    if (it != _entries.end()) {
+        free(it->second.tile);
+        _entries.erase(it);
+    }
+}
+
+uint32_t ShadowAtlas::getSize() const {
+    return _size;
+}
+
+uint64_t ShadowAtlas::getUsedTexels() const {
+    return _usedTexels;
+}
+
+const ShadowAtlas::Stats& ShadowAtlas::getStats() const {
+    return _stats;
+}
+
+float ShadowAtlas::getHitRate() const {
+    const uint32_t served = _stats.hits + _stats.renders;
+    return served ? static_cast<float>(_stats.hits) / served : 0.0f;
+}
+
+uint32_t ShadowAtlas::getLevel(uint32_t tileSize) const {
+    uint32_t level = 0;
+
+    for (uint32_t size = _size; size > tileSize; size /= 2) {
+        ++level;
+    }
+
+    return level;
+}
+
+bool ShadowAtlas::allocate(uint32_t tileSize, Tile& tile) {
+    const uint32_t level = getLevel(tileSize);
+
+    // Find the smallest free tile that is big enough
+    uint32_t parentLevel = level + 1;
+
+    for (uint32_t i = level + 1; i-- > 0;) {
+        if (!_freeTiles[i].empty()) {
+            parentLevel = i;
+            break;
+        }
+    }
+
+    if (parentLevel > level) {
+        return false;
+    }
+
+    // Split it down to the wanted size, keeping the first quarter each time
+    tile = _freeTiles[parentLevel].back();
+    _freeTiles[parentLevel].pop_back();
+
+    for (uint32_t i = parentLevel; i < level; ++i) {
+        const uint32_t half = tile.size / 2;
+
+        _freeTiles[i + 1].push_back({tile.x + half, tile.y, half});
+        _freeTiles[i + 1].push_back({tile.x, tile.y + half, half});
+        _freeTiles[i + 1].push_back({tile.x + half, tile.y + half, half});
+
+        tile.size = half;
+    }
+
+    _usedTexels += static_cast<uint64_t>(tile.size) * tile.size;
+
+    return true;
+}
+
+void ShadowAtlas::free(const Tile& tile) {
+    _usedTexels -= static_cast<uint64_t>(tile.size) * tile.size;
+
+    Tile current = tile;
+
+    // Merge with the buddies while all four quarters are free
+    for (uint32_t level = getLevel(current.size); level > 0; --level) {
+        const uint32_t parentSize = current.size * 2;
+        const uint32_t parentX = current.x - current.x % parentSize;
+        const uint32_t parentY = current.y - current.y % parentSize;
+
+        std::vector<Tile>& freeTiles = _freeTiles[level];
+        std::vector<size_t> buddies;
+
+        for (size_t i = 0; i < freeTiles.size(); ++i) {
+            if (freeTiles[i].x - freeTiles[i].x % parentSize == parentX && freeTiles[i].y - freeTiles[i].y % parentSize == parentY) {
+                buddies.push_back(i);
+            }
+        }
+
+        if (buddies.size() != 3) {
+            freeTiles.push_back(current);
+            return;
+        }
+
+        // Erase from the back so the indices stay valid
+        for (size_t i = buddies.size(); i-- > 0;) {
+            freeTiles.erase(freeTiles.begin() + buddies[i]);
+        }
+
+        current = {parentX, parentY, parentSize};
+    }
+
+    _freeTiles[0].push_back(current);
+}
@@ -1,11 +1,16 @@
 #pragma once
 
-#include <lug/Core/Application.hpp>
-#include <lug/Core/FreeMovement.hpp>
+#include <string>
+#include <vector>
+
+#include <lug/Graphics/Render/Material.hpp>
 #include <lug/Graphics/Render/Mesh.hpp>
 #include <lug/Graphics/Scene/Scene.hpp>
 
-class Application : public ::lug::Core::Application {
+#include "Clusterizer.hpp"
+#include "SampleApplication.hpp"
+
+class Application : public SampleApplication {
 public:
     Application();
 
@@ -19,12 +24,34 @@ public:
 
     bool init(int argc, char* argv[]);
     bool initSphereMesh();
+    void updateSphereLods();
+    void updateClusterCulling();
 
-    void onEvent(const lug::Window::Event& event) override final;
-    void onFrame(const lug::System::Time& elapsedTime) override final;
+private:
+    void onSampleFrame(const lug::System::Time& elapsedTime) override final;
 
 private:
+    struct SphereLod {
+        lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Mesh> mesh;
+        uint32_t triangleCount;
+        std::vector<Clusterizer::Cluster> clusters;
+    };
+
+    struct SphereInstance {
+        lug::Graphics::Scene::Node* node;
+        lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Material> material;
+        uint32_t lod;
+    };
+
     lug::Graphics::Resource::SharedPtr<lug::Graphics::Scene::Scene> _scene;
-    lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Mesh> _sphereMesh;
-    lug::Core::FreeMovement _mover;
+
+    // Level of details of the sphere, from the most to the least detailed
+    std::vector<SphereLod> _sphereLods;
+    std::vector<SphereInstance> _spheres;
+    uint32_t _submittedTriangles{0};
+    Clusterizer::CullingStats _clusterCullingStats;
+
+    uint32_t _perfLodsSection;
+    uint32_t _perfCullingSection;
+    uint32_t _perfTrianglesCounter;
 };
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <lug/Math/Matrix.hpp>
+#include <lug/Math/Vector.hpp>
+
+namespace Clusterizer {
+
+/**
+ * @brief      Small group of triangles that can be culled as a whole.
+ */
+struct Cluster {
+    std::vector<uint16_t> indices;      // Triangle list, referencing the vertices of the mesh
+    uint32_t vertexCount;
+
+    lug::Math::Vec3f center;            // Bounding sphere
+    float radius;
+
+    lug::Math::Vec3f coneAxis;          // Normal cone, the cluster faces away from any viewer
+    float coneCutoff;                   // inside the cone (cutoff of 1 disables the test)
+};
+
+/**
+ * @brief      Planes of a view frustum, inside is where ax + by + cz + d >= 0.
+ */
+struct Frustum {
+    lug::Math::Vec4f planes[6];
+};
+
+/**
+ * @brief      Triangles rejected by the cluster culling.
+ */
+struct CullingStats {
+    uint32_t totalTriangles{0};
+    uint32_t backfaceTriangles{0};
+    uint32_t frustumTriangles{0};
+};
+
+/**
+ * @brief      Splits an indexed triangle list into clusters.
+ *
+ *             Each cluster starts from the first unused triangle of the index buffer and grows
+ *             with the adjacent triangle adding the fewest vertices, until it reaches
+ *             maxVertices unique vertices or maxTriangles triangles.
+ *
+ * @param[in]  positions     The positions of the vertices.
+ * @param[in]  normals       The normals of the vertices, used to orient the triangles.
+ * @param[in]  indices       The indices of the triangle list.
+ * @param[in]  maxVertices   The maximum number of unique vertices of a cluster.
+ * @param[in]  maxTriangles  The maximum number of triangles of a cluster.
+ *
+ * @return     The clusters.
+ */
+std::vector<Cluster> build(
+    const std::vector<lug::Math::Vec3f>& positions,
+    const std::vector<lug::Math::Vec3f>& normals,
+    const std::vector<uint16_t>& indices,
+    size_t maxVertices = 64,
+    size_t maxTriangles = 124
+);
+
+/**
+ * @brief      Extracts the frustum planes of a Vulkan view projection matrix (depth in [0, 1]).
+ */
+Frustum extractFrustum(const lug::Math::Mat4x4f& viewProjection);
+
+/**
+ * @brief      Culls the clusters of a mesh instance and accumulates the rejected triangles.
+ *
+ * @param[in]  clusters        The clusters of the mesh.
+ * @param[in]  translation     The translation of the instance.
+ * @param[in]  cameraPosition  The position of the camera.
+ * @param[in]  frustum         The frustum of the camera.
+ * @param      stats           The stats to accumulate into.
+ */
+void cull(
+    const std::vector<Cluster>& clusters,
+    const lug::Math::Vec3f& translation,
+    const lug::Math::Vec3f& cameraPosition,
+    const Frustum& frustum,
+    CullingStats& stats
+);
+
+} // Clusterizer
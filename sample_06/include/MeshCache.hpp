@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <lug/Graphics/Render/Mesh.hpp>
+#include <lug/Math/Vector.hpp>
+
+/**
+ * @brief      On-disk cache of generated meshes.
+ *
+ *             Entries are keyed by the name of the generator and a hash of its parameters, and
+ *             store the builder-ready vertex and index streams in a single file. The file is
+ *             memory mapped when loaded, so the streams can be handed to Builder::Mesh without
+ *             any copy. The mapping of the last loaded entry stays valid until the next load
+ *             or the destruction of the cache.
+ */
+class MeshCache {
+public:
+    struct PrimitiveSet {
+        lug::Graphics::Render::Mesh::PrimitiveSet::Mode mode;
+        const uint16_t* indices;
+        uint32_t indexCount;
+    };
+
+    struct Mesh {
+        uint32_t vertexCount;
+        const lug::Math::Vec3f* positions;
+        const lug::Math::Vec3f* normals;
+        std::vector<PrimitiveSet> primitiveSets;
+    };
+
+public:
+    explicit MeshCache(const std::string& directory);
+
+    MeshCache(const MeshCache&) = delete;
+    MeshCache(MeshCache&&) = delete;
+
+    MeshCache& operator=(const MeshCache&) = delete;
+    MeshCache& operator=(MeshCache&&) = delete;
+
+    ~MeshCache();
+
+    /**
+     * @brief      Loads a mesh from the cache.
+     *
+     * @param[in]  generator       The name of the generator.
+     * @param[in]  parametersHash  The hash of the parameters of the generator.
+     * @param      mesh            The mesh, pointing to the mapped file.
+     *
+     * @return     True on a hit, false otherwise.
+     */
+    bool load(const std::string& generator, uint64_t parametersHash, Mesh& mesh);
+
+    /**
+     * @brief      Stores a mesh in the cache.
+     *
+     * @param[in]  generator       The name of the generator.
+     * @param[in]  parametersHash  The hash of the parameters of the generator.
+     * @param[in]  mesh            The mesh.
+     *
+     * @return     True on success, false otherwise.
+     */
+    bool store(const std::string& generator, uint64_t parametersHash, const Mesh& mesh) const;
+
+    /**
+     * @brief      Hashes data with FNV-1a, chain the calls with the seed to hash several values.
+     */
+    static uint64_t hash(const void* data, size_t size, uint64_t seed = 14695981039346656037ull);
+
+    template <typename T>
+    static uint64_t hash(const T& value, uint64_t seed = 14695981039346656037ull) {
+        return hash(&value, sizeof(T), seed);
+    }
+
+private:
+    std::string getPath(const std::string& generator, uint64_t parametersHash) const;
+
+    bool map(const std::string& path);
+    void unmap();
+
+private:
+    std::string _directory;
+
+    const uint8_t* _data{nullptr};
+    size_t _size{0};
+
+    // Fallback storage when the file can't be memory mapped
+    std::vector<uint8_t> _buffer;
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <lug/Math/Vector.hpp>
+
+namespace MeshSimplifier {
+
+/**
+ * @brief      Simplifies an indexed triangle list with quadric error metrics.
+ *
+ *             Vertices sharing the same position are welded before the simplification, so that
+ *             seams of procedural meshes don't open. Edges are collapsed onto one of their
+ *             existing vertices, which means the returned indices reference the original
+ *             vertex buffers and every level of detail can share them.
+ *
+ * @param[in]  positions         The positions of the vertices.
+ * @param[in]  indices           The indices of the triangle list.
+ * @param[in]  targetIndexCount  The number of indices to reach. The result may contain more
+ *                               indices if no valid collapse is left.
+ *
+ * @return     The indices of the simplified triangle list.
+ */
+std::vector<uint16_t> simplify(const std::vector<lug::Math::Vec3f>& positions, const std::vector<uint16_t>& indices, size_t targetIndexCount);
+
+} // MeshSimplifier
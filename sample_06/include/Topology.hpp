@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <lug/Graphics/Render/Mesh.hpp>
+
+namespace Topology {
+
+// Index restarting a strip when primitive restart is enabled
+constexpr uint16_t restartIndex = 0xFFFF;
+
+/**
+ * @brief      Description of the pipeline the indices are generated for.
+ */
+struct Target {
+    bool primitiveRestart{false};
+    uint32_t cacheSize{16};
+};
+
+/**
+ * @brief      Indices selected by convert(), with the figures of both candidates.
+ */
+struct Result {
+    lug::Graphics::Render::Mesh::PrimitiveSet::Mode mode;
+    std::vector<uint16_t> indices;
+
+    size_t listIndexCount;
+    float listAcmr;
+
+    size_t stripIndexCount;
+    float stripAcmr;
+};
+
+/**
+ * @brief      Converts an indexed triangle strip to an indexed triangle list.
+ *
+ *             Degenerate triangles (used to stitch rows of a strip together) are dropped
+ *             and the winding of every odd triangle is restored.
+ *
+ * @param[in]  strip  The indices of the triangle strip.
+ *
+ * @return     The indices of the triangle list.
+ */
+std::vector<uint16_t> stripToList(const std::vector<uint16_t>& strip);
+
+/**
+ * @brief      Converts an indexed triangle list to strips, keeping the winding of the triangles.
+ *
+ * @param[in]  list              The indices of the triangle list.
+ * @param[in]  primitiveRestart  Whether to separate the strips with restartIndex instead of
+ *                               degenerate triangles.
+ *
+ * @return     The indices of the triangle strip.
+ */
+std::vector<uint16_t> listToStrip(const std::vector<uint16_t>& list, bool primitiveRestart);
+
+/**
+ * @brief      Reorders the triangles of a list for the post-transform vertex cache (Tipsify).
+ *
+ * @param[in]  list         The indices of the triangle list.
+ * @param[in]  vertexCount  The number of vertices referenced by the list.
+ * @param[in]  cacheSize    The number of entries of the cache.
+ *
+ * @return     The reordered indices.
+ */
+std::vector<uint16_t> optimizeList(const std::vector<uint16_t>& list, size_t vertexCount, uint32_t cacheSize);
+
+/**
+ * @brief      Computes the average cache miss ratio (transformed vertices per triangle) of
+ *             indices with a FIFO cache.
+ *
+ * @param[in]  indices    The indices.
+ * @param[in]  mode       The topology of the indices, Triangles or TriangleStrip.
+ * @param[in]  cacheSize  The number of entries of the cache.
+ *
+ * @return     The average cache miss ratio.
+ */
+float computeAcmr(const std::vector<uint16_t>& indices, lug::Graphics::Render::Mesh::PrimitiveSet::Mode mode, uint32_t cacheSize);
+
+/**
+ * @brief      Converts a triangle list into the topology transforming the fewest vertices on the
+ *             target, an optimized list or strips. Ties are won by the fewest indices.
+ *
+ * @param[in]  list         The indices of the triangle list.
+ * @param[in]  vertexCount  The number of vertices referenced by the list.
+ * @param[in]  target       The target pipeline.
+ *
+ * @return     The selected mode and indices.
+ */
+Result convert(const std::vector<uint16_t>& list, size_t vertexCount, const Target& target);
+
+} // Topology
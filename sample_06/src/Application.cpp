@@ -1,25 +1,37 @@
 #include "Application.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
 #include <imgui.h>
 
-#include <lug/Graphics/Builder/Camera.hpp>
-#include <lug/Graphics/Builder/Light.hpp>
 #include <lug/Graphics/Builder/Material.hpp>
 #include <lug/Graphics/Builder/Mesh.hpp>
 #include <lug/Graphics/Builder/Scene.hpp>
 #include <lug/Graphics/Renderer.hpp>
 #include <lug/Graphics/Vulkan/Renderer.hpp>
-#include <lug/Math/Geometry/Trigonometry.hpp>
 
-Application::Application() : lug::Core::Application::Application{{"sample_06", {0, 1, 0}}} {
+#include "MeshCache.hpp"
+#include "MeshSimplifier.hpp"
+#include "ProceduralMesh.hpp"
+#include "SampleScene.hpp"
+#include "Topology.hpp"
+#include "Trace.hpp"
+
+Application::Application() : SampleApplication{{"sample_06", {0, 1, 0}}} {
     getRenderWindowInfo().windowInitInfo.title = "Sample 06";
 }
 
 bool Application::init(int argc, char* argv[]) {
-    if (!lug::Core::Application::init(argc, argv)) {
+    if (!SampleApplication::init(argc, argv)) {
         return false;
     }
 
+    _perfLodsSection = _perfOverlay.addSection("lods");
+    _perfCullingSection = _perfOverlay.addSection("culling");
+    _perfTrianglesCounter = _perfOverlay.addCounter("triangles");
+
     lug::Graphics::Renderer* renderer = _graphics.getRenderer();
 
     // Build the scene
@@ -34,37 +46,14 @@ bool Application::init(int argc, char* argv[]) {
         }
     }
 
-    // Attach cameras
+    // Attach camera, moved by the mouse and the keyboard
     {
-        lug::Graphics::Builder::Camera cameraBuilder(*renderer);
-
-        cameraBuilder.setFovY(45.0f);
-        cameraBuilder.setZNear(0.1f);
-        cameraBuilder.setZFar(100.0f);
-
-        lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Camera::Camera> camera = cameraBuilder.build();
-        if (!camera) {
-            LUG_LOG.error("Application: Can't create the camera");
+        lug::Graphics::Scene::Node* node = SampleScene::attachCamera(*renderer, *_scene, "camera", 0);
+        if (!node) {
             return false;
         }
 
-        lug::Graphics::Scene::Node* node = _scene->createSceneNode("camera");
-        _scene->getRoot().attachChild(*node);
-
-        node->attachCamera(camera);
-
-        // Attach a mover to the first camera
-        _mover.setTargetNode(*node);
-        _mover.setEventSource(*renderer->getWindow());
-
-        // Attach camera to RenderView
-        {
-            auto& renderViews = _graphics.getRenderer()->getWindow()->getRenderViews();
-
-            LUG_ASSERT(renderViews.size() > 0, "There should be at least 1 render view");
-
-            renderViews[0]->attachCamera(camera);
-        }
+        setMovedCamera(*node);
     }
 
     // Create the sphere mesh
@@ -101,7 +90,8 @@ bool Application::init(int argc, char* argv[]) {
                     return false;
                 }
 
-                node->attachMeshInstance(_sphereMesh, material);
+                node->attachMeshInstance(_sphereLods[0].mesh, material);
+                _spheres.push_back({node, material, 0});
 
                 node->setPosition({
                     (float)(col - (nbColumns / 2)) * spacing,
@@ -119,126 +109,244 @@ bool Application::init(int argc, char* argv[]) {
     }
 
     // Attach 4 lights
-    const lug::Math::Vec3f lightPositions[] = {
-        lug::Math::Vec3f{-10.0f,  10.0f, 10.0f},
-        lug::Math::Vec3f{ 10.0f,  10.0f, 10.0f},
-        lug::Math::Vec3f{-10.0f, -10.0f, 10.0f},
-        lug::Math::Vec3f{ 10.0f, -10.0f, 10.0f},
-    };
-
-    for (uint32_t i = 0; i < 4; ++i) {
-        lug::Graphics::Builder::Light lightBuilder(*renderer);
-
-        lightBuilder.setType(lug::Graphics::Render::Light::Type::Point);
-        lightBuilder.setColor({300.0f, 300.0f, 300.0f, 1.0f});
-        lightBuilder.setLinearAttenuation(0.0f);
-
-        lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Light> light = lightBuilder.build();
-        if (!light) {
-            LUG_LOG.error("Application: Can't create the point light {}", i);
-            return false;
-        }
-
-        lug::Graphics::Scene::Node* node = _scene->createSceneNode("light" + std::to_string(i));
-        _scene->getRoot().attachChild(*node);
-
-        node->setPosition(lightPositions[i]);
-        node->attachLight(light);
+    if (!SampleScene::attachPointLights(*renderer, *_scene)) {
+        return false;
     }
 
     return true;
 }
 
 bool Application::initSphereMesh() {
+    SAMPLE_TRACE_ZONE("initSphereMesh");
+
+    const int X_SEGMENTS = 64;
+    const int Y_SEGMENTS = 64;
+
+    // Each level halves the number of triangles of the previous one
+    const uint32_t nbLods = 4;
+
+    // The primitive restart is not enabled by the pipelines of the renderer
+    Topology::Target target;
+    target.primitiveRestart = false;
+
+    // Bump it when the generation below changes, to invalidate the cached spheres
+    const uint32_t generatorVersion = 1;
+
+    uint64_t parametersHash = MeshCache::hash(generatorVersion);
+    parametersHash = MeshCache::hash(X_SEGMENTS, parametersHash);
+    parametersHash = MeshCache::hash(Y_SEGMENTS, parametersHash);
+    parametersHash = MeshCache::hash(nbLods, parametersHash);
+    parametersHash = MeshCache::hash(target.primitiveRestart, parametersHash);
+    parametersHash = MeshCache::hash(target.cacheSize, parametersHash);
+
+    MeshCache cache("cache");
+    MeshCache::Mesh sphere;
+
+    // Generated streams, only filled on a cache miss
     std::vector<lug::Math::Vec3f> positions;
     std::vector<lug::Math::Vec3f> normals;
-    std::vector<uint16_t> indices;
+    std::vector<std::vector<uint16_t>> lodIndices;
 
-    // Generate positions / normals / indices
-    {
-        const int X_SEGMENTS = 64;
-        const int Y_SEGMENTS = 64;
-        for (int y = 0; y <= Y_SEGMENTS; ++y) {
-            for (int x = 0; x <= X_SEGMENTS; ++x) {
-                float xSegment = (float)x / (float)X_SEGMENTS;
-                float ySegment = (float)y / (float)Y_SEGMENTS;
-                float xPos = std::cos(xSegment * 2.0f * lug::Math::pi<float>()) * std::sin(ySegment * lug::Math::pi<float>());
-                float yPos = std::cos(ySegment * lug::Math::pi<float>());
-                float zPos = std::sin(xSegment * 2.0f * lug::Math::pi<float>()) * std::sin(ySegment * lug::Math::pi<float>());
-
-                positions.push_back({xPos, yPos, zPos});
-                normals.push_back({xPos, yPos, zPos});
-            }
+    const auto start = std::chrono::steady_clock::now();
+
+    if (cache.load("sphere", parametersHash, sphere)) {
+        LUG_LOG.info("Application: Sphere loaded from the mesh cache in {:.3f} ms", std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count());
+    } else {
+        std::vector<uint16_t> indices;
+
+        // Generate positions / normals / indices
+        {
+            // The texture coordinates are not used
+            std::vector<lug::Math::Vec2f> uvs;
+            ProceduralMesh::generateSphere(X_SEGMENTS, Y_SEGMENTS, positions, normals, uvs);
+
+            // Let Topology::convert() choose the topology from a plain triangle list
+            ProceduralMesh::generateSphereTriangles(X_SEGMENTS, Y_SEGMENTS, indices);
         }
 
-        bool oddRow = false;
-        for (int y = 0; y < Y_SEGMENTS; ++y) {
-            if (!oddRow) { // even rows: y == 0, y == 2; and so on
-                for (int x = 0; x <= X_SEGMENTS; ++x) {
-                    indices.push_back(static_cast<uint16_t>((y + 1) * (X_SEGMENTS + 1) + x));
-                    indices.push_back(static_cast<uint16_t>(y       * (X_SEGMENTS + 1) + x));
-                }
-            } else {
-                for (int x = X_SEGMENTS; x >= 0; --x)
-                {
-                    indices.push_back(static_cast<uint16_t>(y       * (X_SEGMENTS + 1) + x));
-                    indices.push_back(static_cast<uint16_t>((y + 1) * (X_SEGMENTS + 1) + x));
-                }
-            }
+        sphere.vertexCount = static_cast<uint32_t>(positions.size());
+        sphere.positions = positions.data();
+        sphere.normals = normals.data();
+        lodIndices.reserve(nbLods);
+
+        // Generate the level of details
+        for (uint32_t lod = 0; lod < nbLods; ++lod) {
+            const std::vector<uint16_t> lodTriangles = lod == 0 ? indices : MeshSimplifier::simplify(positions, indices, (indices.size() / 3 >> lod) * 3);
+            Topology::Result topology = Topology::convert(lodTriangles, positions.size(), target);
+
+            LUG_LOG.info(
+                "Application: Sphere lod {} uses {}, list: {} indices (ACMR {:.3f}), strip: {} indices (ACMR {:.3f})",
+                lod,
+                topology.mode == lug::Graphics::Render::Mesh::PrimitiveSet::Mode::Triangles ? "list" : "strip",
+                topology.listIndexCount,
+                topology.listAcmr,
+                topology.stripIndexCount,
+                topology.stripAcmr
+            );
+
+            lodIndices.push_back(std::move(topology.indices));
+            sphere.primitiveSets.push_back({topology.mode, lodIndices.back().data(), static_cast<uint32_t>(lodIndices.back().size())});
+        }
 
-            oddRow = !oddRow;
+        if (!cache.store("sphere", parametersHash, sphere)) {
+            LUG_LOG.warn("Application: Can't store the sphere in the mesh cache");
         }
+
+        LUG_LOG.info("Application: Sphere generated (mesh cache miss) in {:.3f} ms", std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count());
     }
 
-    // Build the mesh
+    // Build the level of details of the mesh
     {
-        lug::Graphics::Builder::Mesh meshBuilder(*_graphics.getRenderer());
-        meshBuilder.setName("sphere");
-
-        lug::Graphics::Builder::Mesh::PrimitiveSet* primitiveSet = meshBuilder.addPrimitiveSet();
-
-        primitiveSet->setMode(lug::Graphics::Render::Mesh::PrimitiveSet::Mode::TriangleStrip);
-
-        primitiveSet->addAttributeBuffer(
-            indices.data(),
-            sizeof(uint16_t),
-            static_cast<uint32_t>(indices.size()),
-            lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Indice
-        );
-
-        primitiveSet->addAttributeBuffer(
-            positions.data(),
-            sizeof(lug::Math::Vec3f),
-            static_cast<uint32_t>(positions.size()),
-            lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Position
-        );
-
-        primitiveSet->addAttributeBuffer(
-            normals.data(),
-            sizeof(lug::Math::Vec3f),
-            static_cast<uint32_t>(normals.size()),
-            lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Normal
-        );
-
-        _sphereMesh = meshBuilder.build();
-
-        if (!_sphereMesh) {
-            LUG_LOG.error("Application: Can't create the sphere mesh");
-            return false;
+        const auto buildMesh = [this, &sphere](const std::string& name, const MeshCache::PrimitiveSet& lod) {
+            lug::Graphics::Builder::Mesh meshBuilder(*_graphics.getRenderer());
+            meshBuilder.setName(name);
+
+            lug::Graphics::Builder::Mesh::PrimitiveSet* primitiveSet = meshBuilder.addPrimitiveSet();
+
+            primitiveSet->setMode(lod.mode);
+
+            primitiveSet->addAttributeBuffer(
+                lod.indices,
+                sizeof(uint16_t),
+                lod.indexCount,
+                lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Indice
+            );
+
+            primitiveSet->addAttributeBuffer(
+                sphere.positions,
+                sizeof(lug::Math::Vec3f),
+                sphere.vertexCount,
+                lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Position
+            );
+
+            primitiveSet->addAttributeBuffer(
+                sphere.normals,
+                sizeof(lug::Math::Vec3f),
+                sphere.vertexCount,
+                lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Normal
+            );
+
+            return meshBuilder.build();
+        };
+
+        const std::vector<lug::Math::Vec3f> clusterPositions(sphere.positions, sphere.positions + sphere.vertexCount);
+        const std::vector<lug::Math::Vec3f> clusterNormals(sphere.normals, sphere.normals + sphere.vertexCount);
+
+        for (uint32_t lod = 0; lod < sphere.primitiveSets.size(); ++lod) {
+            const MeshCache::PrimitiveSet& primitiveSet = sphere.primitiveSets[lod];
+
+            lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Mesh> mesh = buildMesh(lod == 0 ? "sphere" : "sphere_lod" + std::to_string(lod), primitiveSet);
+
+            if (!mesh) {
+                LUG_LOG.error("Application: Can't create the sphere mesh lod {}", lod);
+                return false;
+            }
+
+            const std::vector<uint16_t> primitiveSetIndices(primitiveSet.indices, primitiveSet.indices + primitiveSet.indexCount);
+            const std::vector<uint16_t> triangles = primitiveSet.mode == lug::Graphics::Render::Mesh::PrimitiveSet::Mode::TriangleStrip ? Topology::stripToList(primitiveSetIndices) : primitiveSetIndices;
+
+            _sphereLods.push_back({mesh, static_cast<uint32_t>(triangles.size() / 3), Clusterizer::build(clusterPositions, clusterNormals, triangles)});
         }
     }
 
     return true;
 }
 
-void Application::onEvent(const lug::Window::Event& event) {
-    if (event.type == lug::Window::Event::Type::Close) {
-        close();
+void Application::updateSphereLods() {
+    SAMPLE_TRACE_ZONE("updateSphereLods");
+
+    // Minimum projected height in pixels of a sphere for each level of detail
+    const float lodScreenSizes[] = {256.0f, 128.0f, 64.0f};
+
+    auto& renderViews = _graphics.getRenderer()->getWindow()->getRenderViews();
+
+    _submittedTriangles = 0;
+
+    for (SphereInstance& sphere : _spheres) {
+        const lug::Math::Vec3f& spherePosition = sphere.node->getAbsolutePosition();
+
+        // Keep the biggest size among the cameras, the mesh instance is shared by all the render views
+        float screenSize = 0.0f;
+        for (auto& renderView : renderViews) {
+            if (!renderView->getCamera()) {
+                continue;
+            }
+
+            auto camera = renderView->getCamera();
+
+            const lug::Math::Vec3f delta = spherePosition - camera->getParent()->getAbsolutePosition();
+            const float distance = std::sqrt(delta.x() * delta.x() + delta.y() * delta.y() + delta.z() * delta.z());
+
+            // The vertical scale of the projection is 1 / tan(fovY / 2), its sign depends on the Y axis of the viewport
+            const float projectionScale = std::abs(camera->getProjectionMatrix()(1, 1));
+
+            // The radius of the sphere is 1
+            screenSize = std::max(screenSize, renderView->getViewport().extent.height * projectionScale / std::max(distance, 0.001f));
+        }
+
+        uint32_t lod = 0;
+        while (lod + 1 < _sphereLods.size() && screenSize < lodScreenSizes[lod]) {
+            ++lod;
+        }
+
+        if (lod != sphere.lod) {
+            sphere.node->attachMeshInstance(_sphereLods[lod].mesh, sphere.material);
+            sphere.lod = lod;
+        }
+
+        _submittedTriangles += _sphereLods[lod].triangleCount;
+    }
+}
+
+void Application::updateClusterCulling() {
+    SAMPLE_TRACE_ZONE("updateClusterCulling");
+
+    auto& renderViews = _graphics.getRenderer()->getWindow()->getRenderViews();
+
+    _clusterCullingStats = {};
+
+    if (renderViews.empty() || !renderViews[0]->getCamera()) {
+        return;
+    }
+
+    auto camera = renderViews[0]->getCamera();
+
+    const Clusterizer::Frustum frustum = Clusterizer::extractFrustum(camera->getProjectionMatrix() * camera->getViewMatrix());
+    const lug::Math::Vec3f& cameraPosition = camera->getParent()->getAbsolutePosition();
+
+    for (const SphereInstance& sphere : _spheres) {
+        Clusterizer::cull(_sphereLods[sphere.lod].clusters, sphere.node->getAbsolutePosition(), cameraPosition, frustum, _clusterCullingStats);
     }
 }
 
-void Application::onFrame(const lug::System::Time& elapsedTime) {
-    _mover.onFrame(elapsedTime);
+void Application::onSampleFrame(const lug::System::Time&) {
+    {
+        PerfOverlay::ScopedSection section(_perfOverlay, _perfLodsSection);
+        updateSphereLods();
+    }
+
+    {
+        PerfOverlay::ScopedSection section(_perfOverlay, _perfCullingSection);
+        updateClusterCulling();
+    }
+
+    _perfOverlay.setCounter(_perfTrianglesCounter, _submittedTriangles);
+
+    ImGui::Begin("Stats");
+    {
+        ImGui::SetWindowSize({250, 100});
+        ImGui::SetWindowPos({10, 10});
+
+        ImGui::Text("Triangles: %u", _submittedTriangles);
+
+        if (_clusterCullingStats.totalTriangles) {
+            const float total = static_cast<float>(_clusterCullingStats.totalTriangles);
+
+            ImGui::Text("Cluster backface culled: %.1f%%", 100.0f * _clusterCullingStats.backfaceTriangles / total);
+            ImGui::Text("Cluster frustum culled: %.1f%%", 100.0f * _clusterCullingStats.frustumTriangles / total);
+        }
+    }
+    ImGui::End();
 
     ImGui::Begin("Light");
     {
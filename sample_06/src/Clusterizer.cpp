@@ -0,0 +1,257 @@
+#include "Clusterizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Clusterizer {
+
+namespace {
+
+lug::Math::Vec3f cross(const lug::Math::Vec3f& u, const lug::Math::Vec3f& v) {
+    return {
+        u.y() * v.z() - u.z() * v.y(),
+        u.z() * v.x() - u.x() * v.z(),
+        u.x() * v.y() - u.y() * v.x()
+    };
+}
+
+float dot(const lug::Math::Vec3f& u, const lug::Math::Vec3f& v) {
+    return u.x() * v.x() + u.y() * v.y() + u.z() * v.z();
+}
+
+float length(const lug::Math::Vec3f& v) {
+    return std::sqrt(dot(v, v));
+}
+
+void computeBounds(Cluster& cluster, const std::vector<lug::Math::Vec3f>& positions, const std::vector<lug::Math::Vec3f>& normals) {
+    // Bounding sphere centered on the bounding box
+    lug::Math::Vec3f min{std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    lug::Math::Vec3f max{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+
+    for (uint16_t index : cluster.indices) {
+        const lug::Math::Vec3f& position = positions[index];
+
+        min = {std::min(min.x(), position.x()), std::min(min.y(), position.y()), std::min(min.z(), position.z())};
+        max = {std::max(max.x(), position.x()), std::max(max.y(), position.y()), std::max(max.z(), position.z())};
+    }
+
+    cluster.center = (min + max) * 0.5f;
+    cluster.radius = 0.0f;
+
+    for (uint16_t index : cluster.indices) {
+        cluster.radius = std::max(cluster.radius, length(positions[index] - cluster.center));
+    }
+
+    // Normal cone around the average of the face normals
+    std::vector<lug::Math::Vec3f> faceNormals;
+    faceNormals.reserve(cluster.indices.size() / 3);
+
+    lug::Math::Vec3f axis{0.0f, 0.0f, 0.0f};
+
+    for (size_t i = 0; i + 2 < cluster.indices.size(); i += 3) {
+        const uint16_t a = cluster.indices[i];
+        const uint16_t b = cluster.indices[i + 1];
+        const uint16_t c = cluster.indices[i + 2];
+
+        lug::Math::Vec3f normal = cross(positions[b] - positions[a], positions[c] - positions[a]);
+        const float normalLength = length(normal);
+
+        if (normalLength == 0.0f) {
+            continue;
+        }
+
+        normal = normal * (1.0f / normalLength);
+
+        // The winding convention is up to the renderer, orient the face as its vertices
+        if (dot(normal, normals[a] + normals[b] + normals[c]) < 0.0f) {
+            normal = normal * -1.0f;
+        }
+
+        faceNormals.push_back(normal);
+        axis = axis + normal;
+    }
+
+    const float axisLength = length(axis);
+
+    cluster.coneAxis = axisLength > 0.0f ? axis * (1.0f / axisLength) : lug::Math::Vec3f{0.0f, 0.0f, 1.0f};
+    cluster.coneCutoff = 1.0f;
+
+    if (axisLength == 0.0f) {
+        return;
+    }
+
+    float minDot = 1.0f;
+    for (const lug::Math::Vec3f& normal : faceNormals) {
+        minDot = std::min(minDot, dot(normal, cluster.coneAxis));
+    }
+
+    // Too wide cones would almost never reject anything
+    if (minDot > 0.1f) {
+        cluster.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+}
+
+} // anonymous
+
+std::vector<Cluster> build(
+    const std::vector<lug::Math::Vec3f>& positions,
+    const std::vector<lug::Math::Vec3f>& normals,
+    const std::vector<uint16_t>& indices,
+    size_t maxVertices,
+    size_t maxTriangles
+) {
+    const size_t triangleCount = indices.size() / 3;
+
+    std::vector<std::vector<uint32_t>> vertexTriangles(positions.size());
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        for (size_t j = 0; j < 3; ++j) {
+            vertexTriangles[indices[t * 3 + j]].push_back(t);
+        }
+    }
+
+    std::vector<bool> used(triangleCount, false);
+
+    // Index of the last cluster using each vertex, to count the unique vertices
+    std::vector<size_t> vertexCluster(positions.size(), std::numeric_limits<size_t>::max());
+
+    std::vector<Cluster> clusters;
+    std::vector<uint16_t> clusterVertices;
+
+    size_t seed = 0;
+
+    while (true) {
+        while (seed < triangleCount && used[seed]) {
+            ++seed;
+        }
+
+        if (seed == triangleCount) {
+            break;
+        }
+
+        const size_t clusterIndex = clusters.size();
+
+        Cluster cluster{};
+        clusterVertices.clear();
+
+        const auto newVertexCount = [&](size_t t) {
+            uint32_t count = 0;
+            for (size_t j = 0; j < 3; ++j) {
+                count += vertexCluster[indices[t * 3 + j]] != clusterIndex;
+            }
+            return count;
+        };
+
+        size_t next = seed;
+
+        // Grow the cluster with the adjacent triangle adding the fewest vertices
+        while (next != triangleCount) {
+            used[next] = true;
+
+            for (size_t j = 0; j < 3; ++j) {
+                const uint16_t index = indices[next * 3 + j];
+
+                if (vertexCluster[index] != clusterIndex) {
+                    vertexCluster[index] = clusterIndex;
+                    clusterVertices.push_back(index);
+                    ++cluster.vertexCount;
+                }
+
+                cluster.indices.push_back(index);
+            }
+
+            if (cluster.indices.size() / 3 >= maxTriangles) {
+                break;
+            }
+
+            next = triangleCount;
+            uint32_t bestNewVertices = 3;
+
+            for (uint16_t vertex : clusterVertices) {
+                for (uint32_t t : vertexTriangles[vertex]) {
+                    if (used[t]) {
+                        continue;
+                    }
+
+                    const uint32_t newVertices = newVertexCount(t);
+
+                    if (newVertices < bestNewVertices && cluster.vertexCount + newVertices <= maxVertices) {
+                        bestNewVertices = newVertices;
+                        next = t;
+                    }
+                }
+
+                if (bestNewVertices == 0) {
+                    break;
+                }
+            }
+        }
+
+        computeBounds(cluster, positions, normals);
+        clusters.push_back(std::move(cluster));
+    }
+
+    return clusters;
+}
+
+Frustum extractFrustum(const lug::Math::Mat4x4f& viewProjection) {
+    const auto row = [&viewProjection](size_t i) {
+        return lug::Math::Vec4f{viewProjection(i, 0), viewProjection(i, 1), viewProjection(i, 2), viewProjection(i, 3)};
+    };
+
+    const lug::Math::Vec4f r0 = row(0);
+    const lug::Math::Vec4f r1 = row(1);
+    const lug::Math::Vec4f r2 = row(2);
+    const lug::Math::Vec4f r3 = row(3);
+
+    Frustum frustum{{
+        r3 + r0,    // Left
+        r3 - r0,    // Right
+        r3 + r1,    // Bottom
+        r3 - r1,    // Top
+        r2,         // Near
+        r3 - r2     // Far
+    }};
+
+    for (lug::Math::Vec4f& plane : frustum.planes) {
+        const float planeLength = std::sqrt(plane.x() * plane.x() + plane.y() * plane.y() + plane.z() * plane.z());
+
+        if (planeLength > 0.0f) {
+            plane = plane * (1.0f / planeLength);
+        }
+    }
+
+    return frustum;
+}
+
+void cull(
+    const std::vector<Cluster>& clusters,
+    const lug::Math::Vec3f& translation,
+    const lug::Math::Vec3f& cameraPosition,
+    const Frustum& frustum,
+    CullingStats& stats
+) {
+    for (const Cluster& cluster : clusters) {
+        const uint32_t triangleCount = static_cast<uint32_t>(cluster.indices.size() / 3);
+        const lug::Math::Vec3f center = cluster.center + translation;
+
+        stats.totalTriangles += triangleCount;
+
+        const bool outside = std::any_of(std::begin(frustum.planes), std::end(frustum.planes), [&](const lug::Math::Vec4f& plane) {
+            return plane.x() * center.x() + plane.y() * center.y() + plane.z() * center.z() + plane.w() < -cluster.radius;
+        });
+
+        if (outside) {
+            stats.frustumTriangles += triangleCount;
+            continue;
+        }
+
+        const lug::Math::Vec3f view = center - cameraPosition;
+
+        if (dot(view, cluster.coneAxis) >= cluster.coneCutoff * length(view) + cluster.radius) {
+            stats.backfaceTriangles += triangleCount;
+        }
+    }
+}
+
+} // Clusterizer
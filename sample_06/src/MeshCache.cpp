@@ -0,0 +1,235 @@
+#include "MeshCache.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <lug/Config.hpp>
+
+#if defined(LUG_SYSTEM_WINDOWS)
+    #include <direct.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "Topology.hpp"
+
+namespace {
+
+constexpr uint32_t fileMagic = 0x4D47554C; // "LUGM"
+constexpr uint32_t fileVersion = 1;
+
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t vertexCount;
+    uint32_t primitiveSetCount;
+};
+
+struct PrimitiveSetHeader {
+    uint32_t mode;
+    uint32_t indexCount;
+};
+
+// Index streams are padded to keep the next stream aligned on 4 bytes
+size_t indicesSize(uint32_t indexCount) {
+    return (indexCount * sizeof(uint16_t) + 3) & ~static_cast<size_t>(3);
+}
+
+} // anonymous
+
+MeshCache::MeshCache(const std::string& directory) : _directory(directory) {}
+
+MeshCache::~MeshCache() {
+    unmap();
+}
+
+bool MeshCache::load(const std::string& generator, uint64_t parametersHash, Mesh& mesh) {
+    if (!map(getPath(generator, parametersHash))) {
+        return false;
+    }
+
+    size_t offset = 0;
+
+    const auto read = [this, &offset](size_t size) -> const uint8_t* {
+        if (offset + size > _size) {
+            return nullptr;
+        }
+
+        const uint8_t* data = _data + offset;
+        offset += size;
+        return data;
+    };
+
+    const FileHeader* header = reinterpret_cast<const FileHeader*>(read(sizeof(FileHeader)));
+    if (!header || header->magic != fileMagic || header->version != fileVersion) {
+        unmap();
+        return false;
+    }
+
+    const PrimitiveSetHeader* primitiveSetHeaders = reinterpret_cast<const PrimitiveSetHeader*>(read(header->primitiveSetCount * sizeof(PrimitiveSetHeader)));
+
+    mesh.vertexCount = header->vertexCount;
+    mesh.positions = reinterpret_cast<const lug::Math::Vec3f*>(read(header->vertexCount * sizeof(lug::Math::Vec3f)));
+    mesh.normals = reinterpret_cast<const lug::Math::Vec3f*>(read(header->vertexCount * sizeof(lug::Math::Vec3f)));
+    mesh.primitiveSets.clear();
+
+    if (!primitiveSetHeaders || !mesh.positions || !mesh.normals) {
+        unmap();
+        return false;
+    }
+
+    for (uint32_t i = 0; i < header->primitiveSetCount; ++i) {
+        const uint16_t* indices = reinterpret_cast<const uint16_t*>(read(indicesSize(primitiveSetHeaders[i].indexCount)));
+
+        // Only the triangle lists and strips are stored, anything else is a corrupted file
+        const uint32_t mode = primitiveSetHeaders[i].mode;
+        const bool validMode = mode == static_cast<uint32_t>(lug::Graphics::Render::Mesh::PrimitiveSet::Mode::Triangles)
+            || mode == static_cast<uint32_t>(lug::Graphics::Render::Mesh::PrimitiveSet::Mode::TriangleStrip);
+
+        if (!indices || !validMode) {
+            unmap();
+            return false;
+        }
+
+        // An index out of the vertices would read past the vertex buffers, only the strips may restart
+        const bool strip = mode == static_cast<uint32_t>(lug::Graphics::Render::Mesh::PrimitiveSet::Mode::TriangleStrip);
+
+        for (uint32_t j = 0; j < primitiveSetHeaders[i].indexCount; ++j) {
+            if (indices[j] >= header->vertexCount && !(strip && indices[j] == Topology::restartIndex)) {
+                unmap();
+                return false;
+            }
+        }
+
+        mesh.primitiveSets.push_back({
+            static_cast<lug::Graphics::Render::Mesh::PrimitiveSet::Mode>(mode),
+            indices,
+            primitiveSetHeaders[i].indexCount
+        });
+    }
+
+    return true;
+}
+
+bool MeshCache::store(const std::string& generator, uint64_t parametersHash, const Mesh& mesh) const {
+#if defined(LUG_SYSTEM_WINDOWS)
+    _mkdir(_directory.c_str());
+#else
+    mkdir(_directory.c_str(), 0755);
+#endif
+
+    const std::string path = getPath(generator, parametersHash);
+    const std::string temporaryPath = path + ".tmp";
+
+    // Write to a temporary file first so that a concurrent run never maps a partial file
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+
+        const FileHeader header{fileMagic, fileVersion, mesh.vertexCount, static_cast<uint32_t>(mesh.primitiveSets.size())};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        for (const PrimitiveSet& primitiveSet : mesh.primitiveSets) {
+            const PrimitiveSetHeader primitiveSetHeader{static_cast<uint32_t>(primitiveSet.mode), primitiveSet.indexCount};
+            file.write(reinterpret_cast<const char*>(&primitiveSetHeader), sizeof(primitiveSetHeader));
+        }
+
+        file.write(reinterpret_cast<const char*>(mesh.positions), mesh.vertexCount * sizeof(lug::Math::Vec3f));
+        file.write(reinterpret_cast<const char*>(mesh.normals), mesh.vertexCount * sizeof(lug::Math::Vec3f));
+
+        for (const PrimitiveSet& primitiveSet : mesh.primitiveSets) {
+            const char padding[4] = {};
+            const size_t size = primitiveSet.indexCount * sizeof(uint16_t);
+
+            file.write(reinterpret_cast<const char*>(primitiveSet.indices), size);
+            file.write(padding, indicesSize(primitiveSet.indexCount) - size);
+        }
+
+        if (!file) {
+            return false;
+        }
+    }
+
+    std::remove(path.c_str());
+    return std::rename(temporaryPath.c_str(), path.c_str()) == 0;
+}
+
+uint64_t MeshCache::hash(const void* data, size_t size, uint64_t seed) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+    for (size_t i = 0; i < size; ++i) {
+        seed ^= bytes[i];
+        seed *= 1099511628211ull;
+    }
+
+    return seed;
+}
+
+std::string MeshCache::getPath(const std::string& generator, uint64_t parametersHash) const {
+    std::ostringstream path;
+    path << _directory << "/" << generator << "-" << std::hex << parametersHash << ".mesh";
+    return path.str();
+}
+
+bool MeshCache::map(const std::string& path) {
+    unmap();
+
+#if defined(LUG_SYSTEM_WINDOWS)
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+
+    _buffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+
+    if (!file.read(reinterpret_cast<char*>(_buffer.data()), _buffer.size())) {
+        _buffer.clear();
+        return false;
+    }
+
+    _data = _buffer.data();
+    _size = _buffer.size();
+#else
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    _data = static_cast<const uint8_t*>(data);
+    _size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+    return true;
+}
+
+void MeshCache::unmap() {
+#if !defined(LUG_SYSTEM_WINDOWS)
+    if (_data) {
+        munmap(const_cast<uint8_t*>(_data), _size);
+    }
+#endif
+
+    _buffer.clear();
+    _data = nullptr;
+    _size = 0;
+}
@@ -0,0 +1,349 @@
+#include "MeshSimplifier.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <queue>
+#include <utility>
+
+namespace MeshSimplifier {
+
+namespace {
+
+// Symmetric 4x4 matrix stored as its upper triangle
+struct Quadric {
+    double a2{0.0}, ab{0.0}, ac{0.0}, ad{0.0};
+    double b2{0.0}, bc{0.0}, bd{0.0};
+    double c2{0.0}, cd{0.0};
+    double d2{0.0};
+
+    void addPlane(double a, double b, double c, double d, double weight) {
+        a2 += weight * a * a; ab += weight * a * b; ac += weight * a * c; ad += weight * a * d;
+        b2 += weight * b * b; bc += weight * b * c; bd += weight * b * d;
+        c2 += weight * c * c; cd += weight * c * d;
+        d2 += weight * d * d;
+    }
+
+    Quadric& operator+=(const Quadric& other) {
+        a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+        b2 += other.b2; bc += other.bc; bd += other.bd;
+        c2 += other.c2; cd += other.cd;
+        d2 += other.d2;
+        return *this;
+    }
+
+    double evaluate(const lug::Math::Vec3f& p) const {
+        const double x = p.x();
+        const double y = p.y();
+        const double z = p.z();
+
+        return a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x
+             + b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y
+             + c2 * z * z + 2.0 * cd * z
+             + d2;
+    }
+};
+
+struct Collapse {
+    double cost;
+    uint32_t from;
+    uint32_t to;
+    uint32_t fromVersion;
+    uint32_t toVersion;
+
+    bool operator>(const Collapse& other) const {
+        return cost > other.cost;
+    }
+};
+
+using Triangle = std::array<uint32_t, 3>;
+
+lug::Math::Vec3f cross(const lug::Math::Vec3f& u, const lug::Math::Vec3f& v) {
+    return {
+        u.y() * v.z() - u.z() * v.y(),
+        u.z() * v.x() - u.x() * v.z(),
+        u.x() * v.y() - u.y() * v.x()
+    };
+}
+
+float dot(const lug::Math::Vec3f& u, const lug::Math::Vec3f& v) {
+    return u.x() * v.x() + u.y() * v.y() + u.z() * v.z();
+}
+
+lug::Math::Vec3f triangleNormal(const lug::Math::Vec3f& p0, const lug::Math::Vec3f& p1, const lug::Math::Vec3f& p2) {
+    return cross(p1 - p0, p2 - p0);
+}
+
+} // anonymous
+
+std::vector<uint16_t> simplify(const std::vector<lug::Math::Vec3f>& positions, const std::vector<uint16_t>& indices, size_t targetIndexCount) {
+    const uint32_t vertexCount = static_cast<uint32_t>(positions.size());
+
+    // Weld the vertices by position, the first vertex of each group becomes the representative
+    std::vector<uint32_t> remap(vertexCount);
+    {
+        std::vector<uint32_t> order(vertexCount);
+        std::iota(order.begin(), order.end(), 0);
+
+        const auto less = [&positions](uint32_t lhs, uint32_t rhs) {
+            const lug::Math::Vec3f& a = positions[lhs];
+            const lug::Math::Vec3f& b = positions[rhs];
+
+            if (a.x() != b.x()) {
+                return a.x() < b.x();
+            }
+            if (a.y() != b.y()) {
+                return a.y() < b.y();
+            }
+            if (a.z() != b.z()) {
+                return a.z() < b.z();
+            }
+            return lhs < rhs;
+        };
+
+        std::sort(order.begin(), order.end(), less);
+
+        for (uint32_t i = 0; i < vertexCount; ++i) {
+            const uint32_t vertex = order[i];
+            const bool samePosition = i > 0
+                && positions[order[i - 1]].x() == positions[vertex].x()
+                && positions[order[i - 1]].y() == positions[vertex].y()
+                && positions[order[i - 1]].z() == positions[vertex].z();
+
+            remap[vertex] = samePosition ? remap[order[i - 1]] : vertex;
+        }
+    }
+
+    // Gather the non degenerate triangles
+    std::vector<Triangle> triangles;
+    triangles.reserve(indices.size() / 3);
+
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const Triangle triangle{{remap[indices[i]], remap[indices[i + 1]], remap[indices[i + 2]]}};
+
+        if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[0] == triangle[2]) {
+            continue;
+        }
+
+        const lug::Math::Vec3f normal = triangleNormal(positions[triangle[0]], positions[triangle[1]], positions[triangle[2]]);
+        if (dot(normal, normal) == 0.0f) {
+            continue;
+        }
+
+        triangles.push_back(triangle);
+    }
+
+    std::vector<bool> triangleAlive(triangles.size(), true);
+    size_t aliveTriangles = triangles.size();
+
+    std::vector<std::vector<uint32_t>> vertexTriangles(vertexCount);
+    for (uint32_t t = 0; t < triangles.size(); ++t) {
+        for (uint32_t vertex : triangles[t]) {
+            vertexTriangles[vertex].push_back(t);
+        }
+    }
+
+    // Accumulate the area weighted plane of each triangle on its vertices
+    std::vector<Quadric> quadrics(vertexCount);
+    for (const Triangle& triangle : triangles) {
+        const lug::Math::Vec3f& p0 = positions[triangle[0]];
+        const lug::Math::Vec3f normal = triangleNormal(p0, positions[triangle[1]], positions[triangle[2]]);
+        const double length = std::sqrt(static_cast<double>(dot(normal, normal)));
+
+        const double a = normal.x() / length;
+        const double b = normal.y() / length;
+        const double c = normal.z() / length;
+        const double d = -(a * p0.x() + b * p0.y() + c * p0.z());
+
+        for (uint32_t vertex : triangle) {
+            quadrics[vertex].addPlane(a, b, c, d, length * 0.5);
+        }
+    }
+
+    // Constrain the boundary edges with planes perpendicular to their triangle
+    {
+        std::map<std::pair<uint32_t, uint32_t>, std::pair<uint32_t, uint32_t>> edges; // edge -> (count, triangle)
+
+        for (uint32_t t = 0; t < triangles.size(); ++t) {
+            for (uint32_t e = 0; e < 3; ++e) {
+                const uint32_t v0 = triangles[t][e];
+                const uint32_t v1 = triangles[t][(e + 1) % 3];
+
+                auto& edge = edges[std::minmax(v0, v1)];
+                ++edge.first;
+                edge.second = t;
+            }
+        }
+
+        for (const auto& edge : edges) {
+            if (edge.second.first != 1) {
+                continue;
+            }
+
+            const Triangle& triangle = triangles[edge.second.second];
+            const lug::Math::Vec3f& p0 = positions[edge.first.first];
+            const lug::Math::Vec3f& p1 = positions[edge.first.second];
+            const lug::Math::Vec3f normal = triangleNormal(positions[triangle[0]], positions[triangle[1]], positions[triangle[2]]);
+            const lug::Math::Vec3f planeNormal = cross(p1 - p0, normal);
+            const double length = std::sqrt(static_cast<double>(dot(planeNormal, planeNormal)));
+
+            if (length == 0.0) {
+                continue;
+            }
+
+            const double a = planeNormal.x() / length;
+            const double b = planeNormal.y() / length;
+            const double c = planeNormal.z() / length;
+            const double d = -(a * p0.x() + b * p0.y() + c * p0.z());
+            const double weight = static_cast<double>(dot(p1 - p0, p1 - p0)) * 10.0;
+
+            quadrics[edge.first.first].addPlane(a, b, c, d, weight);
+            quadrics[edge.first.second].addPlane(a, b, c, d, weight);
+        }
+    }
+
+    std::vector<uint32_t> versions(vertexCount, 0);
+    std::vector<bool> vertexAlive(vertexCount, true);
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> collapses;
+
+    const auto pushCollapse = [&](uint32_t from, uint32_t to) {
+        Quadric quadric = quadrics[from];
+        quadric += quadrics[to];
+
+        collapses.push({quadric.evaluate(positions[to]), from, to, versions[from], versions[to]});
+    };
+
+    const auto neighbours = [&](uint32_t vertex) {
+        std::vector<uint32_t> result;
+
+        for (uint32_t t : vertexTriangles[vertex]) {
+            if (!triangleAlive[t]) {
+                continue;
+            }
+
+            for (uint32_t other : triangles[t]) {
+                if (other != vertex) {
+                    result.push_back(other);
+                }
+            }
+        }
+
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    };
+
+    for (const Triangle& triangle : triangles) {
+        for (uint32_t e = 0; e < 3; ++e) {
+            pushCollapse(triangle[e], triangle[(e + 1) % 3]);
+            pushCollapse(triangle[(e + 1) % 3], triangle[e]);
+        }
+    }
+
+    while (aliveTriangles * 3 > targetIndexCount && !collapses.empty()) {
+        const Collapse collapse = collapses.top();
+        collapses.pop();
+
+        if (!vertexAlive[collapse.from] || !vertexAlive[collapse.to]
+            || versions[collapse.from] != collapse.fromVersion || versions[collapse.to] != collapse.toVersion) {
+            continue;
+        }
+
+        // Link condition: the vertices may only share the neighbours of the triangles of the edge
+        uint32_t sharedTriangles = 0;
+        for (uint32_t t : vertexTriangles[collapse.from]) {
+            if (triangleAlive[t] && std::find(triangles[t].begin(), triangles[t].end(), collapse.to) != triangles[t].end()) {
+                ++sharedTriangles;
+            }
+        }
+
+        if (sharedTriangles == 0) {
+            continue;
+        }
+
+        {
+            const std::vector<uint32_t> fromNeighbours = neighbours(collapse.from);
+            const std::vector<uint32_t> toNeighbours = neighbours(collapse.to);
+            std::vector<uint32_t> sharedNeighbours;
+
+            std::set_intersection(
+                fromNeighbours.begin(), fromNeighbours.end(),
+                toNeighbours.begin(), toNeighbours.end(),
+                std::back_inserter(sharedNeighbours)
+            );
+
+            if (sharedNeighbours.size() > sharedTriangles) {
+                continue;
+            }
+        }
+
+        // Reject the collapses flipping a triangle
+        bool flips = false;
+        for (uint32_t t : vertexTriangles[collapse.from]) {
+            const Triangle& triangle = triangles[t];
+
+            if (!triangleAlive[t] || std::find(triangle.begin(), triangle.end(), collapse.to) != triangle.end()) {
+                continue;
+            }
+
+            Triangle collapsed = triangle;
+            std::replace(collapsed.begin(), collapsed.end(), collapse.from, collapse.to);
+
+            const lug::Math::Vec3f before = triangleNormal(positions[triangle[0]], positions[triangle[1]], positions[triangle[2]]);
+            const lug::Math::Vec3f after = triangleNormal(positions[collapsed[0]], positions[collapsed[1]], positions[collapsed[2]]);
+
+            if (dot(before, after) <= 0.0f) {
+                flips = true;
+                break;
+            }
+        }
+
+        if (flips) {
+            continue;
+        }
+
+        // Collapse the edge
+        for (uint32_t t : vertexTriangles[collapse.from]) {
+            if (!triangleAlive[t]) {
+                continue;
+            }
+
+            Triangle& triangle = triangles[t];
+
+            if (std::find(triangle.begin(), triangle.end(), collapse.to) != triangle.end()) {
+                triangleAlive[t] = false;
+                --aliveTriangles;
+            } else {
+                std::replace(triangle.begin(), triangle.end(), collapse.from, collapse.to);
+                vertexTriangles[collapse.to].push_back(t);
+            }
+        }
+
+        vertexTriangles[collapse.from].clear();
+        vertexAlive[collapse.from] = false;
+        quadrics[collapse.to] += quadrics[collapse.from];
+        ++versions[collapse.to];
+
+        for (uint32_t neighbour : neighbours(collapse.to)) {
+            pushCollapse(collapse.to, neighbour);
+            pushCollapse(neighbour, collapse.to);
+        }
+    }
+
+    std::vector<uint16_t> result;
+    result.reserve(aliveTriangles * 3);
+
+    for (uint32_t t = 0; t < triangles.size(); ++t) {
+        if (triangleAlive[t]) {
+            for (uint32_t vertex : triangles[t]) {
+                result.push_back(static_cast<uint16_t>(vertex));
+            }
+        }
+    }
+
+    return result;
+}
+
+} // MeshSimplifier
@@ -0,0 +1,328 @@
+#include "Topology.hpp"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <unordered_map>
+
+namespace Topology {
+
+namespace {
+
+using Triangle = std::array<uint16_t, 3>;
+
+bool hasDirectedEdge(const Triangle& triangle, uint16_t a, uint16_t b) {
+    for (size_t i = 0; i < 3; ++i) {
+        if (triangle[i] == a && triangle[(i + 1) % 3] == b) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+uint16_t thirdVertex(const Triangle& triangle, uint16_t a, uint16_t b) {
+    for (uint16_t vertex : triangle) {
+        if (vertex != a && vertex != b) {
+            return vertex;
+        }
+    }
+
+    return triangle[0];
+}
+
+uint32_t edgeKey(uint16_t a, uint16_t b) {
+    return a < b ? (static_cast<uint32_t>(a) << 16) | b : (static_cast<uint32_t>(b) << 16) | a;
+}
+
+} // anonymous
+
+std::vector<uint16_t> stripToList(const std::vector<uint16_t>& strip) {
+    std::vector<uint16_t> list;
+
+    if (strip.size() < 3) {
+        return list;
+    }
+
+    list.reserve((strip.size() - 2) * 3);
+
+    // Position of the first vertex of the current strip, primitive restart starts a new one
+    size_t start = 0;
+
+    for (size_t i = 0; i < strip.size(); ++i) {
+        if (strip[i] == restartIndex) {
+            start = i + 1;
+            continue;
+        }
+
+        if (i < start + 2) {
+            continue;
+        }
+
+        const uint16_t a = strip[i - 2];
+        const uint16_t b = strip[i - 1];
+        const uint16_t c = strip[i];
+
+        if (a == b || b == c || a == c) {
+            continue;
+        }
+
+        // Every odd triangle of a strip has a reversed winding
+        if ((i - start) % 2 == 0) {
+            list.insert(list.end(), {a, b, c});
+        } else {
+            list.insert(list.end(), {b, a, c});
+        }
+    }
+
+    return list;
+}
+
+std::vector<uint16_t> listToStrip(const std::vector<uint16_t>& list, bool primitiveRestart) {
+    const size_t triangleCount = list.size() / 3;
+
+    std::vector<Triangle> triangles(triangleCount);
+    std::unordered_map<uint32_t, std::vector<uint32_t>> edgeTriangles;
+
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        triangles[t] = {{list[t * 3], list[t * 3 + 1], list[t * 3 + 2]}};
+
+        for (size_t i = 0; i < 3; ++i) {
+            edgeTriangles[edgeKey(triangles[t][i], triangles[t][(i + 1) % 3])].push_back(t);
+        }
+    }
+
+    std::vector<bool> used(triangleCount, false);
+
+    // Unused triangle containing the directed edge a -> b
+    const auto findNeighbour = [&](uint16_t a, uint16_t b) {
+        const auto it = edgeTriangles.find(edgeKey(a, b));
+
+        if (it != edgeTriangles.end()) {
+            for (uint32_t t : it->second) {
+                if (!used[t] && hasDirectedEdge(triangles[t], a, b)) {
+                    return static_cast<int64_t>(t);
+                }
+            }
+        }
+
+        return static_cast<int64_t>(-1);
+    };
+
+    std::vector<uint16_t> result;
+    result.reserve(list.size());
+
+    std::vector<uint16_t> strip;
+
+    for (uint32_t seed = 0; seed < triangleCount; ++seed) {
+        if (used[seed]) {
+            continue;
+        }
+
+        used[seed] = true;
+
+        // Start with the rotation of the seed that can be continued, if any
+        Triangle first = triangles[seed];
+        for (size_t rotation = 0; rotation < 3; ++rotation) {
+            const Triangle rotated{{triangles[seed][rotation], triangles[seed][(rotation + 1) % 3], triangles[seed][(rotation + 2) % 3]}};
+
+            if (findNeighbour(rotated[2], rotated[1]) != -1) {
+                first = rotated;
+                break;
+            }
+        }
+
+        strip.assign(first.begin(), first.end());
+
+        while (true) {
+            const size_t n = strip.size();
+
+            // The next triangle of the strip (n - 2) is odd, thus reversed, when n is odd
+            const int64_t next = (n % 2 == 1) ? findNeighbour(strip[n - 1], strip[n - 2]) : findNeighbour(strip[n - 2], strip[n - 1]);
+
+            if (next == -1) {
+                break;
+            }
+
+            used[next] = true;
+            strip.push_back(thirdVertex(triangles[next], strip[n - 2], strip[n - 1]));
+        }
+
+        // Join the strips
+        if (!result.empty()) {
+            if (primitiveRestart) {
+                result.push_back(restartIndex);
+            } else {
+                result.push_back(result.back());
+                result.push_back(strip.front());
+
+                // Keep the first triangle of the strip on an even position
+                if (result.size() % 2 == 1) {
+                    result.push_back(strip.front());
+                }
+            }
+        }
+
+        result.insert(result.end(), strip.begin(), strip.end());
+    }
+
+    return result;
+}
+
+std::vector<uint16_t> optimizeList(const std::vector<uint16_t>& list, size_t vertexCount, uint32_t cacheSize) {
+    const size_t triangleCount = list.size() / 3;
+
+    std::vector<std::vector<uint32_t>> vertexTriangles(vertexCount);
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        for (size_t i = 0; i < 3; ++i) {
+            vertexTriangles[list[t * 3 + i]].push_back(t);
+        }
+    }
+
+    std::vector<uint32_t> liveTriangles(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        liveTriangles[v] = static_cast<uint32_t>(vertexTriangles[v].size());
+    }
+
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint16_t> deadEnds;
+    std::vector<uint16_t> candidates;
+
+    std::vector<uint16_t> result;
+    result.reserve(list.size());
+
+    uint32_t time = cacheSize + 1;
+    size_t cursor = 0;
+
+    const auto skipDeadEnd = [&]() -> int64_t {
+        while (!deadEnds.empty()) {
+            const uint16_t vertex = deadEnds.back();
+            deadEnds.pop_back();
+
+            if (liveTriangles[vertex] > 0) {
+                return vertex;
+            }
+        }
+
+        for (; cursor < vertexCount; ++cursor) {
+            if (liveTriangles[cursor] > 0) {
+                return static_cast<int64_t>(cursor);
+            }
+        }
+
+        return -1;
+    };
+
+    int64_t fanning = skipDeadEnd();
+
+    while (fanning >= 0) {
+        candidates.clear();
+
+        for (uint32_t t : vertexTriangles[fanning]) {
+            if (emitted[t]) {
+                continue;
+            }
+
+            for (size_t i = 0; i < 3; ++i) {
+                const uint16_t vertex = list[t * 3 + i];
+
+                result.push_back(vertex);
+                deadEnds.push_back(vertex);
+                candidates.push_back(vertex);
+                --liveTriangles[vertex];
+
+                if (time - cacheTime[vertex] > cacheSize) {
+                    cacheTime[vertex] = time++;
+                }
+            }
+
+            emitted[t] = true;
+        }
+
+        // Next fanning vertex: the oldest candidate still in the cache after emitting its triangles
+        // The candidates out of the cache have a priority of 0 but are still better than a dead end
+        fanning = -1;
+        int64_t bestPriority = -1;
+
+        for (uint16_t vertex : candidates) {
+            if (liveTriangles[vertex] == 0) {
+                continue;
+            }
+
+            int64_t priority = 0;
+            if (time - cacheTime[vertex] + 2 * liveTriangles[vertex] <= cacheSize) {
+                priority = time - cacheTime[vertex];
+            }
+
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                fanning = vertex;
+            }
+        }
+
+        if (fanning == -1) {
+            fanning = skipDeadEnd();
+        }
+    }
+
+    return result;
+}
+
+float computeAcmr(const std::vector<uint16_t>& indices, lug::Graphics::Render::Mesh::PrimitiveSet::Mode mode, uint32_t cacheSize) {
+    const std::vector<uint16_t> triangles = mode == lug::Graphics::Render::Mesh::PrimitiveSet::Mode::TriangleStrip ? stripToList(indices) : indices;
+
+    if (triangles.empty()) {
+        return 0.0f;
+    }
+
+    std::deque<uint16_t> cache;
+    size_t misses = 0;
+
+    for (uint16_t index : indices) {
+        if (index == restartIndex && mode == lug::Graphics::Render::Mesh::PrimitiveSet::Mode::TriangleStrip) {
+            continue;
+        }
+
+        if (std::find(cache.begin(), cache.end(), index) != cache.end()) {
+            continue;
+        }
+
+        ++misses;
+        cache.push_back(index);
+
+        if (cache.size() > cacheSize) {
+            cache.pop_front();
+        }
+    }
+
+    return static_cast<float>(misses) / static_cast<float>(triangles.size() / 3);
+}
+
+Result convert(const std::vector<uint16_t>& list, size_t vertexCount, const Target& target) {
+    std::vector<uint16_t> optimizedList = optimizeList(list, vertexCount, target.cacheSize);
+    std::vector<uint16_t> strip = listToStrip(optimizedList, target.primitiveRestart);
+
+    Result result;
+
+    result.listIndexCount = optimizedList.size();
+    result.listAcmr = computeAcmr(optimizedList, lug::Graphics::Render::Mesh::PrimitiveSet::Mode::Triangles, target.cacheSize);
+
+    result.stripIndexCount = strip.size();
+    result.stripAcmr = computeAcmr(strip, lug::Graphics::Render::Mesh::PrimitiveSet::Mode::TriangleStrip, target.cacheSize);
+
+    const bool useStrip = result.stripAcmr < result.listAcmr
+        || (result.stripAcmr == result.listAcmr && result.stripIndexCount < result.listIndexCount);
+
+    if (useStrip) {
+        result.mode = lug::Graphics::Render::Mesh::PrimitiveSet::Mode::TriangleStrip;
+        result.indices = std::move(strip);
+    } else {
+        result.mode = lug::Graphics::Render::Mesh::PrimitiveSet::Mode::Triangles;
+        result.indices = std::move(optimizedList);
+    }
+
+    return result;
+}
+
+} // Topology
@@ -0,0 +1,138 @@
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "Clusterizer.hpp"
+#include "ProceduralMesh.hpp"
+#include "SampleTest.hpp"
+
+// Checks the clusters of the sphere of the sample and the triangles their culling rejects for fixed
+// camera poses, on the CPU.
+
+namespace {
+
+using SampleTest::check;
+
+constexpr uint32_t xSegments = 64;
+constexpr uint32_t ySegments = 64;
+
+struct Pose {
+    const char* name;
+    lug::Math::Vec3f position;
+    lug::Math::Vec3f target;
+};
+
+lug::Math::Vec3f sub(const lug::Math::Vec3f& a, const lug::Math::Vec3f& b) {
+    return {a.x() - b.x(), a.y() - b.y(), a.z() - b.z()};
+}
+
+float dotProduct(const lug::Math::Vec3f& a, const lug::Math::Vec3f& b) {
+    return a.x() * b.x() + a.y() * b.y() + a.z() * b.z();
+}
+
+lug::Math::Vec3f crossProduct(const lug::Math::Vec3f& a, const lug::Math::Vec3f& b) {
+    return {a.y() * b.z() - a.z() * b.y(), a.z() * b.x() - a.x() * b.z(), a.x() * b.y() - a.y() * b.x()};
+}
+
+lug::Math::Vec3f normalized(const lug::Math::Vec3f& v) {
+    const float length = std::sqrt(dotProduct(v, v));
+    return {v.x() / length, v.y() / length, v.z() / length};
+}
+
+lug::Math::Vec4f plane(const lug::Math::Vec3f& normal, const lug::Math::Vec3f& point) {
+    return {normal.x(), normal.y(), normal.z(), -dotProduct(normal, point)};
+}
+
+// The frustum of the camera of the sample, 45 degrees vertically, square, from 0.1 to 100
+Clusterizer::Frustum getFrustum(const Pose& pose) {
+    const float halfAngle = 22.5f * 3.14159265f / 180.0f;
+
+    const lug::Math::Vec3f forward = normalized(sub(pose.target, pose.position));
+    const lug::Math::Vec3f right = normalized(crossProduct(forward, {0.0f, 1.0f, 0.0f}));
+    const lug::Math::Vec3f up = crossProduct(right, forward);
+
+    const float c = std::cos(halfAngle);
+    const float s = std::sin(halfAngle);
+
+    const auto combine = [](const lug::Math::Vec3f& a, float x, const lug::Math::Vec3f& b, float y) {
+        return lug::Math::Vec3f{a.x() * x + b.x() * y, a.y() * x + b.y() * y, a.z() * x + b.z() * y};
+    };
+
+    const lug::Math::Vec3f nearPoint = combine(pose.position, 1.0f, forward, 0.1f);
+    const lug::Math::Vec3f farPoint = combine(pose.position, 1.0f, forward, 100.0f);
+
+    return {{
+        plane(combine(right, c, forward, s), pose.position),    // Left
+        plane(combine(right, -c, forward, s), pose.position),   // Right
+        plane(combine(up, c, forward, s), pose.position),       // Bottom
+        plane(combine(up, -c, forward, s), pose.position),      // Top
+        plane(forward, nearPoint),                              // Near
+        plane(combine(forward, -1.0f, forward, 0.0f), farPoint) // Far
+    }};
+}
+
+bool testClusterCulling() {
+    std::vector<lug::Math::Vec3f> positions;
+    std::vector<lug::Math::Vec3f> normals;
+    std::vector<lug::Math::Vec2f> uvs;
+    ProceduralMesh::generateSphere(xSegments, ySegments, positions, normals, uvs);
+
+    std::vector<uint16_t> triangles;
+    ProceduralMesh::generateSphereTriangles(xSegments, ySegments, triangles);
+
+    const std::vector<Clusterizer::Cluster> clusters = Clusterizer::build(positions, normals, triangles);
+
+    bool success = true;
+
+    size_t clusteredTriangles = 0;
+
+    for (const Clusterizer::Cluster& cluster : clusters) {
+        clusteredTriangles += cluster.indices.size() / 3;
+        success &= check(cluster.vertexCount <= 64 && cluster.indices.size() / 3 <= 124, "a cluster exceeds its limits");
+    }
+
+    success &= check(clusteredTriangles == triangles.size() / 3, "the clusters don't cover the mesh");
+
+    std::printf("%zu triangles in %zu clusters\n", triangles.size() / 3, clusters.size());
+
+    const Pose poses[] = {
+        {"far", {0.0f, 0.0f, 25.0f}, {0.0f, 0.0f, 0.0f}},
+        {"close", {0.0f, 0.0f, 1.5f}, {0.0f, 0.0f, 0.0f}},
+        {"edge", {0.0f, 0.0f, 25.0f}, {10.0f, 0.0f, 0.0f}},
+        {"away", {0.0f, 0.0f, 25.0f}, {0.0f, 0.0f, 50.0f}}
+    };
+
+    float rejected[4][2];
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        Clusterizer::CullingStats stats;
+        Clusterizer::cull(clusters, {0.0f, 0.0f, 0.0f}, poses[i].position, getFrustum(poses[i]), stats);
+
+        rejected[i][0] = static_cast<float>(stats.backfaceTriangles) / stats.totalTriangles;
+        rejected[i][1] = static_cast<float>(stats.frustumTriangles) / stats.totalTriangles;
+
+        std::printf("%s: %.1f%% backface culled, %.1f%% frustum culled\n", poses[i].name, 100.0f * rejected[i][0], 100.0f * rejected[i][1]);
+    }
+
+    // Seen from afar, a bit less than the back half is rejected
+    success &= check(rejected[0][0] > 0.2f && rejected[0][0] < 0.5f && rejected[0][1] == 0.0f, "far: unexpected rejection");
+
+    // Seen from close, more of the sphere faces away and its sides are out of the frustum
+    success &= check(rejected[1][0] > rejected[0][0] && rejected[1][1] > 0.0f, "close: unexpected rejection");
+
+    // On the edge of the frustum, a part of it is out
+    success &= check(rejected[2][1] > 0.0f && rejected[2][1] < 1.0f, "edge: unexpected rejection");
+
+    // Behind the camera, everything is out
+    success &= check(rejected[3][1] == 1.0f, "away: unexpected rejection");
+
+    return success;
+}
+
+} // anonymous
+
+int main() {
+    return SampleTest::run({
+        {"cluster culling", testClusterCulling}
+    });
+}
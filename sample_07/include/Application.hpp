@@ -1,11 +1,15 @@
 #pragma once
 
-#include <lug/Core/Application.hpp>
-#include <lug/Core/FreeMovement.hpp>
+#include <memory>
 #include <lug/Graphics/Render/Mesh.hpp>
 #include <lug/Graphics/Scene/Scene.hpp>
 
-class Application : public ::lug::Core::Application {
+#include "MipStreamer.hpp"
+#include "SampleApplication.hpp"
+#include "TextureCache.hpp"
+#include "TextureResidency.hpp"
+
+class Application : public SampleApplication {
 public:
     Application();
 
@@ -18,13 +22,34 @@ public:
     ~Application() override final = default;
 
     bool init(int argc, char* argv[]);
-    bool initSphereMesh();
+    bool initTextureResidency(uint64_t budget);
+    void initMipStreaming(uint64_t bytesPerSecond);
 
-    void onEvent(const lug::Window::Event& event) override final;
-    void onFrame(const lug::System::Time& elapsedTime) override final;
+    void updateTextureResidency(float elapsedSeconds);
 
 private:
+    void onSampleFrame(const lug::System::Time& elapsedTime) override final;
+    void onClose() override final;
+
+    /**
+     * @brief      Times the mip chain of a 4096x4096 color texture and normal map with each kernel
+     *             of MipGenerator, on one and on all the threads, for --benchmark-mips.
+     */
+    void benchmarkMipGeneration();
+
     lug::Graphics::Resource::SharedPtr<lug::Graphics::Scene::Scene> _scene;
     lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Mesh> _sphereMesh;
-    lug::Core::FreeMovement _mover;
+
+    uint32_t _perfResidentBytesCounter;
+    uint32_t _perfStreamedBytesCounter;
+
+    TextureCache _textureCache;
+
+    // The engine keeps the textures fully resident, the residency they would have within the budget is simulated
+    TextureResidency::FakeAllocator _textureAllocator;
+    std::unique_ptr<TextureResidency> _textureResidency;
+    uint32_t _residentTextures[4];
+
+    // The engine loads the full textures itself, the streamed levels are only measured
+    std::unique_ptr<MipStreamer> _mipStreamer;
 };
@@ -1,26 +1,69 @@
 #include "Application.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
 #include <imgui.h>
 
-#include <lug/Graphics/Builder/Camera.hpp>
-#include <lug/Graphics/Builder/Light.hpp>
 #include <lug/Graphics/Builder/Material.hpp>
-#include <lug/Graphics/Builder/Mesh.hpp>
 #include <lug/Graphics/Builder/Scene.hpp>
-#include <lug/Graphics/Builder/Texture.hpp>
 #include <lug/Graphics/Renderer.hpp>
 #include <lug/Graphics/Vulkan/Renderer.hpp>
 #include <lug/Math/Geometry/Trigonometry.hpp>
 
-Application::Application() : lug::Core::Application::Application{{"sample_07", {0, 1, 0}}} {
+#include "ImageFile.hpp"
+#include "MipGenerator.hpp"
+#include "MipStreamer.hpp"
+#include "ProceduralMesh.hpp"
+#include "SampleScene.hpp"
+#include "TextureCache.hpp"
+#include "TextureResidency.hpp"
+#include "Trace.hpp"
+
+namespace {
+
+// In the order of the spheres, the sphere i + 1 is the first one using the texture i
+const std::string textureNames[4] = {
+    "textures/rustediron2_basecolor",
+    "textures/rustediron2_metallic_roughness",
+    "textures/rustediron2_normal",
+    "textures/rustediron2_emissive"
+};
+
+} // anonymous
+
+Application::Application() : SampleApplication{{"sample_07", {0, 1, 0}}} {
     getRenderWindowInfo().windowInitInfo.title = "Sample 07";
 }
 
 bool Application::init(int argc, char* argv[]) {
-    if (!lug::Core::Application::init(argc, argv)) {
+    if (!SampleApplication::init(argc, argv)) {
         return false;
     }
 
+    uint64_t textureBudget = 64;
+    uint64_t mipStreamRate = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--benchmark-mips") == 0) {
+            // Like --benchmark-logging, the sample doesn't run after the benchmark
+            benchmarkMipGeneration();
+            return false;
+        } else if (std::strcmp(argv[i], "--texture-budget") == 0 && i + 1 < argc) {
+            textureBudget = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--mip-stream-rate") == 0 && i + 1 < argc) {
+            mipStreamRate = std::strtoull(argv[++i], nullptr, 10);
+        }
+    }
+
+    _perfResidentBytesCounter = _perfOverlay.addCounter("texture resident bytes");
+    _perfStreamedBytesCounter = _perfOverlay.addCounter("texture streamed bytes");
+
     lug::Graphics::Renderer* renderer = _graphics.getRenderer();
 
     // Build the scene
@@ -35,354 +78,248 @@ bool Application::init(int argc, char* argv[]) {
         }
     }
 
-    // Attach cameras
+    // Attach camera, moved by the mouse and the keyboard
     {
-        lug::Graphics::Builder::Camera cameraBuilder(*renderer);
-
-        cameraBuilder.setFovY(45.0f);
-        cameraBuilder.setZNear(0.1f);
-        cameraBuilder.setZFar(100.0f);
-
-        lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Camera::Camera> camera = cameraBuilder.build();
-        if (!camera) {
-            LUG_LOG.error("Application: Can't create the camera");
+        lug::Graphics::Scene::Node* node = SampleScene::attachCamera(*renderer, *_scene, "camera", 0);
+        if (!node) {
             return false;
         }
 
-        lug::Graphics::Scene::Node* node = _scene->createSceneNode("camera");
-        _scene->getRoot().attachChild(*node);
-
-        node->attachCamera(camera);
-
-        // Attach a mover to the first camera
-        _mover.setTargetNode(*node);
-        _mover.setEventSource(*renderer->getWindow());
-
-        // Attach camera to RenderView
-        {
-            auto& renderViews = _graphics.getRenderer()->getWindow()->getRenderViews();
-
-            LUG_ASSERT(renderViews.size() > 0, "There should be at least 1 render view");
-
-            renderViews[0]->attachCamera(camera);
-        }
+        setMovedCamera(*node);
     }
 
     // Create the sphere mesh
-    if (!initSphereMesh()) {
+    _sphereMesh = ProceduralMesh::buildSphere(*renderer, 64, 64);
+    if (!_sphereMesh) {
         return false;
     }
 
-    // Load the base color texture
-    lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Texture> baseColorTexture;
-    {
-        lug::Graphics::Builder::Texture textureBuilder(*renderer);
-
-        textureBuilder.addLayer("textures/rustediron2_basecolor.jpg");
-        textureBuilder.setMinFilter(lug::Graphics::Render::Texture::Filter::Linear);
-        textureBuilder.setMagFilter(lug::Graphics::Render::Texture::Filter::Linear);
+    // Attach the spheres, each one using one more texture than the previous one
+    for (uint32_t i = 0; i < 5; ++i) {
+        // The textures are shared through the cache, only the first sphere using one loads it
+        lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Texture> textures[4];
 
-        baseColorTexture = textureBuilder.build();
-        if (!baseColorTexture) {
-            LUG_LOG.error("Application: Can't create the base color texture");
-            return false;
+        for (uint32_t j = 0; j < i; ++j) {
+            textures[j] = _textureCache.load(*renderer, textureNames[j] + ".jpg");
+            if (!textures[j]) {
+                return false;
+            }
         }
-    }
 
-    // Load the metallic roughness texture
-    lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Texture> metallicRoughnessTexture;
-    {
-        lug::Graphics::Builder::Texture textureBuilder(*renderer);
+        lug::Graphics::Builder::Material materialBuilder(*renderer);
+        materialBuilder.setBaseColorFactor({1.0f, 1.0f, 1.0f, 1.0f});
 
-        textureBuilder.addLayer("textures/rustediron2_metallic_roughness.jpg");
-        textureBuilder.setMinFilter(lug::Graphics::Render::Texture::Filter::Linear);
-        textureBuilder.setMagFilter(lug::Graphics::Render::Texture::Filter::Linear);
+        if (i >= 1) {
+            materialBuilder.setBaseColorTexture(textures[0], 0);
+        }
 
-        metallicRoughnessTexture = textureBuilder.build();
-        if (!metallicRoughnessTexture) {
-            LUG_LOG.error("Application: Can't create the metallic roughness texture");
-            return false;
+        if (i >= 2) {
+            materialBuilder.setMetallicRoughnessTexture(textures[1], 0);
         }
-    }
 
-    // Load the normal texture
-    lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Texture> normalTexture;
-    {
-        lug::Graphics::Builder::Texture textureBuilder(*renderer);
+        if (i >= 3) {
+            materialBuilder.setNormalTexture(textures[2], 0);
+        }
+
+        if (i >= 4) {
+            materialBuilder.setEmissiveFactor({1.0f, 1.0f, 1.0f});
+            materialBuilder.setEmissiveTexture(textures[3], 0);
+        }
 
-        textureBuilder.addLayer("textures/rustediron2_normal.jpg");
-        textureBuilder.setMinFilter(lug::Graphics::Render::Texture::Filter::Linear);
-        textureBuilder.setMagFilter(lug::Graphics::Render::Texture::Filter::Linear);
+        lug::Graphics::Scene::Node* node = _scene->createSceneNode("sphere" + std::to_string(i));
+        _scene->getRoot().attachChild(*node);
 
-        normalTexture = textureBuilder.build();
-        if (!normalTexture) {
-            LUG_LOG.error("Application: Can't create the normal texture");
+        lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Material> material = materialBuilder.build();
+        if (!material) {
+            LUG_LOG.error("Application: Can't create the material");
             return false;
         }
+
+        node->attachMeshInstance(_sphereMesh, material);
+
+        node->setPosition({
+            -6.0f + 3.0f * i,
+            0.0f,
+            0.0f
+        }, lug::Graphics::Node::TransformSpace::World);
     }
 
-    // Load the emissive texture
-    lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Texture> emissiveTexture;
+    // Set the position of the camera
     {
-        lug::Graphics::Builder::Texture textureBuilder(*renderer);
+        _scene->getSceneNode("camera")->setPosition({0.0f, 0.0f, 15.0f}, lug::Graphics::Node::TransformSpace::World);
+        _scene->getSceneNode("camera")->getCamera()->lookAt({0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, lug::Graphics::Node::TransformSpace::World);
+    }
 
-        textureBuilder.addLayer("textures/rustediron2_emissive.jpg");
-        textureBuilder.setMinFilter(lug::Graphics::Render::Texture::Filter::Linear);
-        textureBuilder.setMagFilter(lug::Graphics::Render::Texture::Filter::Linear);
+    // Attach 4 lights
+    if (!SampleScene::attachPointLights(*renderer, *_scene)) {
+        return false;
+    }
 
-        emissiveTexture = textureBuilder.build();
-        if (!emissiveTexture) {
-            LUG_LOG.error("Application: Can't create the emissive texture");
-            return false;
-        }
+    if (!initTextureResidency(textureBudget * 1024 * 1024)) {
+        return false;
     }
 
-    // Attach the spheres
-    {
-        lug::Graphics::Builder::Material materialBuilder(*renderer);
-        materialBuilder.setBaseColorFactor({1.0f, 1.0f, 1.0f, 1.0f});
+    initMipStreaming(mipStreamRate * 1024 * 1024);
 
-        {
-            lug::Graphics::Scene::Node* node = _scene->createSceneNode("sphere0");
-            _scene->getRoot().attachChild(*node);
+    return true;
+}
 
-            lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Material> material = materialBuilder.build();
-            if (!material) {
-                LUG_LOG.error("Application: Can't create the material");
-                return false;
-            }
+bool Application::initTextureResidency(uint64_t budget) {
+    // A frame streams at most 16 MB, 1 GB/s at 60 frames per second
+    _textureResidency = std::make_unique<TextureResidency>(_textureAllocator, budget, 16 * 1024 * 1024);
 
-            node->attachMeshInstance(_sphereMesh, material);
+    for (uint32_t i = 0; i < 4; ++i) {
+        uint32_t width;
+        uint32_t height;
+        uint32_t components;
 
-            node->setPosition({
-                -6.0f,
-                0.0f,
-                0.0f
-            }, lug::Graphics::Node::TransformSpace::World);
+        if (!ImageFile::getInfo(textureNames[i] + ".jpg", width, height, components)) {
+            return false;
         }
 
-        {
-            materialBuilder.setBaseColorTexture(baseColorTexture, 0);
-
-            lug::Graphics::Scene::Node* node = _scene->createSceneNode("sphere1");
-            _scene->getRoot().attachChild(*node);
+        // The engine uploads the textures as RGBA8
+        _residentTextures[i] = _textureResidency->addTexture(textureNames[i] + ".jpg", width, height, 4);
+        if (_residentTextures[i] == TextureResidency::invalidTexture) {
+            return false;
+        }
+    }
 
-            lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Material> material = materialBuilder.build();
-            if (!material) {
-                LUG_LOG.error("Application: Can't create the material");
-                return false;
-            }
+    return true;
+}
 
-            node->attachMeshInstance(_sphereMesh, material);
+void Application::initMipStreaming(uint64_t bytesPerSecond) {
+    // Created after the textures of the engine are loaded, the streamer only times its own reads
+    _mipStreamer = std::make_unique<MipStreamer>(bytesPerSecond);
 
-            node->setPosition({
-                -3.0f,
-                0.0f,
-                0.0f
-            }, lug::Graphics::Node::TransformSpace::World);
+    // The textures are cooked at build time, except on android
+    for (uint32_t i = 0; i < 4; ++i) {
+        if (_mipStreamer->addTexture(textureNames[i] + ".lugm") == MipStreamer::invalidTexture) {
+            LUG_LOG.warn("Application: Can't open the cooked textures, their mips aren't streamed");
+            _mipStreamer.reset();
+            return;
         }
+    }
 
-        {
-            materialBuilder.setMetallicRoughnessTexture(metallicRoughnessTexture, 0);
-
-            lug::Graphics::Scene::Node* node = _scene->createSceneNode("sphere2");
-            _scene->getRoot().attachChild(*node);
-
-            lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Material> material = materialBuilder.build();
-            if (!material) {
-                LUG_LOG.error("Application: Can't create the material");
-                return false;
-            }
+    _mipStreamer->start();
+}
 
-            node->attachMeshInstance(_sphereMesh, material);
+void Application::benchmarkMipGeneration() {
+    SAMPLE_TRACE_ZONE("benchmarkMipGeneration");
 
-            node->setPosition({
-                0.0f,
-                0.0f,
-                0.0f
-            }, lug::Graphics::Node::TransformSpace::World);
-        }
+    // The full chain of a 4K texture, with the default kernel on all the threads, should fit in a loading screen
+    constexpr float budgetMilliseconds = 500.0f;
+    constexpr uint32_t size = 4096;
 
-        {
-            materialBuilder.setNormalTexture(normalTexture, 0);
+    const struct {
+        const char* filename;
+        MipGenerator::Content content;
+    } textures[] = {
+        {"textures/rustediron2_basecolor.jpg", MipGenerator::Content::Color},
+        {"textures/rustediron2_normal.jpg", MipGenerator::Content::Normal}
+    };
 
-            lug::Graphics::Scene::Node* node = _scene->createSceneNode("sphere3");
-            _scene->getRoot().attachChild(*node);
+    const uint32_t hardwareThreadCount = std::max(1u, std::thread::hardware_concurrency());
 
-            lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Material> material = materialBuilder.build();
-            if (!material) {
-                LUG_LOG.error("Application: Can't create the material");
-                return false;
-            }
+    using Clock = std::chrono::high_resolution_clock;
 
-            node->attachMeshInstance(_sphereMesh, material);
+    for (const auto& texture : textures) {
+        ImageFile::Image image;
 
-            node->setPosition({
-                3.0f,
-                0.0f,
-                0.0f
-            }, lug::Graphics::Node::TransformSpace::World);
+        if (!ImageFile::load(texture.filename, image, 4)) {
+            return;
         }
 
-        {
-            materialBuilder.setEmissiveFactor({1.0f, 1.0f, 1.0f});
-            materialBuilder.setEmissiveTexture(emissiveTexture, 0);
+        // Tile the texture up to 4096x4096
+        std::vector<uint8_t> texels(size_t(size) * size * 4);
 
-            lug::Graphics::Scene::Node* node = _scene->createSceneNode("sphere4");
-            _scene->getRoot().attachChild(*node);
+        for (uint32_t y = 0; y < size; ++y) {
+            const uint8_t* row = image.texels.data() + size_t(y % image.height) * image.width * 4;
+            uint8_t* out = texels.data() + size_t(y) * size * 4;
 
-            lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Material> material = materialBuilder.build();
-            if (!material) {
-                LUG_LOG.error("Application: Can't create the material");
-                return false;
+            for (uint32_t x = 0; x < size; ++x) {
+                std::memcpy(out + x * 4, row + (x % image.width) * 4, 4);
             }
+        }
 
-            node->attachMeshInstance(_sphereMesh, material);
+        for (MipGenerator::Kernel kernel : {MipGenerator::Kernel::Box, MipGenerator::Kernel::Triangle, MipGenerator::Kernel::Kaiser, MipGenerator::Kernel::Lanczos3}) {
+            for (uint32_t threadCount : {1u, hardwareThreadCount}) {
+                MipGenerator::Settings settings;
+                settings.kernel = kernel;
+                settings.content = texture.content;
+                settings.threadCount = threadCount;
+
+                std::vector<MipGenerator::Level> levels;
+
+                const auto start = Clock::now();
+                MipGenerator::generate(size, size, texels.data(), settings, levels);
+                const float milliseconds = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+                LUG_LOG.info(
+                    "Application: {} ({}) {} levels with the {} kernel on {} threads in {:.1f} ms",
+                    texture.filename,
+                    MipGenerator::getName(texture.content),
+                    levels.size(),
+                    MipGenerator::getName(kernel),
+                    threadCount,
+                    milliseconds
+                );
+
+                if (kernel == MipGenerator::Settings{}.kernel && threadCount == hardwareThreadCount && milliseconds > budgetMilliseconds) {
+                    LUG_LOG.warn("Application: The mips of {} take more than {:.0f} ms", texture.filename, budgetMilliseconds);
+                }
 
-            node->setPosition({
-                6.0f,
-                0.0f,
-                0.0f
-            }, lug::Graphics::Node::TransformSpace::World);
+                if (hardwareThreadCount == 1) {
+                    break;
+                }
+            }
         }
     }
+}
 
-    // Set the position of the camera
-    {
-        _scene->getSceneNode("camera")->setPosition({0.0f, 0.0f, 15.0f}, lug::Graphics::Node::TransformSpace::World);
-        _scene->getSceneNode("camera")->getCamera()->lookAt({0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, lug::Graphics::Node::TransformSpace::World);
-    }
+void Application::updateTextureResidency(float elapsedSeconds) {
+    lug::Graphics::Renderer* renderer = _graphics.getRenderer();
 
-    // Attach 4 lights
-    const lug::Math::Vec3f lightPositions[] = {
-        lug::Math::Vec3f{-10.0f,  10.0f, 10.0f},
-        lug::Math::Vec3f{ 10.0f,  10.0f, 10.0f},
-        lug::Math::Vec3f{-10.0f, -10.0f, 10.0f},
-        lug::Math::Vec3f{ 10.0f, -10.0f, 10.0f},
-    };
+    const lug::Math::Vec3f& cameraPosition = _scene->getSceneNode("camera")->getAbsolutePosition();
+    const float viewportHeight = renderer->getWindow()->getRenderViews()[0]->getViewport().extent.height;
 
-    for (uint32_t i = 0; i < 4; ++i) {
-        lug::Graphics::Builder::Light lightBuilder(*renderer);
+    float spherePixels[5];
 
-        lightBuilder.setType(lug::Graphics::Render::Light::Type::Point);
-        lightBuilder.setColor({300.0f, 300.0f, 300.0f, 1.0f});
-        lightBuilder.setLinearAttenuation(0.0f);
+    for (uint32_t i = 0; i < 5; ++i) {
+        const lug::Math::Vec3f& position = _scene->getSceneNode("sphere" + std::to_string(i))->getAbsolutePosition();
 
-        lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Light> light = lightBuilder.build();
-        if (!light) {
-            LUG_LOG.error("Application: Can't create the point light {}", i);
-            return false;
-        }
-
-        lug::Graphics::Scene::Node* node = _scene->createSceneNode("light" + std::to_string(i));
-        _scene->getRoot().attachChild(*node);
+        const float x = position.x() - cameraPosition.x();
+        const float y = position.y() - cameraPosition.y();
+        const float z = position.z() - cameraPosition.z();
 
-        node->setPosition(lightPositions[i]);
-        node->attachLight(light);
+        spherePixels[i] = TextureResidency::getSpherePixels(1.0f, std::sqrt(x * x + y * y + z * z), lug::Math::Geometry::radians(45.0f), viewportHeight);
     }
 
-    return true;
-}
-
-bool Application::initSphereMesh() {
-    std::vector<lug::Math::Vec3f> positions;
-    std::vector<lug::Math::Vec3f> normals;
-    std::vector<lug::Math::Vec2f> uv;
-    std::vector<uint16_t> indices;
-
-    // Generate positions / normals / indices
-    {
-        const int X_SEGMENTS = 64;
-        const int Y_SEGMENTS = 64;
-        for (int y = 0; y <= Y_SEGMENTS; ++y) {
-            for (int x = 0; x <= X_SEGMENTS; ++x) {
-                float xSegment = (float)x / (float)X_SEGMENTS;
-                float ySegment = (float)y / (float)Y_SEGMENTS;
-                float xPos = std::cos(xSegment * 2.0f * lug::Math::pi<float>()) * std::sin(ySegment * lug::Math::pi<float>());
-                float yPos = std::cos(ySegment * lug::Math::pi<float>());
-                float zPos = std::sin(xSegment * 2.0f * lug::Math::pi<float>()) * std::sin(ySegment * lug::Math::pi<float>());
-
-                positions.push_back({xPos, yPos, zPos});
-                uv.push_back({xSegment, ySegment});
-                normals.push_back({xPos, yPos, zPos});
-            }
-        }
-
-        bool oddRow = false;
-        for (int y = 0; y < Y_SEGMENTS; ++y) {
-            if (!oddRow) { // even rows: y == 0, y == 2; and so on
-                for (int x = 0; x <= X_SEGMENTS; ++x) {
-                    indices.push_back(static_cast<uint16_t>((y + 1) * (X_SEGMENTS + 1) + x));
-                    indices.push_back(static_cast<uint16_t>(y       * (X_SEGMENTS + 1) + x));
-                }
-            } else {
-                for (int x = X_SEGMENTS; x >= 0; --x)
-                {
-                    indices.push_back(static_cast<uint16_t>(y       * (X_SEGMENTS + 1) + x));
-                    indices.push_back(static_cast<uint16_t>((y + 1) * (X_SEGMENTS + 1) + x));
-                }
-            }
-
-            oddRow = !oddRow;
-        }
+    // A texture needs the size of the closest sphere using it
+    for (uint32_t i = 0; i < 4; ++i) {
+        _textureResidency->request(_residentTextures[i], *std::max_element(spherePixels + i + 1, spherePixels + 5));
     }
 
-    // Build the mesh
-    {
-        lug::Graphics::Builder::Mesh meshBuilder(*_graphics.getRenderer());
-        meshBuilder.setName("sphere");
-
-        lug::Graphics::Builder::Mesh::PrimitiveSet* primitiveSet = meshBuilder.addPrimitiveSet();
-
-        primitiveSet->setMode(lug::Graphics::Render::Mesh::PrimitiveSet::Mode::TriangleStrip);
-
-        primitiveSet->addAttributeBuffer(
-            indices.data(),
-            sizeof(uint16_t),
-            static_cast<uint32_t>(indices.size()),
-            lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Indice
-        );
-
-        primitiveSet->addAttributeBuffer(
-            positions.data(),
-            sizeof(lug::Math::Vec3f),
-            static_cast<uint32_t>(positions.size()),
-            lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Position
-        );
-
-        primitiveSet->addAttributeBuffer(
-            normals.data(),
-            sizeof(lug::Math::Vec3f),
-            static_cast<uint32_t>(normals.size()),
-            lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Normal
-        );
-
-        primitiveSet->addAttributeBuffer(
-            uv.data(),
-            sizeof(lug::Math::Vec2f),
-            static_cast<uint32_t>(uv.size()),
-            lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::TexCoord
-        );
-
-        _sphereMesh = meshBuilder.build();
-
-        if (!_sphereMesh) {
-            LUG_LOG.error("Application: Can't create the sphere mesh");
-            return false;
-        }
-    }
+    _textureResidency->update(elapsedSeconds);
 
-    return true;
+    _perfOverlay.setCounter(_perfResidentBytesCounter, _textureResidency->getStats().residentBytes);
+    _perfOverlay.setCounter(_perfStreamedBytesCounter, _textureResidency->getStats().streamedBytes);
 }
 
-void Application::onEvent(const lug::Window::Event& event) {
-    if (event.type == lug::Window::Event::Type::Close) {
-        close();
+void Application::onClose() {
+    _textureCache.logStats();
+    _textureResidency->logStats();
+
+    if (_mipStreamer) {
+        _mipStreamer->logStats();
     }
 }
 
-void Application::onFrame(const lug::System::Time& elapsedTime) {
-    _mover.onFrame(elapsedTime);
+void Application::onSampleFrame(const lug::System::Time& elapsedTime) {
+    updateTextureResidency(elapsedTime.getSeconds<float>());
+
+    if (_mipStreamer) {
+        _mipStreamer->update();
+    }
 
     ImGui::Begin("Light");
     {
@@ -407,4 +344,16 @@ void Application::onFrame(const lug::System::Time& elapsedTime) {
         }
     }
     ImGui::End();
+
+    if (_perfOverlay.isVisible()) {
+        _textureResidency->draw();
+
+        if (_mipStreamer) {
+            _mipStreamer->draw();
+        }
+    }
+
+    if (_mipStreamer) {
+        _mipStreamer->endFrame();
+    }
 }
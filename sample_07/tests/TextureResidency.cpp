@@ -0,0 +1,135 @@
+#include <cstdio>
+
+#include "SampleTest.hpp"
+#include "TextureResidency.hpp"
+
+// Checks the levels TextureResidency streams in and evicts with a FakeAllocator, on the CPU.
+
+namespace {
+
+using SampleTest::check;
+
+constexpr uint64_t megabyte = 1024 * 1024;
+
+// The resident bytes are within the budget and are the ones the allocator backs
+bool checkBytes(const TextureResidency& residency, const TextureResidency::FakeAllocator& allocator, const char* name) {
+    const TextureResidency::Stats& stats = residency.getStats();
+
+    std::printf(
+        "%s: %llu / %llu bytes resident, %u evictions\n",
+        name,
+        static_cast<unsigned long long>(stats.residentBytes),
+        static_cast<unsigned long long>(residency.getBudget()),
+        stats.evictionCount
+    );
+
+    return check(stats.residentBytes <= residency.getBudget(), "the resident bytes exceed the budget")
+        && check(stats.residentBytes == allocator.getAllocatedBytes(), "the resident bytes are not the allocated ones");
+}
+
+// Two 2048x2048 textures, 16 MB for their finest level and 21.3 MB for all of them, with a budget for both
+bool testRequestedMips() {
+    TextureResidency::FakeAllocator allocator;
+    TextureResidency residency(allocator, 64 * megabyte, 64 * megabyte);
+
+    const uint32_t near = residency.addTexture("near", 2048, 2048, 4);
+    const uint32_t far = residency.addTexture("far", 2048, 2048, 4);
+
+    if (!check(near != TextureResidency::invalidTexture && far != TextureResidency::invalidTexture, "requested: can't add the textures")) {
+        return false;
+    }
+
+    // Only the tails, the levels of at most 128 texels from 4
+    bool success = check(residency.getResidentMip(near) == 4 && residency.getResidentMip(far) == 4, "requested: the tails are not resident");
+
+    residency.request(near, 2048.0f);
+    residency.request(far, 512.0f);
+    residency.update(1.0f / 60.0f);
+
+    success &= check(residency.getResidentMip(near) == 0, "requested: the near texture is not fully resident");
+    success &= check(residency.getResidentMip(far) == 2, "requested: the far texture is not resident from the level spanning 512 pixels");
+    success &= check(residency.getStats().evictionCount == 0, "requested: levels were evicted within the budget");
+
+    return checkBytes(residency, allocator, "requested") && success;
+}
+
+// The budget fits one of the two textures, the finest levels of the one not requested anymore are
+// evicted, as many as needed to make room
+bool testEviction() {
+    TextureResidency::FakeAllocator allocator;
+    TextureResidency residency(allocator, 24 * megabyte, 64 * megabyte);
+
+    const uint32_t first = residency.addTexture("first", 2048, 2048, 4);
+    const uint32_t second = residency.addTexture("second", 2048, 2048, 4);
+
+    residency.request(first, 2048.0f);
+    residency.update(1.0f / 60.0f);
+
+    bool success = check(residency.getResidentMip(first) == 0, "eviction: the first texture is not fully resident");
+
+    residency.request(second, 2048.0f);
+    residency.update(1.0f / 60.0f);
+
+    success &= check(residency.getResidentMip(second) == 0, "eviction: the second texture is not fully resident");
+    success &= check(residency.getResidentMip(first) == 2, "eviction: the levels 0 and 1 of the first texture are not evicted");
+    success &= check(residency.getStats().evictionCount == 2, "eviction: more levels than needed are evicted");
+
+    return checkBytes(residency, allocator, "eviction") && success;
+}
+
+// The budget fits the two textures from level 1, both requested at full size
+bool testBudgetLimited() {
+    TextureResidency::FakeAllocator allocator;
+    TextureResidency residency(allocator, 16 * megabyte, 64 * megabyte);
+
+    const uint32_t first = residency.addTexture("first", 2048, 2048, 4);
+    const uint32_t second = residency.addTexture("second", 2048, 2048, 4);
+
+    residency.request(first, 2048.0f);
+    residency.request(second, 2048.0f);
+    residency.update(1.0f / 60.0f);
+
+    bool success = check(residency.getResidentMip(first) == 1 && residency.getResidentMip(second) == 1, "budget: the textures are not resident from level 1");
+    success &= check(residency.getStats().evictionCount == 0, "budget: needed levels were evicted");
+    success &= check(residency.getStats().budgetLimitedCount == 2, "budget: the finest levels are not limited by the budget");
+
+    return checkBytes(residency, allocator, "budget") && success;
+}
+
+// 1 MB per update, the levels come in a few at a time, coarsest first
+bool testBandwidth() {
+    TextureResidency::FakeAllocator allocator;
+    TextureResidency residency(allocator, 64 * megabyte, 1 * megabyte);
+
+    const uint32_t texture = residency.addTexture("texture", 2048, 2048, 4);
+
+    bool success = true;
+
+    uint32_t updates = 0;
+    uint32_t residentMip = residency.getResidentMip(texture);
+
+    while (residentMip > 0 && updates < 10) {
+        residency.request(texture, 2048.0f);
+        residency.update(1.0f / 60.0f);
+        ++updates;
+
+        success &= check(residency.getResidentMip(texture) < residentMip, "bandwidth: no level was streamed in");
+        residentMip = residency.getResidentMip(texture);
+    }
+
+    // 256 KB for level 3, then 1, 4 and 16 MB streamed alone
+    success &= check(residentMip == 0 && updates == 4, "bandwidth: the texture is not resident after 4 updates");
+
+    return checkBytes(residency, allocator, "bandwidth") && success;
+}
+
+} // anonymous
+
+int main() {
+    return SampleTest::run({
+        {"requested mips", testRequestedMips},
+        {"eviction", testEviction},
+        {"budget limited", testBudgetLimited},
+        {"bandwidth", testBandwidth}
+    });
+}
@@ -1,10 +1,16 @@
 #pragma once
 
-#include <lug/Core/Application.hpp>
-#include <lug/Core/FreeMovement.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <lug/Graphics/Scene/Scene.hpp>
 
-class Application : public ::lug::Core::Application {
+#include "LightClusters.hpp"
+#include "LightDirtyTracker.hpp"
+#include "SampleApplication.hpp"
+
+class Application : public SampleApplication {
 public:
     Application();
 
@@ -18,10 +24,43 @@ public:
 
     bool init(int argc, char* argv[]);
 
-    void onEvent(const lug::Window::Event& event) override final;
-    void onFrame(const lug::System::Time& elapsedTime) override final;
+private:
+    void onSampleFrame(const lug::System::Time& elapsedTime) override final;
+
+    /**
+     * @brief      Bins 1k to 10k random lights and logs the timings, for --benchmark-light-clusters.
+     */
+    void benchmarkLightClusters();
+
+    /**
+     * @brief      Times the decoding of the Box textures and their conversions on each supported
+     *             path of PixelConvert, for --benchmark-texture-loading.
+     */
+    void benchmarkTextureLoading();
+
+    /**
+     * @brief      Bins the lights of the scene in the clusters of the first camera.
+     */
+    void updateLightClusters();
+
+    /**
+     * @brief      Refreshes the light blocks and computes the ranges of the light buffer to upload.
+     */
+    void updateLightBuffer();
 
 private:
     lug::Graphics::Resource::SharedPtr<lug::Graphics::Scene::Scene> _scene;
-    lug::Core::FreeMovement _mover;
+
+    // Resolved once, instead of looking up "light" + i by name every frame
+    std::vector<lug::Graphics::Scene::Node*> _lightNodes;
+    LightDirtyTracker _lightDirtyTracker;
+
+    std::unique_ptr<LightClusters> _lightClusters;
+    LightClusters::Lights _clusteredLights;
+    uint32_t _usedClusters{0};
+    uint32_t _maxLightsPerCluster{0};
+
+    uint32_t _perfLightClustersSection;
+    uint32_t _perfLightBufferSection;
+    uint32_t _perfLightBytesCounter;
 };
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <lug/Math/Vector.hpp>
+
+/**
+ * @brief      Assigns point and spot lights to the clusters (froxels) of a camera frustum.
+ *
+ *             The frustum is divided in screen tiles and exponential depth slices. Each light is
+ *             approximated by its bounding sphere in view space (looking down -Z), and the result
+ *             is stored as a compact list of light indices per cluster, the layout the fragment
+ *             shader would read.
+ */
+class LightClusters {
+public:
+    struct Dimensions {
+        uint32_t x{16};
+        uint32_t y{9};
+        uint32_t z{24};
+    };
+
+    struct Projection {
+        float fovY;         // In radians
+        float aspect;
+        float zNear;
+        float zFar;
+    };
+
+    /**
+     * @brief      Lights to bin, structure of arrays to keep the per light loops vectorizable.
+     */
+    struct Lights {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+        std::vector<float> radius;
+
+        void clear();
+        void add(const lug::Math::Vec3f& viewPosition, float radius);
+        size_t size() const;
+    };
+
+public:
+    LightClusters(const Dimensions& dimensions, const Projection& projection);
+
+    /**
+     * @brief      Bins the lights, the depth slices are split between the threads.
+     *
+     * @param[in]  lights       The lights, in view space.
+     * @param[in]  threadCount  The number of threads to use.
+     */
+    void assign(const Lights& lights, uint32_t threadCount);
+
+    uint32_t getClusterCount() const;
+
+    // Lights of the cluster i are lightIndices[offsets[i]] to lightIndices[offsets[i + 1]]
+    const std::vector<uint32_t>& getOffsets() const;
+    const std::vector<uint32_t>& getLightIndices() const;
+
+    /**
+     * @brief      Computes the distance at which the contribution of a point light falls below
+     *             the threshold.
+     */
+    static float computeLightRadius(float intensity, float constant, float linear, float quadratic, float threshold);
+
+private:
+    void assignSlices(const Lights& lights, uint32_t firstSlice, uint32_t lastSlice, std::vector<uint32_t>& counts, std::vector<uint32_t>& indices) const;
+
+private:
+    Dimensions _dimensions;
+    Projection _projection;
+
+    // Depth of the boundaries of the slices, _dimensions.z + 1 values
+    std::vector<float> _sliceDepths;
+
+    std::vector<uint32_t> _offsets;
+    std::vector<uint32_t> _lightIndices;
+};
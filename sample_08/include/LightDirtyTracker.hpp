@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <lug/Math/Vector.hpp>
+
+/**
+ * @brief      Keeps a shadow copy of the light blocks as laid out in the light buffer, and
+ *             computes the byte ranges that changed since the last frame.
+ *
+ *             Only the dirty ranges have to be copied to the GPU, and nothing on frames where no
+ *             light changed.
+ */
+class LightDirtyTracker {
+public:
+    /**
+     * @brief      Light as laid out in the buffer (std140 compatible).
+     */
+    struct Block {
+        lug::Math::Vec4f color;
+        lug::Math::Vec4f position;
+        lug::Math::Vec4f direction;
+        float constantAttenuation;
+        float linearAttenuation;
+        float quadraticAttenuation;
+        float falloffAngle;
+    };
+
+    struct Range {
+        size_t offset;
+        size_t size;
+    };
+
+public:
+    explicit LightDirtyTracker(uint32_t lightCount = 0);
+
+    /**
+     * @brief      Tracks lightCount lights, all dirty.
+     */
+    void reset(uint32_t lightCount);
+
+    /**
+     * @brief      Updates the block of a light, marking it dirty if its content changed.
+     */
+    void update(uint32_t index, const Block& block);
+
+    /**
+     * @brief      Ends the frame, returning the coalesced dirty ranges and clearing the dirty flags.
+     */
+    const std::vector<Range>& flush();
+
+    const std::vector<Block>& getBlocks() const;
+
+    size_t getBytesLastFrame() const;
+    size_t getTotalBytes() const;
+    uint32_t getFrameCount() const;
+    uint32_t getCleanFrameCount() const;
+
+private:
+    std::vector<Block> _blocks;
+    std::vector<bool> _dirty;
+    std::vector<Range> _ranges;
+
+    size_t _bytesLastFrame{0};
+    size_t _totalBytes{0};
+    uint32_t _frameCount{0};
+    uint32_t _cleanFrameCount{0};
+};
@@ -1,26 +1,39 @@
 #include "Application.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <thread>
+
 #include <imgui.h>
 
-#include <lug/Graphics/Builder/Camera.hpp>
 #include <lug/Graphics/Builder/Light.hpp>
-#include <lug/Graphics/Builder/Material.hpp>
-#include <lug/Graphics/Builder/Mesh.hpp>
 #include <lug/Graphics/Builder/Scene.hpp>
 #include <lug/Graphics/Builder/Texture.hpp>
 #include <lug/Graphics/Renderer.hpp>
 #include <lug/Graphics/Vulkan/Renderer.hpp>
 #include <lug/Math/Geometry/Trigonometry.hpp>
 
-Application::Application() : lug::Core::Application::Application{{"sample_08", {0, 1, 0}}} {
+#include "ImageFile.hpp"
+#include "PixelConvert.hpp"
+#include "SampleScene.hpp"
+#include "Trace.hpp"
+
+Application::Application() : SampleApplication{{"sample_08", {0, 1, 0}}} {
     getRenderWindowInfo().windowInitInfo.title = "Sample 08";
 }
 
 bool Application::init(int argc, char* argv[]) {
-    if (!lug::Core::Application::init(argc, argv)) {
+    if (!SampleApplication::init(argc, argv)) {
         return false;
     }
 
+    _perfLightClustersSection = _perfOverlay.addSection("light clusters");
+    _perfLightBufferSection = _perfOverlay.addSection("light buffer");
+    _perfLightBytesCounter = _perfOverlay.addCounter("light bytes");
+
     lug::Graphics::Renderer* renderer = _graphics.getRenderer();
 
     // Load scene
@@ -32,37 +45,38 @@ bool Application::init(int argc, char* argv[]) {
 
     _scene = lug::Graphics::Resource::SharedPtr<lug::Graphics::Scene::Scene>::cast(sceneResource);
 
-    // Attach cameras
-    {
-        lug::Graphics::Builder::Camera cameraBuilder(*renderer);
-
-        cameraBuilder.setFovY(45.0f);
-        cameraBuilder.setZNear(0.1f);
-        cameraBuilder.setZFar(100.0f);
-
-        lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Camera::Camera> camera = cameraBuilder.build();
-        if (!camera) {
-            LUG_LOG.error("Application: Can't create the camera");
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--benchmark-light-clusters") == 0) {
+            // Like --benchmark-logging, the sample doesn't run after the benchmark
+            benchmarkLightClusters();
+            return false;
+        } else if (std::strcmp(argv[i], "--benchmark-texture-loading") == 0) {
+            benchmarkTextureLoading();
             return false;
         }
+    }
 
-        lug::Graphics::Scene::Node* node = _scene->createSceneNode("camera");
-        _scene->getRoot().attachChild(*node);
-
-        node->attachCamera(camera);
-
-        // Attach a mover to the first camera
-        _mover.setTargetNode(*node);
-        _mover.setEventSource(*renderer->getWindow());
+    // Attach camera, moved by the mouse and the keyboard
+    {
+        lug::Graphics::Scene::Node* node = SampleScene::attachCamera(*renderer, *_scene, "camera", 0);
+        if (!node) {
+            return false;
+        }
 
-        // Attach camera to RenderView
-        {
-            auto& renderViews = _graphics.getRenderer()->getWindow()->getRenderViews();
+        setMovedCamera(*node);
 
-            LUG_ASSERT(renderViews.size() > 0, "There should be at least 1 render view");
+        // The clusters follow the projection of the camera
+        const auto& extent = renderer->getWindow()->getRenderViews()[0]->getViewport().extent;
 
-            renderViews[0]->attachCamera(camera);
-        }
+        _lightClusters = std::make_unique<LightClusters>(
+            LightClusters::Dimensions{},
+            LightClusters::Projection{
+                lug::Math::Geometry::radians(45.0f),
+                extent.width / extent.height,
+                0.1f,
+                100.0f
+            }
+        );
     }
 
     // Set the position of the camera
@@ -72,51 +86,314 @@ bool Application::init(int argc, char* argv[]) {
     }
 
     // Attach 4 lights
-    const lug::Math::Vec3f lightPositions[] = {
-        lug::Math::Vec3f{-10.0f,  10.0f, 10.0f},
-        lug::Math::Vec3f{ 10.0f,  10.0f, 10.0f},
-        lug::Math::Vec3f{-10.0f, -10.0f, 10.0f},
-        lug::Math::Vec3f{ 10.0f, -10.0f, 10.0f},
+    {
+        const lug::Math::Vec3f lightPositions[] = {
+            lug::Math::Vec3f{-10.0f,  10.0f, 10.0f},
+            lug::Math::Vec3f{ 10.0f,  10.0f, 10.0f},
+            lug::Math::Vec3f{-10.0f, -10.0f, 10.0f},
+            lug::Math::Vec3f{ 10.0f, -10.0f, 10.0f},
+        };
+
+        for (uint32_t i = 0; i < 4; ++i) {
+            lug::Graphics::Builder::Light lightBuilder(*renderer);
+
+            lightBuilder.setType(lug::Graphics::Render::Light::Type::Point);
+            lightBuilder.setColor({300.0f, 300.0f, 300.0f, 1.0f});
+            lightBuilder.setLinearAttenuation(0.0f);
+
+            lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Light> light = lightBuilder.build();
+            if (!light) {
+                LUG_LOG.error("Application: Can't create the point light {}", i);
+                return false;
+            }
+
+            lug::Graphics::Scene::Node* node = _scene->createSceneNode("light" + std::to_string(i));
+            _scene->getRoot().attachChild(*node);
+
+            node->setPosition(lightPositions[i]);
+            node->attachLight(light);
+
+            _lightNodes.push_back(node);
+        }
+
+        _lightDirtyTracker.reset(static_cast<uint32_t>(_lightNodes.size()));
+    }
+
+    return true;
+}
+
+void Application::benchmarkLightClusters() {
+    SAMPLE_TRACE_ZONE("benchmarkLightClusters");
+
+    const uint32_t lightCounts[] = {1000, 2000, 5000, 10000};
+    const uint32_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    constexpr uint32_t iterations = 20;
+
+    LightClusters clusters(LightClusters::Dimensions{}, LightClusters::Projection{lug::Math::Geometry::radians(45.0f), 16.0f / 9.0f, 0.1f, 100.0f});
+
+    // Fixed seed, the runs have to be comparable
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    for (uint32_t lightCount : lightCounts) {
+        LightClusters::Lights lights;
+
+        // Points and spots both are binned by their bounding sphere, in front of the camera
+        for (uint32_t i = 0; i < lightCount; ++i) {
+            const float depth = 0.1f + unit(generator) * 99.9f;
+            const float halfHeight = depth * std::tan(lug::Math::Geometry::radians(45.0f) / 2.0f);
+
+            lights.add(
+                {
+                    (unit(generator) * 2.0f - 1.0f) * halfHeight * 16.0f / 9.0f,
+                    (unit(generator) * 2.0f - 1.0f) * halfHeight,
+                    -depth
+                },
+                0.5f + unit(generator) * 4.5f
+            );
+        }
+
+        for (uint32_t threads : {1u, threadCount}) {
+            const auto start = std::chrono::high_resolution_clock::now();
+
+            for (uint32_t i = 0; i < iterations; ++i) {
+                clusters.assign(lights, threads);
+            }
+
+            const float milliseconds = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / iterations;
+
+            LUG_LOG.info("Application: Binned {} lights with {} thread(s) in {:.3f} ms ({} light references)", lightCount, threads, milliseconds, clusters.getLightIndices().size());
+
+            if (threads == threadCount) {
+                break;
+            }
+        }
+    }
+}
+
+void Application::benchmarkTextureLoading() {
+    SAMPLE_TRACE_ZONE("benchmarkTextureLoading");
+
+    // One texture of each format the Box model ships
+    const char* filenames[] = {
+        "models/Box/textures/brick.bmp",
+        "models/Box/textures/crate.jpg",
+        "models/Box/textures/grass.png",
+        "models/Box/textures/sand.tga"
     };
 
-    for (uint32_t i = 0; i < 4; ++i) {
-        lug::Graphics::Builder::Light lightBuilder(*renderer);
+    constexpr uint32_t iterations = 10;
 
-        lightBuilder.setType(lug::Graphics::Render::Light::Type::Point);
-        lightBuilder.setColor({300.0f, 300.0f, 300.0f, 1.0f});
-        lightBuilder.setLinearAttenuation(0.0f);
+    using Clock = std::chrono::high_resolution_clock;
 
-        lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Light> light = lightBuilder.build();
-        if (!light) {
-            LUG_LOG.error("Application: Can't create the point light {}", i);
-            return false;
+    const auto milliseconds = [](Clock::time_point start) {
+        return std::chrono::duration<float, std::milli>(Clock::now() - start).count() / iterations;
+    };
+
+    for (const char* filename : filenames) {
+        ImageFile::Image image;
+
+        const auto decodeStart = Clock::now();
+
+        for (uint32_t i = 0; i < iterations; ++i) {
+            if (!ImageFile::load(filename, image)) {
+                return;
+            }
+        }
+
+        const float decodeMilliseconds = milliseconds(decodeStart);
+
+        if (image.components != 3 && image.components != 4) {
+            LUG_LOG.warn("Application: {} has {} components, only RGB and RGBA are benchmarked", filename, image.components);
+            continue;
         }
 
-        lug::Graphics::Scene::Node* node = _scene->createSceneNode("light" + std::to_string(i));
-        _scene->getRoot().attachChild(*node);
+        const size_t pixelCount = size_t(image.width) * image.height;
+
+        std::vector<uint8_t> rgba(pixelCount * 4);
+        std::vector<float> linear(pixelCount * 4);
+        std::vector<float> mips[2] = {std::vector<float>(pixelCount * 4), std::vector<float>(pixelCount * 4)};
+
+        LUG_LOG.info("Application: {} ({}x{}, {} components) decoded in {:.3f} ms", filename, image.width, image.height, image.components, decodeMilliseconds);
+
+        float scalarMilliseconds = 0.0f;
 
-        node->setPosition(lightPositions[i]);
-        node->attachLight(light);
+        for (PixelConvert::Path path : {PixelConvert::Path::Scalar, PixelConvert::Path::Sse41, PixelConvert::Path::Avx2, PixelConvert::Path::Neon}) {
+            if (!PixelConvert::isSupported(path)) {
+                continue;
+            }
+
+            // RGB to RGBA
+            auto start = Clock::now();
+
+            for (uint32_t i = 0; i < iterations; ++i) {
+                if (image.components == 3) {
+                    PixelConvert::rgbToRgba(image.texels.data(), rgba.data(), pixelCount, path);
+                } else {
+                    std::memcpy(rgba.data(), image.texels.data(), rgba.size());
+                }
+            }
+
+            const float expandMilliseconds = milliseconds(start);
+
+            // sRGB to linear
+            start = Clock::now();
+
+            for (uint32_t i = 0; i < iterations; ++i) {
+                PixelConvert::decode(rgba.data(), linear.data(), pixelCount, true, path);
+            }
+
+            const float decodeLinearMilliseconds = milliseconds(start);
+
+            // The mip chain, each level encoded back to sRGB
+            start = Clock::now();
+
+            for (uint32_t i = 0; i < iterations; ++i) {
+                const float* level = linear.data();
+                uint32_t width = image.width;
+                uint32_t height = image.height;
+
+                while (width > 1 || height > 1) {
+                    float* next = level == mips[0].data() ? mips[1].data() : mips[0].data();
+
+                    PixelConvert::downsample(level, width, height, next, path);
+
+                    width = std::max(1u, width / 2);
+                    height = std::max(1u, height / 2);
+                    level = next;
+
+                    PixelConvert::encode(level, rgba.data(), size_t(width) * height, true, path);
+                }
+            }
+
+            const float mipsMilliseconds = milliseconds(start);
+
+            const float totalMilliseconds = expandMilliseconds + decodeLinearMilliseconds + mipsMilliseconds;
+
+            if (path == PixelConvert::Path::Scalar) {
+                scalarMilliseconds = totalMilliseconds;
+            }
+
+            LUG_LOG.info(
+                "Application:   {}: RGBA {:.3f} ms, to linear {:.3f} ms, mips {:.3f} ms, {:.3f} ms in total ({:.2f}x the scalar path)",
+                PixelConvert::getName(path),
+                expandMilliseconds,
+                decodeLinearMilliseconds,
+                mipsMilliseconds,
+                totalMilliseconds,
+                scalarMilliseconds / totalMilliseconds
+            );
+        }
     }
+}
 
-    return true;
+void Application::updateLightClusters() {
+    SAMPLE_TRACE_ZONE("updateLightClusters");
+
+    auto& renderViews = _graphics.getRenderer()->getWindow()->getRenderViews();
+
+    _usedClusters = 0;
+    _maxLightsPerCluster = 0;
+
+    if (!_lightClusters || renderViews.empty() || !renderViews[0]->getCamera()) {
+        return;
+    }
+
+    const lug::Math::Mat4x4f& view = renderViews[0]->getCamera()->getViewMatrix();
+
+    _clusteredLights.clear();
+
+    for (lug::Graphics::Scene::Node* node : _lightNodes) {
+        const auto& light = node->getLight();
+        const lug::Math::Vec3f& position = node->getAbsolutePosition();
+        const lug::Math::Vec4f& color = light->getColor();
+
+        const lug::Math::Vec3f viewPosition{
+            view(0, 0) * position.x() + view(0, 1) * position.y() + view(0, 2) * position.z() + view(0, 3),
+            view(1, 0) * position.x() + view(1, 1) * position.y() + view(1, 2) * position.z() + view(1, 3),
+            view(2, 0) * position.x() + view(2, 1) * position.y() + view(2, 2) * position.z() + view(2, 3)
+        };
+
+        const float radius = LightClusters::computeLightRadius(
+            std::max(color.r(), std::max(color.g(), color.b())),
+            light->getConstantAttenuation(),
+            light->getLinearAttenuation(),
+            light->getQuadraticAttenuation(),
+            0.01f
+        );
+
+        _clusteredLights.add(viewPosition, radius);
+    }
+
+    _lightClusters->assign(_clusteredLights, 1);
+
+    const std::vector<uint32_t>& offsets = _lightClusters->getOffsets();
+
+    for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+        const uint32_t count = offsets[i + 1] - offsets[i];
+
+        _usedClusters += count ? 1 : 0;
+        _maxLightsPerCluster = std::max(_maxLightsPerCluster, count);
+    }
 }
 
-void Application::onEvent(const lug::Window::Event& event) {
-    if (event.type == lug::Window::Event::Type::Close) {
-        close();
+void Application::updateLightBuffer() {
+    for (uint32_t i = 0; i < _lightNodes.size(); ++i) {
+        const auto& light = _lightNodes[i]->getLight();
+        const lug::Math::Vec3f& position = _lightNodes[i]->getAbsolutePosition();
+        const lug::Math::Vec3f& direction = light->getDirection();
+
+        LightDirtyTracker::Block block;
+
+        block.color = light->getColor();
+        block.position = {position.x(), position.y(), position.z(), 1.0f};
+        block.direction = {direction.x(), direction.y(), direction.z(), 0.0f};
+        block.constantAttenuation = light->getConstantAttenuation();
+        block.linearAttenuation = light->getLinearAttenuation();
+        block.quadraticAttenuation = light->getQuadraticAttenuation();
+        block.falloffAngle = light->getFalloffAngle();
+
+        _lightDirtyTracker.update(i, block);
     }
+
+    // These are the copies the renderer has to do into the light buffer
+    _lightDirtyTracker.flush();
 }
 
-void Application::onFrame(const lug::System::Time& elapsedTime) {
-    _mover.onFrame(elapsedTime);
+void Application::onSampleFrame(const lug::System::Time&) {
+    {
+        PerfOverlay::ScopedSection section(_perfOverlay, _perfLightClustersSection);
+        updateLightClusters();
+    }
+
+    {
+        PerfOverlay::ScopedSection section(_perfOverlay, _perfLightBufferSection);
+        updateLightBuffer();
+    }
+
+    _perfOverlay.setCounter(_perfLightBytesCounter, _lightDirtyTracker.getBytesLastFrame());
+
+    ImGui::Begin("Clusters");
+    {
+        ImGui::SetWindowSize({250, 120});
+        ImGui::SetWindowPos({10, 10});
+
+        if (_lightClusters) {
+            ImGui::Text("Used clusters: %u / %u", _usedClusters, _lightClusters->getClusterCount());
+            ImGui::Text("Max lights per cluster: %u", _maxLightsPerCluster);
+        }
+
+        ImGui::Text("Light upload: %zu B/frame", _lightDirtyTracker.getBytesLastFrame());
+        ImGui::Text("Clean frames: %u / %u", _lightDirtyTracker.getCleanFrameCount(), _lightDirtyTracker.getFrameCount());
+    }
+    ImGui::End();
 
     ImGui::Begin("Light");
     {
         ImGui::SetWindowSize({200, 100});
         ImGui::SetWindowPos({590, 490});
 
-        auto light = _scene->getSceneNode("light0")->getLight();
+        auto light = _lightNodes[0]->getLight();
 
         float r = light->getColor().r();
         ImGui::SliderFloat("red", &r, 0.0f, 600.0f);
@@ -128,8 +405,8 @@ void Application::onFrame(const lug::System::Time& elapsedTime) {
         ImGui::SliderFloat("blue", &b, 0.0f, 600.0f);
 
         if (r != light->getColor().r() || g != light->getColor().g() || b != light->getColor().b()) {
-            for (uint32_t i = 0; i < 4; ++i) {
-                _scene->getSceneNode("light" + std::to_string(i))->getLight()->setColor({r, g, b, 1.0f});
+            for (lug::Graphics::Scene::Node* node : _lightNodes) {
+                node->getLight()->setColor({r, g, b, 1.0f});
             }
         }
     }
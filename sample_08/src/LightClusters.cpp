@@ -0,0 +1,197 @@
+#include "LightClusters.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+#include "Trace.hpp"
+
+void LightClusters::Lights::clear() {
+    x.clear();
+    y.clear();
+    z.clear();
+    radius.clear();
+}
+
+void LightClusters::Lights::add(const lug::Math::Vec3f& viewPosition, float lightRadius) {
+    x.push_back(viewPosition.x());
+    y.push_back(viewPosition.y());
+    z.push_back(viewPosition.z());
+    radius.push_back(lightRadius);
+}
+
+size_t LightClusters::Lights::size() const {
+    return x.size();
+}
+
+LightClusters::LightClusters(const Dimensions& dimensions, const Projection& projection) : _dimensions(dimensions), _projection(projection) {
+    _sliceDepths.resize(_dimensions.z + 1);
+
+    for (uint32_t i = 0; i <= _dimensions.z; ++i) {
+        _sliceDepths[i] = _projection.zNear * std::pow(_projection.zFar / _projection.zNear, static_cast<float>(i) / static_cast<float>(_dimensions.z));
+    }
+}
+
+void LightClusters::assign(const Lights& lights, uint32_t threadCount) {
+    threadCount = std::max(1u, std::min(threadCount, _dimensions.z));
+
+    std::vector<std::vector<uint32_t>> counts(threadCount);
+    std::vector<std::vector<uint32_t>> indices(threadCount);
+    std::vector<std::thread> threads;
+
+    const auto sliceRange = [this, threadCount](uint32_t thread) {
+        return std::make_pair(_dimensions.z * thread / threadCount, _dimensions.z * (thread + 1) / threadCount);
+    };
+
+    for (uint32_t thread = 1; thread < threadCount; ++thread) {
+        threads.emplace_back([this, &lights, &counts, &indices, &sliceRange, thread]() {
+            SAMPLE_TRACE_THREAD_NAME("light clusters worker");
+
+            const auto range = sliceRange(thread);
+            assignSlices(lights, range.first, range.second, counts[thread], indices[thread]);
+        });
+    }
+
+    {
+        const auto range = sliceRange(0);
+        assignSlices(lights, range.first, range.second, counts[0], indices[0]);
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // The slices of the threads are contiguous, concatenate their lists
+    _offsets.resize(1);
+    _offsets[0] = 0;
+    _lightIndices.clear();
+
+    for (uint32_t thread = 0; thread < threadCount; ++thread) {
+        for (uint32_t count : counts[thread]) {
+            _offsets.push_back(_offsets.back() + count);
+        }
+
+        _lightIndices.insert(_lightIndices.end(), indices[thread].begin(), indices[thread].end());
+    }
+}
+
+uint32_t LightClusters::getClusterCount() const {
+    return _dimensions.x * _dimensions.y * _dimensions.z;
+}
+
+const std::vector<uint32_t>& LightClusters::getOffsets() const {
+    return _offsets;
+}
+
+const std::vector<uint32_t>& LightClusters::getLightIndices() const {
+    return _lightIndices;
+}
+
+float LightClusters::computeLightRadius(float intensity, float constant, float linear, float quadratic, float threshold) {
+    // Solve intensity / (constant + linear * d + quadratic * d^2) = threshold
+    const float c = constant - intensity / threshold;
+
+    // Below the threshold even at the light, the quadratic would have no positive root
+    if (c >= 0.0f) {
+        return 0.0f;
+    }
+
+    if (quadratic > 0.0f) {
+        return (-linear + std::sqrt(linear * linear - 4.0f * quadratic * c)) / (2.0f * quadratic);
+    }
+
+    if (linear > 0.0f) {
+        return std::max(0.0f, -c / linear);
+    }
+
+    // No attenuation, the light reaches everything
+    return std::numeric_limits<float>::max();
+}
+
+void LightClusters::assignSlices(const Lights& lights, uint32_t firstSlice, uint32_t lastSlice, std::vector<uint32_t>& counts, std::vector<uint32_t>& indices) const {
+    SAMPLE_TRACE_ZONE("assignSlices");
+
+    const uint32_t tilesPerSlice = _dimensions.x * _dimensions.y;
+    const size_t lightCount = lights.size();
+
+    const float tanHalfFovY = std::tan(_projection.fovY / 2.0f);
+    const float tanHalfFovX = tanHalfFovY * _projection.aspect;
+
+    counts.assign((lastSlice - firstSlice) * tilesPerSlice, 0);
+    indices.clear();
+
+    // Per slice, the lights overlapping it, then the tiles they cover
+    std::vector<uint8_t> sliceMask(lightCount);
+    std::vector<uint32_t> sliceLights;
+    std::vector<std::vector<uint32_t>> tileLights(tilesPerSlice);
+
+    sliceLights.reserve(lightCount);
+
+    uint8_t* mask = sliceMask.data();
+
+    const float* lightX = lights.x.data();
+    const float* lightY = lights.y.data();
+    const float* lightZ = lights.z.data();
+    const float* lightRadius = lights.radius.data();
+
+    for (uint32_t slice = firstSlice; slice < lastSlice; ++slice) {
+        const float sliceNear = _sliceDepths[slice];
+        const float sliceFar = _sliceDepths[slice + 1];
+
+        // Branch free over the arrays of the lights so the compiler can vectorize it, the
+        // overlapping lights are compacted afterwards
+        for (size_t i = 0; i < lightCount; ++i) {
+            const float depth = -lightZ[i];
+
+            mask[i] = static_cast<uint8_t>((depth + lightRadius[i] >= sliceNear) & (depth - lightRadius[i] <= sliceFar));
+        }
+
+        sliceLights.clear();
+
+        for (size_t i = 0; i < lightCount; ++i) {
+            if (mask[i]) {
+                sliceLights.push_back(static_cast<uint32_t>(i));
+            }
+        }
+
+        for (std::vector<uint32_t>& lightsOfTile : tileLights) {
+            lightsOfTile.clear();
+        }
+
+        for (uint32_t i : sliceLights) {
+            const float depth = -lightZ[i];
+            const float radius = lightRadius[i];
+
+            // Conservative bounds of the sphere clamped to the slice, in tangent space
+            const float minDepth = std::max(sliceNear, depth - radius);
+            const float maxDepth = std::min(sliceFar, depth + radius);
+
+            const float minX = std::min((lightX[i] - radius) / minDepth, (lightX[i] - radius) / maxDepth);
+            const float maxX = std::max((lightX[i] + radius) / minDepth, (lightX[i] + radius) / maxDepth);
+            const float minY = std::min((lightY[i] - radius) / minDepth, (lightY[i] - radius) / maxDepth);
+            const float maxY = std::max((lightY[i] + radius) / minDepth, (lightY[i] + radius) / maxDepth);
+
+            const auto tile = [](float value, float tanHalfFov, uint32_t count) {
+                const float normalized = (value / tanHalfFov + 1.0f) * 0.5f * static_cast<float>(count);
+                return static_cast<int32_t>(std::floor(std::max(-1.0f, std::min(normalized, static_cast<float>(count)))));
+            };
+
+            const int32_t firstX = std::max(0, tile(minX, tanHalfFovX, _dimensions.x));
+            const int32_t lastX = std::min(static_cast<int32_t>(_dimensions.x) - 1, tile(maxX, tanHalfFovX, _dimensions.x));
+            const int32_t firstY = std::max(0, tile(minY, tanHalfFovY, _dimensions.y));
+            const int32_t lastY = std::min(static_cast<int32_t>(_dimensions.y) - 1, tile(maxY, tanHalfFovY, _dimensions.y));
+
+            for (int32_t y = firstY; y <= lastY; ++y) {
+                for (int32_t x = firstX; x <= lastX; ++x) {
+                    tileLights[y * _dimensions.x + x].push_back(i);
+                }
+            }
+        }
+
+        for (uint32_t t = 0; t < tilesPerSlice; ++t) {
+            counts[(slice - firstSlice) * tilesPerSlice + t] = static_cast<uint32_t>(tileLights[t].size());
+            indices.insert(indices.end(), tileLights[t].begin(), tileLights[t].end());
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#include "LightDirtyTracker.hpp"
+
+#include <cassert>
+#include <cstring>
+
+// Everything has to be uploaded the first time
+LightDirtyTracker::LightDirtyTracker(uint32_t lightCount) : _blocks(lightCount), _dirty(lightCount, true) {}
+
+void LightDirtyTracker::reset(uint32_t lightCount) {
+    _blocks.assign(lightCount, Block{});
+    _dirty.assign(lightCount, true);
+}
+
+void LightDirtyTracker::update(uint32_t index, const Block& block) {
+    assert(index < _blocks.size() && "LightDirtyTracker: light index out of range, reset() with the light count");
+
+    if (std::memcmp(&_blocks[index], &block, sizeof(Block)) == 0) {
+        return;
+    }
+
+    _blocks[index] = block;
+    _dirty[index] = true;
+}
+
+const std::vector<LightDirtyTracker::Range>& LightDirtyTracker::flush() {
+    _ranges.clear();
+    _bytesLastFrame = 0;
+
+    for (size_t i = 0; i < _dirty.size(); ++i) {
+        if (!_dirty[i]) {
+            continue;
+        }
+
+        _dirty[i] = false;
+
+        // Merge with the previous range if the lights are adjacent
+        if (!_ranges.empty() && _ranges.back().offset + _ranges.back().size == i * sizeof(Block)) {
+            _ranges.back().size += sizeof(Block);
+        } else {
+            _ranges.push_back({i * sizeof(Block), sizeof(Block)});
+        }
+
+        _bytesLastFrame += sizeof(Block);
+    }
+
+    _totalBytes += _bytesLastFrame;
+    ++_frameCount;
+
+    if (_ranges.empty()) {
+        ++_cleanFrameCount;
+    }
+
+    return _ranges;
+}
+
+const std::vector<LightDirtyTracker::Block>& LightDirtyTracker::getBlocks() const {
+    return _blocks;
+}
+
+size_t LightDirtyTracker::getBytesLastFrame() const {
+    return _bytesLastFrame;
+}
+
+size_t LightDirtyTracker::getTotalBytes() const {
+    return _totalBytes;
+}
+
+uint32_t LightDirtyTracker::getFrameCount() const {
+    return _frameCount;
+}
+
+uint32_t LightDirtyTracker::getCleanFrameCount() const {
+    return _cleanFrameCount;
+}
@@ -1,10 +1,13 @@
 #pragma once
 
-#include <lug/Core/Application.hpp>
-#include <lug/Core/FreeMovement.hpp>
+#include <string>
+
 #include <lug/Graphics/Scene/Scene.hpp>
 
-class Application : public ::lug::Core::Application {
+#include "EnvironmentPrefilter.hpp"
+#include "SampleApplication.hpp"
+
+class Application : public SampleApplication {
 public:
     Application();
 
@@ -18,10 +21,27 @@ public:
 
     bool init(int argc, char* argv[]);
 
-    void onEvent(const lug::Window::Event& event) override final;
-    void onFrame(const lug::System::Time& elapsedTime) override final;
+private:
+    void onSampleFrame(const lug::System::Time& elapsedTime) override final;
+
+    /**
+     * @brief      Compresses the helmet textures with each quality preset of BlockCompress, on one
+     *             and on all the threads, and logs the timings, the PSNR and the memory saved, for
+     *             --benchmark-block-compression.
+     */
+    void benchmarkBlockCompression();
+
+    /**
+     * @brief      Loads the image based lighting of the skyBox from the cache, or prefilters it, and
+     *             checks and logs it. The renderer doesn't take it, the sample only times the prefilter.
+     */
+    void initEnvironment(const std::string (&faceFilenames)[6]);
+
+    /**
+     * @brief      Logs the sizes and the average irradiance of a valid environment.
+     */
+    static void logEnvironment(const EnvironmentPrefilter::Environment& environment);
 
 private:
     lug::Graphics::Resource::SharedPtr<lug::Graphics::Scene::Scene> _scene;
-    lug::Core::FreeMovement _mover;
 };
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "EnvironmentPrefilter.hpp"
+
+/**
+ * @brief      Disk cache of the prefiltered environments.
+ *
+ *             Entries are keyed by a hash of the content of the face files and of the prefilter
+ *             settings, so changing an image or a setting produces a new entry.
+ */
+class EnvironmentCache {
+public:
+    explicit EnvironmentCache(const std::string& directory);
+
+    EnvironmentCache(const EnvironmentCache&) = delete;
+    EnvironmentCache(EnvironmentCache&&) = delete;
+
+    EnvironmentCache& operator=(const EnvironmentCache&) = delete;
+    EnvironmentCache& operator=(EnvironmentCache&&) = delete;
+
+    ~EnvironmentCache() = default;
+
+    /**
+     * @brief      Computes the key of the faces and settings.
+     *
+     * @return     false if a face file can't be read.
+     */
+    static bool computeKey(const std::string (&filenames)[6], const EnvironmentPrefilter::Settings& settings, uint64_t& key);
+
+    bool load(uint64_t key, EnvironmentPrefilter::Environment& environment) const;
+    bool store(uint64_t key, const EnvironmentPrefilter::Environment& environment) const;
+
+private:
+    std::string getPath(uint64_t key) const;
+
+private:
+    std::string _directory;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief      CPU prefilter producing the image based lighting set of a cubemap environment.
+ *
+ *             Faces are in the order of lug::Graphics::Builder::SkyBox::Face (+X, -X, +Y, -Y,
+ *             +Z, -Z) and texels are linear RGB floats.
+ */
+namespace EnvironmentPrefilter {
+
+struct Cubemap {
+    uint32_t size{0};
+    std::vector<float> faces[6];
+};
+
+struct Settings {
+    uint32_t irradianceSize{32};
+    uint32_t specularSize{128};
+    uint32_t specularMipCount{6};
+    uint32_t specularSampleCount{128};
+    uint32_t brdfLutSize{128};
+    uint32_t brdfLutSampleCount{512};
+    uint32_t threadCount{1};
+};
+
+struct Environment {
+    // Irradiance divided by pi, the diffuse term is albedo * irradiance
+    Cubemap irradiance;
+
+    // GGX prefiltered radiance, the roughness of mip i is i / (mips - 1)
+    std::vector<Cubemap> specular;
+
+    // Scale and bias of F0 in the split sum, indexed by NdotV (x) and roughness (y)
+    uint32_t brdfLutSize{0};
+    std::vector<float> brdfLut;
+};
+
+/**
+ * @brief      Loads the six faces of a cubemap. The faces must be square and of the same size.
+ */
+bool loadFaces(const std::string (&filenames)[6], Cubemap& cubemap);
+
+/**
+ * @brief      Computes the irradiance map, the specular mip chain and the BRDF LUT.
+ */
+void prefilter(const Cubemap& source, const Settings& settings, Environment& environment);
+
+/**
+ * @brief      Checks that an environment has the sizes given by the settings and only finite,
+ *             positive values, as computed by prefilter.
+ */
+bool validate(const Settings& settings, const Environment& environment);
+
+} // EnvironmentPrefilter
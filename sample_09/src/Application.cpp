@@ -1,11 +1,13 @@
 #include "Application.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
 #include <imgui.h>
 
-#include <lug/Graphics/Builder/Camera.hpp>
-#include <lug/Graphics/Builder/Light.hpp>
-#include <lug/Graphics/Builder/Material.hpp>
-#include <lug/Graphics/Builder/Mesh.hpp>
 #include <lug/Graphics/Builder/Scene.hpp>
 #include <lug/Graphics/Builder/SkyBox.hpp>
 #include <lug/Graphics/Builder/Texture.hpp>
@@ -13,15 +15,39 @@
 #include <lug/Graphics/Vulkan/Renderer.hpp>
 #include <lug/Math/Geometry/Trigonometry.hpp>
 
-Application::Application() : lug::Core::Application::Application{{"sample_09", {0, 1, 0}}} {
+#include "BlockCompress.hpp"
+#include "EnvironmentCache.hpp"
+#include "ImageFile.hpp"
+#include "ResourceFileSystem.hpp"
+#include "SampleScene.hpp"
+#include "Trace.hpp"
+
+Application::Application() : SampleApplication{{"sample_09", {0, 1, 0}}} {
     getRenderWindowInfo().windowInitInfo.title = "Sample 09";
 }
 
 bool Application::init(int argc, char* argv[]) {
-    if (!lug::Core::Application::init(argc, argv)) {
+    if (!SampleApplication::init(argc, argv)) {
         return false;
     }
 
+    bool mountArchive = true;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--benchmark-block-compression") == 0) {
+            // Like --benchmark-logging, the sample doesn't run after the benchmark
+            benchmarkBlockCompression();
+            return false;
+        } else if (std::strcmp(argv[i], "--no-archive") == 0) {
+            mountArchive = false;
+        }
+    }
+
+    // The files the sample reads itself are packed at build time, --no-archive reads the loose ones
+    if (mountArchive && !ResourceFileSystem::mount("resources.luga")) {
+        LUG_LOG.warn("Application: Can't mount the resource archive, the resources are read from the files");
+    }
+
     lug::Graphics::Renderer* renderer = _graphics.getRenderer();
 
     // Load scene
@@ -33,49 +59,36 @@ bool Application::init(int argc, char* argv[]) {
 
     _scene = lug::Graphics::Resource::SharedPtr<lug::Graphics::Scene::Scene>::cast(sceneResource);
 
-    // Attach cameras
+    // Attach camera, moved by the mouse and the keyboard
     {
-        lug::Graphics::Builder::Camera cameraBuilder(*renderer);
-
-        cameraBuilder.setFovY(45.0f);
-        cameraBuilder.setZNear(0.1f);
-        cameraBuilder.setZFar(100.0f);
-
-        lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Camera::Camera> camera = cameraBuilder.build();
-        if (!camera) {
-            LUG_LOG.error("Application: Can't create the camera");
+        lug::Graphics::Scene::Node* node = SampleScene::attachCamera(*renderer, *_scene, "camera", 0);
+        if (!node) {
             return false;
         }
 
-        lug::Graphics::Scene::Node* node = _scene->createSceneNode("camera");
-        _scene->getRoot().attachChild(*node);
-
-        node->attachCamera(camera);
-
-        // Attach a mover to the first camera
-        _mover.setTargetNode(*node);
-        _mover.setEventSource(*renderer->getWindow());
-
-        // Attach camera to RenderView
-        {
-            auto& renderViews = _graphics.getRenderer()->getWindow()->getRenderViews();
-
-            LUG_ASSERT(renderViews.size() > 0, "There should be at least 1 render view");
-
-            renderViews[0]->attachCamera(camera);
-        }
+        setMovedCamera(*node);
     }
 
     // Attach skyBox
     {
+        // In the order of lug::Graphics::Builder::SkyBox::Face
+        const std::string faceFilenames[6] = {
+            "textures/skybox/right.jpg",
+            "textures/skybox/left.jpg",
+            "textures/skybox/top.jpg",
+            "textures/skybox/bottom.jpg",
+            "textures/skybox/back.jpg",
+            "textures/skybox/front.jpg"
+        };
+
         lug::Graphics::Builder::SkyBox skyBoxBuilder(*renderer);
 
-        skyBoxBuilder.setFaceFilename(lug::Graphics::Builder::SkyBox::Face::PositiveX, "textures/skybox/right.jpg");
-        skyBoxBuilder.setFaceFilename(lug::Graphics::Builder::SkyBox::Face::NegativeX, "textures/skybox/left.jpg");
-        skyBoxBuilder.setFaceFilename(lug::Graphics::Builder::SkyBox::Face::PositiveY, "textures/skybox/top.jpg");
-        skyBoxBuilder.setFaceFilename(lug::Graphics::Builder::SkyBox::Face::NegativeY, "textures/skybox/bottom.jpg");
-        skyBoxBuilder.setFaceFilename(lug::Graphics::Builder::SkyBox::Face::PositiveZ, "textures/skybox/back.jpg");
-        skyBoxBuilder.setFaceFilename(lug::Graphics::Builder::SkyBox::Face::NegativeZ, "textures/skybox/front.jpg");
+        skyBoxBuilder.setFaceFilename(lug::Graphics::Builder::SkyBox::Face::PositiveX, faceFilenames[0]);
+        skyBoxBuilder.setFaceFilename(lug::Graphics::Builder::SkyBox::Face::NegativeX, faceFilenames[1]);
+        skyBoxBuilder.setFaceFilename(lug::Graphics::Builder::SkyBox::Face::PositiveY, faceFilenames[2]);
+        skyBoxBuilder.setFaceFilename(lug::Graphics::Builder::SkyBox::Face::NegativeY, faceFilenames[3]);
+        skyBoxBuilder.setFaceFilename(lug::Graphics::Builder::SkyBox::Face::PositiveZ, faceFilenames[4]);
+        skyBoxBuilder.setFaceFilename(lug::Graphics::Builder::SkyBox::Face::NegativeZ, faceFilenames[5]);
 
         lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::SkyBox> skyBox = skyBoxBuilder.build();
         if (!skyBox) {
@@ -84,6 +97,25 @@ bool Application::init(int argc, char* argv[]) {
         }
 
         _scene->setSkyBox(skyBox);
+
+        bool prefilterEnvironment = true;
+
+        for (int i = 1; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--no-environment-prefilter") == 0) {
+                prefilterEnvironment = false;
+            }
+        }
+
+        if (prefilterEnvironment) {
+            initEnvironment(faceFilenames);
+
+            const ResourceFileSystem::Stats& stats = ResourceFileSystem::getStats();
+
+            LUG_LOG.info(
+                "Application: {} resource reads ({} from the archive, {} files opened), {} bytes in {:.2f} ms",
+                stats.readCount, stats.archiveReadCount, stats.fileOpenCount, stats.bytes, stats.milliseconds
+            );
+        }
     }
 
     // Set the position of the camera
@@ -93,45 +125,180 @@ bool Application::init(int argc, char* argv[]) {
     }
 
     // Attach 4 lights
-    const lug::Math::Vec3f lightPositions[] = {
-        lug::Math::Vec3f{-10.0f,  10.0f, 10.0f},
-        lug::Math::Vec3f{ 10.0f,  10.0f, 10.0f},
-        lug::Math::Vec3f{-10.0f, -10.0f, 10.0f},
-        lug::Math::Vec3f{ 10.0f, -10.0f, 10.0f},
+    if (!SampleScene::attachPointLights(*renderer, *_scene)) {
+        return false;
+    }
+
+    return true;
+}
+
+void Application::benchmarkBlockCompression() {
+    SAMPLE_TRACE_ZONE("benchmarkBlockCompression");
+
+    const struct {
+        const char* filename;
+        bool normalMap;
+    } textures[] = {
+        {"models/DamagedHelmet/textures/Default_albedo.jpg", false},
+        {"models/DamagedHelmet/textures/Default_normal.jpg", true},
+        {"models/DamagedHelmet/textures/Default_metallic_roughness.jpg", false},
+        {"models/DamagedHelmet/textures/Default_emissive.jpg", false},
+        {"models/DamagedHelmet/textures/Default_AO.jpg", false}
     };
 
-    for (uint32_t i = 0; i < 4; ++i) {
-        lug::Graphics::Builder::Light lightBuilder(*renderer);
+    constexpr float bytesPerMegabyte = 1024.0f * 1024.0f;
 
-        lightBuilder.setType(lug::Graphics::Render::Light::Type::Point);
-        lightBuilder.setColor({300.0f, 300.0f, 300.0f, 1.0f});
-        lightBuilder.setLinearAttenuation(0.0f);
+    const uint32_t hardwareThreadCount = std::max(1u, std::thread::hardware_concurrency());
 
-        lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Light> light = lightBuilder.build();
-        if (!light) {
-            LUG_LOG.error("Application: Can't create the point light {}", i);
-            return false;
-        }
+    using Clock = std::chrono::high_resolution_clock;
+
+    uint64_t totalUncompressedBytes = 0;
+    uint64_t totalCompressedBytes = 0;
+
+    for (const auto& texture : textures) {
+        ImageFile::Image image;
 
-        lug::Graphics::Scene::Node* node = _scene->createSceneNode("light" + std::to_string(i));
-        _scene->getRoot().attachChild(*node);
+        if (!ImageFile::load(texture.filename, image, 4)) {
+            return;
+        }
 
-        node->setPosition(lightPositions[i]);
-        node->attachLight(light);
+        BlockCompress::Settings settings;
+        settings.format = BlockCompress::selectFormat(image.texels.data(), size_t(image.width) * image.height, texture.normalMap);
+
+        const uint64_t uncompressedBytes = image.texels.size();
+        const uint64_t compressedBytes = BlockCompress::getSize(settings.format, image.width, image.height);
+
+        LUG_LOG.info(
+            "Application: {} ({}x{}) in {}, {:.1f} MB instead of {:.1f} MB",
+            texture.filename,
+            image.width,
+            image.height,
+            BlockCompress::getName(settings.format),
+            compressedBytes / bytesPerMegabyte,
+            uncompressedBytes / bytesPerMegabyte
+        );
+
+        totalUncompressedBytes += uncompressedBytes;
+        totalCompressedBytes += compressedBytes;
+
+        for (BlockCompress::Quality quality : {BlockCompress::Quality::Fast, BlockCompress::Quality::Normal, BlockCompress::Quality::High}) {
+            for (uint32_t threadCount : {1u, hardwareThreadCount}) {
+                settings.quality = quality;
+                settings.threadCount = threadCount;
+
+                std::vector<uint8_t> data;
+
+                const auto start = Clock::now();
+                BlockCompress::encode(image.width, image.height, image.texels.data(), settings, data);
+                const float milliseconds = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+
+                LUG_LOG.info(
+                    "Application:     {} quality on {} threads in {:.1f} ms, PSNR {:.2f} dB",
+                    BlockCompress::getName(quality),
+                    threadCount,
+                    milliseconds,
+                    BlockCompress::computePsnr(settings.format, image.width, image.height, image.texels.data(), data.data())
+                );
+
+                if (hardwareThreadCount == 1) {
+                    break;
+                }
+            }
+        }
     }
 
-    return true;
+    LUG_LOG.info(
+        "Application: The helmet textures take {:.1f} MB compressed instead of {:.1f} MB, without their mips",
+        totalCompressedBytes / bytesPerMegabyte,
+        totalUncompressedBytes / bytesPerMegabyte
+    );
 }
 
-void Application::onEvent(const lug::Window::Event& event) {
-    if (event.type == lug::Window::Event::Type::Close) {
-        close();
+void Application::initEnvironment(const std::string (&faceFilenames)[6]) {
+    SAMPLE_TRACE_ZONE("initEnvironment");
+
+    EnvironmentPrefilter::Settings settings;
+    settings.threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    EnvironmentCache cache("cache");
+    uint64_t key;
+
+    // The environment is optional, the sample runs without it
+    if (!EnvironmentCache::computeKey(faceFilenames, settings, key)) {
+        LUG_LOG.warn("Application: Can't read the skyBox faces, the environment is not prefiltered");
+        return;
+    }
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    EnvironmentPrefilter::Environment environment;
+
+    if (cache.load(key, environment)) {
+        if (EnvironmentPrefilter::validate(settings, environment)) {
+            LUG_LOG.info("Application: Environment loaded from the cache in {:.2f} ms", std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count());
+            logEnvironment(environment);
+            return;
+        }
+
+        LUG_LOG.warn("Application: The cached environment is invalid, it is prefiltered again");
+    }
+
+    EnvironmentPrefilter::Cubemap source;
+    if (!EnvironmentPrefilter::loadFaces(faceFilenames, source)) {
+        return;
+    }
+
+    EnvironmentPrefilter::prefilter(source, settings, environment);
+
+    LUG_LOG.info(
+        "Application: Environment prefiltered with {} thread(s) in {:.2f} ms",
+        settings.threadCount,
+        std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count()
+    );
+
+    // Don't cache a broken environment, it would be loaded again on the next runs
+    if (!EnvironmentPrefilter::validate(settings, environment)) {
+        return;
+    }
+
+    logEnvironment(environment);
+
+    if (!cache.store(key, environment)) {
+        LUG_LOG.warn("Application: Can't store the environment in the cache");
     }
 }
 
-void Application::onFrame(const lug::System::Time& elapsedTime) {
-    _mover.onFrame(elapsedTime);
+void Application::logEnvironment(const EnvironmentPrefilter::Environment& environment) {
+    // The average irradiance of the faces, the ambient light the environment gives
+    double irradiance[3] = {};
+    size_t texelCount = 0;
+
+    for (const std::vector<float>& face : environment.irradiance.faces) {
+        for (size_t i = 0; i < face.size(); i += 3) {
+            irradiance[0] += face[i];
+            irradiance[1] += face[i + 1];
+            irradiance[2] += face[i + 2];
+        }
+
+        texelCount += face.size() / 3;
+    }
+
+    LUG_LOG.info(
+        "Application: Environment of {}x{} irradiance faces averaging ({:.3f}, {:.3f}, {:.3f}), {} specular mips from {}x{} and a {}x{} BRDF LUT",
+        environment.irradiance.size,
+        environment.irradiance.size,
+        irradiance[0] / texelCount,
+        irradiance[1] / texelCount,
+        irradiance[2] / texelCount,
+        environment.specular.size(),
+        environment.specular[0].size,
+        environment.specular[0].size,
+        environment.brdfLutSize,
+        environment.brdfLutSize
+    );
+}
 
+void Application::onSampleFrame(const lug::System::Time&) {
     ImGui::Begin("Light");
     {
         ImGui::SetWindowSize({200, 100});
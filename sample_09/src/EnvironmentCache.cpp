@@ -0,0 +1,186 @@
+#include "EnvironmentCache.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include <lug/Config.hpp>
+
+#if defined(LUG_SYSTEM_WINDOWS)
+    #define NOMINMAX
+    #define WIN32_LEAN_AND_MEAN
+    #include <direct.h>
+    #include <windows.h>
+#else
+    #include <sys/stat.h>
+#endif
+
+#include "ResourceFileSystem.hpp"
+
+namespace {
+
+constexpr char magic[4] = {'L', 'U', 'G', 'E'};
+constexpr uint32_t version = 1;
+
+uint64_t hash(const void* data, size_t size, uint64_t seed) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+
+    for (size_t i = 0; i < size; ++i) {
+        seed ^= bytes[i];
+        seed *= 1099511628211ull;
+    }
+
+    return seed;
+}
+
+void writeCubemap(std::ofstream& file, const EnvironmentPrefilter::Cubemap& cubemap) {
+    file.write(reinterpret_cast<const char*>(&cubemap.size), sizeof(cubemap.size));
+
+    for (const std::vector<float>& face : cubemap.faces) {
+        file.write(reinterpret_cast<const char*>(face.data()), face.size() * sizeof(float));
+    }
+}
+
+bool readCubemap(std::ifstream& file, EnvironmentPrefilter::Cubemap& cubemap) {
+    if (!file.read(reinterpret_cast<char*>(&cubemap.size), sizeof(cubemap.size)) || cubemap.size > 16384) {
+        return false;
+    }
+
+    for (std::vector<float>& face : cubemap.faces) {
+        face.resize(cubemap.size * cubemap.size * 3);
+
+        if (!file.read(reinterpret_cast<char*>(face.data()), face.size() * sizeof(float))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // anonymous
+
+EnvironmentCache::EnvironmentCache(const std::string& directory) : _directory(directory) {}
+
+bool EnvironmentCache::computeKey(const std::string (&filenames)[6], const EnvironmentPrefilter::Settings& settings, uint64_t& key) {
+    key = hash(&version, sizeof(version), 14695981039346656037ull);
+
+    // The thread count doesn't change the result
+    const uint32_t parameters[] = {
+        settings.irradianceSize,
+        settings.specularSize,
+        settings.specularMipCount,
+        settings.specularSampleCount,
+        settings.brdfLutSize,
+        settings.brdfLutSampleCount
+    };
+
+    key = hash(parameters, sizeof(parameters), key);
+
+    for (const std::string& filename : filenames) {
+        ResourceFileSystem::File file;
+        if (!ResourceFileSystem::read(filename, file)) {
+            return false;
+        }
+
+        key = hash(file.data, file.size, key);
+    }
+
+    return true;
+}
+
+bool EnvironmentCache::load(uint64_t key, EnvironmentPrefilter::Environment& environment) const {
+    std::ifstream file(getPath(key), std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    char fileMagic[4];
+    uint32_t fileVersion;
+    uint32_t specularCount;
+
+    if (!file.read(fileMagic, sizeof(fileMagic)) || std::string(fileMagic, 4) != std::string(magic, 4)) {
+        return false;
+    }
+
+    if (!file.read(reinterpret_cast<char*>(&fileVersion), sizeof(fileVersion)) || fileVersion != version) {
+        return false;
+    }
+
+    if (!readCubemap(file, environment.irradiance)) {
+        return false;
+    }
+
+    if (!file.read(reinterpret_cast<char*>(&specularCount), sizeof(specularCount)) || specularCount > 16) {
+        return false;
+    }
+
+    environment.specular.resize(specularCount);
+
+    for (EnvironmentPrefilter::Cubemap& mip : environment.specular) {
+        if (!readCubemap(file, mip)) {
+            return false;
+        }
+    }
+
+    if (!file.read(reinterpret_cast<char*>(&environment.brdfLutSize), sizeof(environment.brdfLutSize)) || environment.brdfLutSize > 4096) {
+        return false;
+    }
+
+    environment.brdfLut.resize(environment.brdfLutSize * environment.brdfLutSize * 2);
+
+    return !!file.read(reinterpret_cast<char*>(environment.brdfLut.data()), environment.brdfLut.size() * sizeof(float));
+}
+
+bool EnvironmentCache::store(uint64_t key, const EnvironmentPrefilter::Environment& environment) const {
+#if defined(LUG_SYSTEM_WINDOWS)
+    _mkdir(_directory.c_str());
+#else
+    mkdir(_directory.c_str(), 0755);
+#endif
+
+    const std::string path = getPath(key);
+    const std::string temporaryPath = path + ".tmp";
+
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return false;
+        }
+
+        const uint32_t specularCount = static_cast<uint32_t>(environment.specular.size());
+
+        file.write(magic, sizeof(magic));
+        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+
+        writeCubemap(file, environment.irradiance);
+
+        file.write(reinterpret_cast<const char*>(&specularCount), sizeof(specularCount));
+        for (const EnvironmentPrefilter::Cubemap& mip : environment.specular) {
+            writeCubemap(file, mip);
+        }
+
+        file.write(reinterpret_cast<const char*>(&environment.brdfLutSize), sizeof(environment.brdfLutSize));
+        file.write(reinterpret_cast<const char*>(environment.brdfLut.data()), environment.brdfLut.size() * sizeof(float));
+
+        if (!file) {
+            return false;
+        }
+    }
+
+    // Replace the entry in one rename, a reader never sees a partial file
+#if defined(LUG_SYSTEM_WINDOWS)
+    // std::rename fails on Windows when the destination exists
+    return MoveFileExA(temporaryPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return std::rename(temporaryPath.c_str(), path.c_str()) == 0;
+#endif
+}
+
+std::string EnvironmentCache::getPath(uint64_t key) const {
+    std::ostringstream path;
+
+    path << _directory << "/environment-" << std::hex << key << ".ibl";
+
+    return path.str();
+}
@@ -0,0 +1,542 @@
+#include "EnvironmentPrefilter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <thread>
+#include <utility>
+
+#include <lug/System/Logger/Logger.hpp>
+
+#include "ImageFile.hpp"
+#include "Trace.hpp"
+
+namespace EnvironmentPrefilter {
+
+namespace {
+
+constexpr float pi = 3.14159265358979323846f;
+
+struct Direction {
+    float x;
+    float y;
+    float z;
+};
+
+Direction normalize(const Direction& direction) {
+    const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+    return {direction.x / length, direction.y / length, direction.z / length};
+}
+
+// Direction of the center of the texel (u, v) in [-1, 1] of a face
+Direction texelDirection(uint32_t face, float u, float v) {
+    switch (face) {
+        case 0: return normalize({1.0f, -v, -u});
+        case 1: return normalize({-1.0f, -v, u});
+        case 2: return normalize({u, 1.0f, v});
+        case 3: return normalize({u, -1.0f, -v});
+        case 4: return normalize({u, -v, 1.0f});
+        default: return normalize({-u, -v, -1.0f});
+    }
+}
+
+// Face and coordinates in [0, 1] of a direction
+void directionTexel(const Direction& direction, uint32_t& face, float& u, float& v) {
+    const float absX = std::abs(direction.x);
+    const float absY = std::abs(direction.y);
+    const float absZ = std::abs(direction.z);
+
+    float sc;
+    float tc;
+    float ma;
+
+    if (absX >= absY && absX >= absZ) {
+        face = direction.x > 0.0f ? 0 : 1;
+        sc = direction.x > 0.0f ? -direction.z : direction.z;
+        tc = -direction.y;
+        ma = absX;
+    } else if (absY >= absZ) {
+        face = direction.y > 0.0f ? 2 : 3;
+        sc = direction.x;
+        tc = direction.y > 0.0f ? direction.z : -direction.z;
+        ma = absY;
+    } else {
+        face = direction.z > 0.0f ? 4 : 5;
+        sc = direction.z > 0.0f ? direction.x : -direction.x;
+        tc = -direction.y;
+        ma = absZ;
+    }
+
+    u = (sc / ma + 1.0f) * 0.5f;
+    v = (tc / ma + 1.0f) * 0.5f;
+}
+
+// Solid angle of the texel (x, y) of a face of the given size
+float texelSolidAngle(uint32_t x, uint32_t y, uint32_t size) {
+    const auto area = [](float u, float v) {
+        return std::atan2(u * v, std::sqrt(u * u + v * v + 1.0f));
+    };
+
+    const float texel = 2.0f / size;
+    const float u0 = -1.0f + x * texel;
+    const float v0 = -1.0f + y * texel;
+    const float u1 = u0 + texel;
+    const float v1 = v0 + texel;
+
+    return area(u0, v0) - area(u0, v1) - area(u1, v0) + area(u1, v1);
+}
+
+void parallelFor(uint32_t count, uint32_t threadCount, const std::function<void(uint32_t)>& function) {
+    std::atomic<uint32_t> next{0};
+
+    const auto worker = [&next, count, &function]() {
+        SAMPLE_TRACE_ZONE("prefilter job");
+
+        for (uint32_t i = next++; i < count; i = next++) {
+            function(i);
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (uint32_t i = 1; i < threadCount; ++i) {
+        threads.emplace_back([&worker]() {
+            SAMPLE_TRACE_THREAD_NAME("prefilter worker");
+            worker();
+        });
+    }
+
+    worker();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+Cubemap downsample(const Cubemap& source) {
+    Cubemap result;
+
+    result.size = source.size / 2;
+
+    for (uint32_t face = 0; face < 6; ++face) {
+        const std::vector<float>& in = source.faces[face];
+        std::vector<float>& out = result.faces[face];
+
+        out.resize(result.size * result.size * 3);
+
+        for (uint32_t y = 0; y < result.size; ++y) {
+            for (uint32_t x = 0; x < result.size; ++x) {
+                for (uint32_t c = 0; c < 3; ++c) {
+                    const float sum = in[((2 * y) * source.size + 2 * x) * 3 + c]
+                                    + in[((2 * y) * source.size + 2 * x + 1) * 3 + c]
+                                    + in[((2 * y + 1) * source.size + 2 * x) * 3 + c]
+                                    + in[((2 * y + 1) * source.size + 2 * x + 1) * 3 + c];
+
+                    out[(y * result.size + x) * 3 + c] = sum * 0.25f;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+// Bilinear sample of one level, the filtering doesn't cross the edges of the faces
+void sampleLevel(const Cubemap& cubemap, const Direction& direction, float* color) {
+    uint32_t face;
+    float u;
+    float v;
+
+    directionTexel(direction, face, u, v);
+
+    const float x = std::max(0.0f, std::min(u * cubemap.size - 0.5f, cubemap.size - 1.0f));
+    const float y = std::max(0.0f, std::min(v * cubemap.size - 0.5f, cubemap.size - 1.0f));
+
+    const uint32_t x0 = static_cast<uint32_t>(x);
+    const uint32_t y0 = static_cast<uint32_t>(y);
+    const uint32_t x1 = std::min(x0 + 1, cubemap.size - 1);
+    const uint32_t y1 = std::min(y0 + 1, cubemap.size - 1);
+
+    const float fx = x - x0;
+    const float fy = y - y0;
+
+    const std::vector<float>& texels = cubemap.faces[face];
+
+    for (uint32_t c = 0; c < 3; ++c) {
+        const float top = texels[(y0 * cubemap.size + x0) * 3 + c] * (1.0f - fx) + texels[(y0 * cubemap.size + x1) * 3 + c] * fx;
+        const float bottom = texels[(y1 * cubemap.size + x0) * 3 + c] * (1.0f - fx) + texels[(y1 * cubemap.size + x1) * 3 + c] * fx;
+
+        color[c] = top * (1.0f - fy) + bottom * fy;
+    }
+}
+
+// Trilinear sample of the mip chain
+void sampleLod(const std::vector<Cubemap>& chain, const Direction& direction, float lod, float* color) {
+    lod = std::max(0.0f, std::min(lod, static_cast<float>(chain.size() - 1)));
+
+    const uint32_t level = static_cast<uint32_t>(lod);
+    const float blend = lod - level;
+
+    sampleLevel(chain[level], direction, color);
+
+    if (blend > 0.0f && level + 1 < chain.size()) {
+        float next[3];
+        sampleLevel(chain[level + 1], direction, next);
+
+        for (uint32_t c = 0; c < 3; ++c) {
+            color[c] = color[c] * (1.0f - blend) + next[c] * blend;
+        }
+    }
+}
+
+float radicalInverse(uint32_t bits) {
+    bits = (bits << 16u) | (bits >> 16u);
+    bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+    bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+    bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+    bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+
+    return static_cast<float>(bits) * 2.3283064365386963e-10f;
+}
+
+// GGX importance sample around the normal, in tangent space (z is the normal)
+Direction importanceSampleGgx(uint32_t i, uint32_t count, float roughness) {
+    const float alpha = roughness * roughness;
+
+    const float phi = 2.0f * pi * (static_cast<float>(i) / count);
+    const float xi = radicalInverse(i);
+    const float cosTheta = std::sqrt((1.0f - xi) / (1.0f + (alpha * alpha - 1.0f) * xi));
+    const float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+
+    return {sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta};
+}
+
+void computeIrradiance(const std::vector<Cubemap>& chain, const Settings& settings, Cubemap& irradiance) {
+    // Project the environment on the 9 first spherical harmonics, a level of at most 64 is enough
+    size_t level = 0;
+    while (level + 1 < chain.size() && chain[level].size > 64) {
+        ++level;
+    }
+
+    const Cubemap& source = chain[level];
+
+    float coefficients[9][3] = {};
+
+    for (uint32_t face = 0; face < 6; ++face) {
+        for (uint32_t y = 0; y < source.size; ++y) {
+            for (uint32_t x = 0; x < source.size; ++x) {
+                const Direction d = texelDirection(face, (2.0f * x + 1.0f) / source.size - 1.0f, (2.0f * y + 1.0f) / source.size - 1.0f);
+                const float weight = texelSolidAngle(x, y, source.size);
+
+                const float basis[9] = {
+                    0.282095f,
+                    0.488603f * d.y,
+                    0.488603f * d.z,
+                    0.488603f * d.x,
+                    1.092548f * d.x * d.y,
+                    1.092548f * d.y * d.z,
+                    0.315392f * (3.0f * d.z * d.z - 1.0f),
+                    1.092548f * d.x * d.z,
+                    0.546274f * (d.x * d.x - d.y * d.y)
+                };
+
+                for (uint32_t i = 0; i < 9; ++i) {
+                    for (uint32_t c = 0; c < 3; ++c) {
+                        coefficients[i][c] += source.faces[face][(y * source.size + x) * 3 + c] * basis[i] * weight;
+                    }
+                }
+            }
+        }
+    }
+
+    // Convolution with the clamped cosine, divided by pi
+    const float bands[9] = {1.0f, 2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f};
+
+    irradiance.size = settings.irradianceSize;
+
+    for (uint32_t face = 0; face < 6; ++face) {
+        irradiance.faces[face].resize(irradiance.size * irradiance.size * 3);
+    }
+
+    parallelFor(6 * irradiance.size, settings.threadCount, [&irradiance, &coefficients, &bands](uint32_t row) {
+        const uint32_t face = row / irradiance.size;
+        const uint32_t y = row % irradiance.size;
+
+        for (uint32_t x = 0; x < irradiance.size; ++x) {
+            const Direction d = texelDirection(face, (2.0f * x + 1.0f) / irradiance.size - 1.0f, (2.0f * y + 1.0f) / irradiance.size - 1.0f);
+
+            const float basis[9] = {
+                0.282095f,
+                0.488603f * d.y,
+                0.488603f * d.z,
+                0.488603f * d.x,
+                1.092548f * d.x * d.y,
+                1.092548f * d.y * d.z,
+                0.315392f * (3.0f * d.z * d.z - 1.0f),
+                1.092548f * d.x * d.z,
+                0.546274f * (d.x * d.x - d.y * d.y)
+            };
+
+            for (uint32_t c = 0; c < 3; ++c) {
+                float value = 0.0f;
+
+                for (uint32_t i = 0; i < 9; ++i) {
+                    value += coefficients[i][c] * bands[i] * basis[i];
+                }
+
+                irradiance.faces[face][(y * irradiance.size + x) * 3 + c] = std::max(0.0f, value);
+            }
+        }
+    });
+}
+
+void computeSpecular(const std::vector<Cubemap>& chain, const Settings& settings, std::vector<Cubemap>& specular) {
+    const uint32_t baseSize = std::min(settings.specularSize, chain[0].size);
+
+    specular.clear();
+
+    for (uint32_t size = baseSize; size > 0 && specular.size() < settings.specularMipCount; size /= 2) {
+        specular.emplace_back();
+        specular.back().size = size;
+
+        for (uint32_t face = 0; face < 6; ++face) {
+            specular.back().faces[face].resize(size * size * 3);
+        }
+    }
+
+    const uint32_t mipCount = static_cast<uint32_t>(specular.size());
+    const float sourceTexelSolidAngle = 4.0f * pi / (6.0f * chain[0].size * chain[0].size);
+
+    for (uint32_t mip = 0; mip < mipCount; ++mip) {
+        Cubemap& target = specular[mip];
+        const float roughness = mipCount > 1 ? static_cast<float>(mip) / (mipCount - 1) : 0.0f;
+        const float alpha = roughness * roughness;
+
+        parallelFor(6 * target.size, settings.threadCount, [&chain, &settings, &target, roughness, alpha, sourceTexelSolidAngle](uint32_t row) {
+            const uint32_t face = row / target.size;
+            const uint32_t y = row % target.size;
+
+            for (uint32_t x = 0; x < target.size; ++x) {
+                // N = V = R
+                const Direction n = texelDirection(face, (2.0f * x + 1.0f) / target.size - 1.0f, (2.0f * y + 1.0f) / target.size - 1.0f);
+                float* out = &target.faces[face][(y * target.size + x) * 3];
+
+                if (roughness == 0.0f) {
+                    sampleLod(chain, n, std::log2(static_cast<float>(chain[0].size) / target.size), out);
+                    continue;
+                }
+
+                // Tangent frame around the normal
+                const Direction up = std::abs(n.z) < 0.999f ? Direction{0.0f, 0.0f, 1.0f} : Direction{1.0f, 0.0f, 0.0f};
+                const Direction tangent = normalize({up.y * n.z - up.z * n.y, up.z * n.x - up.x * n.z, up.x * n.y - up.y * n.x});
+                const Direction bitangent = {n.y * tangent.z - n.z * tangent.y, n.z * tangent.x - n.x * tangent.z, n.x * tangent.y - n.y * tangent.x};
+
+                float sum[3] = {0.0f, 0.0f, 0.0f};
+                float totalWeight = 0.0f;
+
+                for (uint32_t i = 0; i < settings.specularSampleCount; ++i) {
+                    const Direction h = importanceSampleGgx(i, settings.specularSampleCount, roughness);
+
+                    const Direction hWorld = {
+                        tangent.x * h.x + bitangent.x * h.y + n.x * h.z,
+                        tangent.y * h.x + bitangent.y * h.y + n.y * h.z,
+                        tangent.z * h.x + bitangent.z * h.y + n.z * h.z
+                    };
+
+                    const float nDotH = h.z;
+                    const Direction l = {2.0f * nDotH * hWorld.x - n.x, 2.0f * nDotH * hWorld.y - n.y, 2.0f * nDotH * hWorld.z - n.z};
+                    const float nDotL = l.x * n.x + l.y * n.y + l.z * n.z;
+
+                    if (nDotL <= 0.0f) {
+                        continue;
+                    }
+
+                    // Filtered importance sampling, read the level matching the solid angle of the sample
+                    const float denominator = nDotH * nDotH * (alpha * alpha - 1.0f) + 1.0f;
+                    const float d = alpha * alpha / (pi * denominator * denominator);
+                    const float pdf = d / 4.0f;
+                    const float sampleSolidAngle = 1.0f / (settings.specularSampleCount * pdf);
+                    const float lod = 0.5f * std::log2(sampleSolidAngle / sourceTexelSolidAngle) + 1.0f;
+
+                    float color[3];
+                    sampleLod(chain, l, lod, color);
+
+                    for (uint32_t c = 0; c < 3; ++c) {
+                        sum[c] += color[c] * nDotL;
+                    }
+
+                    totalWeight += nDotL;
+                }
+
+                for (uint32_t c = 0; c < 3; ++c) {
+                    out[c] = totalWeight > 0.0f ? sum[c] / totalWeight : 0.0f;
+                }
+            }
+        });
+    }
+}
+
+void computeBrdfLut(const Settings& settings, uint32_t& lutSize, std::vector<float>& lut) {
+    lutSize = settings.brdfLutSize;
+    lut.resize(lutSize * lutSize * 2);
+
+    parallelFor(lutSize, settings.threadCount, [&settings, lutSize, &lut](uint32_t y) {
+        const float roughness = (y + 0.5f) / lutSize;
+        const float alpha = roughness * roughness;
+
+        // Schlick-GGX geometry term with k = alpha / 2 for image based lighting
+        const float k = alpha / 2.0f;
+
+        for (uint32_t x = 0; x < lutSize; ++x) {
+            const float nDotV = (x + 0.5f) / lutSize;
+            const Direction v = {std::sqrt(1.0f - nDotV * nDotV), 0.0f, nDotV};
+
+            float scale = 0.0f;
+            float bias = 0.0f;
+
+            for (uint32_t i = 0; i < settings.brdfLutSampleCount; ++i) {
+                const Direction h = importanceSampleGgx(i, settings.brdfLutSampleCount, roughness);
+
+                const float vDotH = v.x * h.x + v.y * h.y + v.z * h.z;
+                const float nDotL = 2.0f * vDotH * h.z - v.z;
+
+                if (nDotL <= 0.0f) {
+                    continue;
+                }
+
+                const float nDotH = std::max(h.z, 0.0f);
+                const float g = (nDotV / (nDotV * (1.0f - k) + k)) * (nDotL / (nDotL * (1.0f - k) + k));
+                const float visibility = g * std::max(vDotH, 0.0f) / (nDotH * nDotV);
+                const float fresnel = std::pow(1.0f - std::max(vDotH, 0.0f), 5.0f);
+
+                scale += (1.0f - fresnel) * visibility;
+                bias += fresnel * visibility;
+            }
+
+            lut[(y * lutSize + x) * 2] = scale / settings.brdfLutSampleCount;
+            lut[(y * lutSize + x) * 2 + 1] = bias / settings.brdfLutSampleCount;
+        }
+    });
+}
+
+bool validateCubemap(const Cubemap& cubemap, uint32_t size, const char* name) {
+    if (cubemap.size != size) {
+        LUG_LOG.error("EnvironmentPrefilter: The {} is {} texels wide instead of {}", name, cubemap.size, size);
+        return false;
+    }
+
+    for (const std::vector<float>& face : cubemap.faces) {
+        if (face.size() != size * size * 3) {
+            LUG_LOG.error("EnvironmentPrefilter: A face of the {} doesn't have {} texels", name, size * size);
+            return false;
+        }
+
+        for (float value : face) {
+            if (!std::isfinite(value) || value < 0.0f) {
+                LUG_LOG.error("EnvironmentPrefilter: The {} has a texel of {}", name, value);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+} // anonymous
+
+bool loadFaces(const std::string (&filenames)[6], Cubemap& cubemap) {
+    cubemap.size = 0;
+
+    for (uint32_t face = 0; face < 6; ++face) {
+        // LDR images are converted to linear floats
+        ImageFile::FloatImage image;
+        if (!ImageFile::loadFloat(filenames[face], image, 3)) {
+            return false;
+        }
+
+        if (image.width != image.height || (face > 0 && image.width != cubemap.size)) {
+            LUG_LOG.error("EnvironmentPrefilter: The face {} is not a square of the size of the others", filenames[face]);
+            return false;
+        }
+
+        cubemap.size = image.width;
+        cubemap.faces[face] = std::move(image.texels);
+    }
+
+    return true;
+}
+
+void prefilter(const Cubemap& source, const Settings& settings, Environment& environment) {
+    // Box filtered chain of the source, sampled by the specular prefilter depending on the roughness
+    std::vector<Cubemap> chain;
+    chain.push_back(source);
+
+    while (chain.back().size > 1) {
+        chain.push_back(downsample(chain.back()));
+    }
+
+    {
+        SAMPLE_TRACE_ZONE("irradiance");
+        computeIrradiance(chain, settings, environment.irradiance);
+    }
+
+    {
+        SAMPLE_TRACE_ZONE("specular");
+        computeSpecular(chain, settings, environment.specular);
+    }
+
+    {
+        SAMPLE_TRACE_ZONE("brdfLut");
+        computeBrdfLut(settings, environment.brdfLutSize, environment.brdfLut);
+    }
+}
+
+bool validate(const Settings& settings, const Environment& environment) {
+    if (!validateCubemap(environment.irradiance, settings.irradianceSize, "irradiance map")) {
+        return false;
+    }
+
+    // The specular chain starts at the size of the source when it is smaller than the settings,
+    // and stops at 1 texel
+    if (environment.specular.empty() || environment.specular[0].size > settings.specularSize) {
+        LUG_LOG.error("EnvironmentPrefilter: The specular chain is empty or larger than {}", settings.specularSize);
+        return false;
+    }
+
+    uint32_t mipCount = 0;
+    for (uint32_t size = environment.specular[0].size; size > 0 && mipCount < settings.specularMipCount; size /= 2) {
+        ++mipCount;
+    }
+
+    if (environment.specular.size() != mipCount) {
+        LUG_LOG.error("EnvironmentPrefilter: The specular chain has {} mips instead of {}", environment.specular.size(), mipCount);
+        return false;
+    }
+
+    for (size_t mip = 0; mip < environment.specular.size(); ++mip) {
+        if (!validateCubemap(environment.specular[mip], environment.specular[0].size >> mip, "specular mip")) {
+            return false;
+        }
+    }
+
+    if (environment.brdfLutSize != settings.brdfLutSize || environment.brdfLut.size() != environment.brdfLutSize * environment.brdfLutSize * 2) {
+        LUG_LOG.error("EnvironmentPrefilter: The BRDF LUT is {} texels wide instead of {}", environment.brdfLutSize, settings.brdfLutSize);
+        return false;
+    }
+
+    // The scale and the bias of F0 add up to the reflectance for F0 = 1, at most 1
+    for (size_t i = 0; i < environment.brdfLut.size(); i += 2) {
+        const float scale = environment.brdfLut[i];
+        const float bias = environment.brdfLut[i + 1];
+
+        if (!std::isfinite(scale) || !std::isfinite(bias) || scale < 0.0f || bias < 0.0f || scale + bias > 1.001f) {
+            LUG_LOG.error("EnvironmentPrefilter: The BRDF LUT has a texel of ({}, {})", scale, bias);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // EnvironmentPrefilter
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <lug/Config.hpp>
+
+namespace ArchiveFormat {
+struct Header;
+struct Entry;
+} // ArchiveFormat
+
+/**
+ * @brief      A resource archive, mapped in memory. See ArchiveFormat.
+ *
+ *             A lookup is a hash and a few probes in the mapped index, a read of an uncompressed
+ *             entry points in the mapping and copies nothing.
+ */
+class Archive {
+public:
+    Archive() = default;
+
+    Archive(const Archive&) = delete;
+    Archive(Archive&&) = delete;
+
+    Archive& operator=(const Archive&) = delete;
+    Archive& operator=(Archive&&) = delete;
+
+    ~Archive();
+
+    bool open(const std::string& filename);
+    void close();
+
+    bool contains(const std::string& path) const;
+
+    /**
+     * @brief      Reads an entry.
+     *
+     * @param[in]  path    The path of the entry.
+     * @param      buffer  Receives the entry if it is compressed.
+     * @param[out] data    The content, in the mapping or in the buffer.
+     * @param[out] size    The size of the content.
+     *
+     * @return     False if the entry doesn't exist or is corrupted.
+     */
+    bool read(const std::string& path, std::vector<uint8_t>& buffer, const uint8_t*& data, size_t& size) const;
+
+    uint32_t getEntryCount() const;
+
+private:
+    const ArchiveFormat::Entry* find(const std::string& path) const;
+
+private:
+    const uint8_t* _data{nullptr};
+    size_t _size{0};
+
+    const ArchiveFormat::Header* _header{nullptr};
+    const uint32_t* _buckets{nullptr};
+    const ArchiveFormat::Entry* _entries{nullptr};
+    const char* _paths{nullptr};
+
+#if defined(LUG_SYSTEM_WINDOWS)
+    void* _file{nullptr};
+    void* _mapping{nullptr};
+#endif
+};
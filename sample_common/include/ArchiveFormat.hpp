@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief      Layout of a resource archive (.luga), written by lug-pack-resources and mapped by Archive.
+ *
+ *             Header | buckets | entries | paths | data
+ *
+ *             The buckets are an open addressing hash table of the paths, each holding the index
+ *             of an entry plus one, zero is empty. The data of each entry is aligned on dataAlignment,
+ *             stored as is or compressed with Lz4.
+ */
+namespace ArchiveFormat {
+
+constexpr char magic[4] = {'L', 'U', 'G', 'A'};
+constexpr uint32_t version = 1;
+constexpr uint64_t dataAlignment = 64;
+
+enum EntryFlags : uint32_t {
+    Compressed = 1 << 0
+};
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t bucketCount; // A power of two
+    uint64_t bucketsOffset;
+    uint64_t entriesOffset;
+    uint64_t pathsOffset;
+    uint64_t pathsSize;
+};
+
+struct Entry {
+    uint64_t pathHash;
+    uint64_t offset;
+    uint64_t size;
+    uint64_t storedSize;
+    uint32_t pathOffset; // From pathsOffset
+    uint32_t pathLength;
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(Header) == 48, "The header must have no padding");
+static_assert(sizeof(Entry) == 48, "The entries must have no padding");
+
+/**
+ * @brief      FNV-1a, of the path relative to the root of the resources, with forward slashes.
+ */
+inline uint64_t hashPath(const std::string& path) {
+    uint64_t hash = 14695981039346656037ull;
+
+    for (char c : path) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+
+    return hash;
+}
+
+} // ArchiveFormat
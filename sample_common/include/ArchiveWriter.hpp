@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief      Writes a resource archive, see ArchiveFormat.
+ */
+class ArchiveWriter {
+public:
+    ArchiveWriter() = default;
+
+    ArchiveWriter(const ArchiveWriter&) = delete;
+    ArchiveWriter(ArchiveWriter&&) = delete;
+
+    ArchiveWriter& operator=(const ArchiveWriter&) = delete;
+    ArchiveWriter& operator=(ArchiveWriter&&) = delete;
+
+    ~ArchiveWriter() = default;
+
+    /**
+     * @brief      Adds a file.
+     *
+     * @param[in]  path      The path it is looked up with.
+     * @param[in]  data      The content.
+     * @param[in]  compress  Whether to compress it, it is stored as is if that doesn't save at least an eighth.
+     *
+     * @return     False if the path was already added.
+     */
+    bool add(const std::string& path, std::vector<uint8_t> data, bool compress);
+
+    bool write(const std::string& filename) const;
+
+    uint64_t getSize() const;
+    uint64_t getStoredSize() const;
+
+private:
+    struct File {
+        std::string path;
+        uint64_t size;
+        bool compressed;
+        std::vector<uint8_t> data;
+    };
+
+    std::vector<File> _files;
+};
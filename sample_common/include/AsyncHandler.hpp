@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+
+#include <lug/System/Logger/Handler.hpp>
+
+/**
+ * @brief      Log handler that hands the formatted messages to a background thread.
+ *
+ *             The calling threads copy the message in a bounded lock-free multi-producer ring
+ *             and return, the background thread writes the messages to the stream in batches.
+ *             Each message is prefixed with the time it was logged at, relative to the creation
+ *             of the handler.
+ */
+class AsyncHandler : public lug::System::Logger::Handler {
+public:
+    enum class OverflowPolicy : uint8_t {
+        Drop,   // The message is lost, the count of lost messages is written later
+        Block   // The calling thread waits for a free slot
+    };
+
+    // Longer messages are truncated
+    static constexpr size_t maxMessageSize = 500;
+
+public:
+    AsyncHandler(const std::string& name, std::ostream& ostream, OverflowPolicy policy = OverflowPolicy::Block, size_t capacity = 4096);
+
+    AsyncHandler(const AsyncHandler&) = delete;
+    AsyncHandler(AsyncHandler&&) = delete;
+
+    AsyncHandler& operator=(const AsyncHandler&) = delete;
+    AsyncHandler& operator=(AsyncHandler&&) = delete;
+
+    /**
+     * @brief      Writes the remaining messages and stops the background thread.
+     */
+    ~AsyncHandler() override;
+
+    void handle(const lug::System::Logger::priv::Message& msg) override;
+
+    /**
+     * @brief      Waits until the messages handled before the call are written and flushed.
+     */
+    void flush() override;
+
+    uint64_t getDroppedCount() const;
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        std::chrono::steady_clock::time_point timestamp;
+        uint32_t size;
+        char text[maxMessageSize];
+    };
+
+    // Padded so that the producers and the consumer don't share a cache line (alignas would
+    // need an over-aligned new, C++17 only)
+    struct Position {
+        std::atomic<size_t> value{0};
+        char padding[64 - sizeof(std::atomic<size_t>)];
+    };
+
+    void run();
+
+    // Writes the available messages, returns their count
+    size_t drain();
+
+private:
+    std::ostream& _ostream;
+    OverflowPolicy _policy;
+
+    std::unique_ptr<Slot[]> _slots;
+    size_t _mask;
+
+    Position _enqueuePosition;
+    Position _dequeuePosition;
+    std::atomic<size_t> _flushedPosition{0};
+
+    std::atomic<uint64_t> _dropped{0};
+    uint64_t _reportedDropped{0};
+
+    std::chrono::steady_clock::time_point _start;
+
+    std::atomic<bool> _stop{false};
+    std::thread _thread;
+};
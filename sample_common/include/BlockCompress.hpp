@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief      CPU encoder and decoder of the BC1, BC3 and BC5 block compressed formats.
+ *
+ *             The texels are split in blocks of 4x4, the blocks on the right and bottom edges
+ *             repeat the last column and row. The color endpoints are fitted on the principal
+ *             axis of each block, refined by least squares with the better quality presets, and
+ *             the block rows are split between the threads.
+ *
+ *             The encoder works on the stored values: sRGB textures are compressed as they are
+ *             and decoded by the sampler of a _SRGB format.
+ */
+namespace BlockCompress {
+
+enum class Format : uint8_t {
+    Rgba8, // Uncompressed, 4 bytes per texel
+    Bc1,   // RGB, 8 bytes per block (4 bits per texel)
+    Bc3,   // RGBA, BC1 colors and a BC4 alpha, 16 bytes per block
+    Bc5    // RG, two BC4 channels, 16 bytes per block, for the XY of normal maps
+};
+
+enum class Quality : uint8_t {
+    Fast,   // Principal axis endpoints only
+    Normal, // Least squares refinement of the endpoints
+    High    // Longer refinement and a search around the endpoints, several times slower
+};
+
+struct Settings {
+    Format format{Format::Bc1};
+    Quality quality{Quality::Normal};
+    uint32_t threadCount{1};
+};
+
+const char* getName(Format format);
+const char* getName(Quality quality);
+
+/**
+ * @brief      Returns the size of a block of 4x4 texels, 0 for Rgba8.
+ */
+uint32_t getBlockSize(Format format);
+
+/**
+ * @brief      Returns the size of the data of a width x height level.
+ */
+uint64_t getSize(Format format, uint32_t width, uint32_t height);
+
+/**
+ * @brief      Picks the format of a RGBA8 texture: BC5 for the normal maps, BC3 if any texel is
+ *             translucent, BC1 otherwise.
+ */
+Format selectFormat(const uint8_t* rgba, size_t pixelCount, bool normalMap);
+
+/**
+ * @brief      Compresses a level of RGBA8 texels, Rgba8 copies them.
+ */
+void encode(uint32_t width, uint32_t height, const uint8_t* rgba, const Settings& settings, std::vector<uint8_t>& data);
+
+/**
+ * @brief      Decompresses a level to RGBA8 texels.
+ *
+ *             The channels a format doesn't store are opaque white, except the blue channel of
+ *             BC5 which is the Z of the normal, rebuilt from X and Y.
+ */
+void decode(Format format, uint32_t width, uint32_t height, const uint8_t* data, std::vector<uint8_t>& rgba);
+
+/**
+ * @brief      Returns the peak signal to noise ratio of a compressed level, in dB, over the channels
+ *             its format stores. Infinite if the level is lossless.
+ */
+float computePsnr(Format format, uint32_t width, uint32_t height, const uint8_t* rgba, const uint8_t* data);
+
+} // BlockCompress
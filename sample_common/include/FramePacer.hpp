@@ -0,0 +1,134 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief      Paces the frames of a sample from its onFrame, as the engine's run loop can't be changed.
+ *
+ *             - Uncapped: frames as fast as the renderer allows.
+ *             - FixedStep: uncapped, the simulation advances by fixed ticks and is interpolated.
+ *               Only offered by the samples that drive their simulation with advance().
+ *             - Capped: the frame rate is capped by waiting at the end of the frame.
+ *             - LowLatency: the same cap, but the wait happens at the start of the frame, before
+ *               the input is read, so that it is as fresh as possible when the frame is submitted.
+ *
+ *             The waits sleep most of the time and spin the end, as the sleeps overshoot by up
+ *             to a scheduler quantum. The frame time mean and variance are kept for each mode.
+ */
+class FramePacer {
+public:
+    enum class Mode : uint8_t {
+        Uncapped,
+        FixedStep,
+        Capped,
+        LowLatency
+    };
+
+    static constexpr uint8_t modeCount = 4;
+
+    struct Stats {
+        uint64_t frameCount;
+        double meanMilliseconds;
+        double sumSquaredDifferences; // Welford's online variance
+        double waitMilliseconds;
+
+        double getVariance() const;
+    };
+
+public:
+    FramePacer() = default;
+
+    FramePacer(const FramePacer&) = delete;
+    FramePacer(FramePacer&&) = delete;
+
+    FramePacer& operator=(const FramePacer&) = delete;
+    FramePacer& operator=(FramePacer&&) = delete;
+
+    ~FramePacer() = default;
+
+    static const char* getModeName(Mode mode);
+
+    /**
+     * @brief      Parses a mode given on the command line: uncapped, fixed-step, capped or low-latency.
+     */
+    static bool parseMode(const std::string& name, Mode& mode);
+
+    /**
+     * @brief      Reads --frame-pacing <mode>, --frame-rate <fps> and --tick-rate <hz>.
+     *
+     * @return     False if one of them is invalid.
+     */
+    bool parseArguments(int argc, char* argv[]);
+
+    void setMode(Mode mode);
+    Mode getMode() const;
+
+    /**
+     * @brief      Sets whether the sample advances its simulation with advance() and
+     *             getInterpolation(). The FixedStep mode can't be selected otherwise.
+     */
+    void setFixedStepSupported(bool supported);
+    bool isSupported(Mode mode) const;
+
+    void setFrameRate(float frameRate);
+    float getFrameRate() const;
+
+    void setTickRate(float tickRate);
+    float getTickSeconds() const;
+
+    /**
+     * @brief      Must be called first in onFrame. Waits in the LowLatency mode.
+     */
+    void beginFrame();
+
+    /**
+     * @brief      Must be called last in onFrame. Waits in the Capped mode.
+     */
+    void endFrame();
+
+    /**
+     * @brief      Accumulates the frame time for the FixedStep simulation.
+     *
+     * @param[in]  elapsedSeconds  The frame time.
+     *
+     * @return     The number of ticks to simulate this frame.
+     */
+    uint32_t advance(float elapsedSeconds);
+
+    /**
+     * @brief      Returns the position between the last two ticks, in [0, 1), to interpolate the
+     *             simulated state with.
+     */
+    float getInterpolation() const;
+
+    const Stats& getStats(Mode mode) const;
+
+    /**
+     * @brief      Draws the mode selection and the stats of the modes.
+     */
+    void draw();
+
+    void logStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void pace();
+    Clock::duration getPeriod() const;
+
+private:
+    Mode _mode{Mode::Uncapped};
+    bool _fixedStepSupported{false};
+    float _frameRate{60.0f};
+    float _tickSeconds{1.0f / 60.0f};
+
+    Clock::time_point _deadline;
+    Clock::time_point _frameStart;
+    bool _restart{true};
+
+    float _accumulatedSeconds{0.0f};
+
+    Stats _stats[modeCount]{};
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief      Reads the image files of the samples, through ResourceFileSystem.
+ *
+ *             The engine decodes the images it loads itself, this is for the samples that need
+ *             to know about them (their size, their texels) beforehand.
+ */
+namespace ImageFile {
+
+struct Image {
+    uint32_t width;
+    uint32_t height;
+    uint32_t components;
+
+    // 8 bits per component, row by row
+    std::vector<uint8_t> texels;
+};
+
+struct FloatImage {
+    uint32_t width;
+    uint32_t height;
+    uint32_t components;
+
+    // Linear, row by row
+    std::vector<float> texels;
+};
+
+/**
+ * @brief      Reads the size of an image from its header, without decoding it.
+ */
+bool getInfo(const std::string& filename, uint32_t& width, uint32_t& height, uint32_t& components);
+
+/**
+ * @brief      Decodes an image.
+ *
+ * @param[in]  components  The components to decode to, 0 to keep the ones of the file. RGB files
+ *                         decoded to 4 components are expanded with PixelConvert::rgbToRgba.
+ */
+bool load(const std::string& filename, Image& image, uint32_t components = 0);
+
+/**
+ * @brief      Decodes an image to floats, the LDR images are converted from sRGB to linear.
+ *
+ * @param[in]  components  The components to decode to, 0 to keep the ones of the file.
+ */
+bool loadFloat(const std::string& filename, FloatImage& image, uint32_t components = 0);
+
+} // ImageFile
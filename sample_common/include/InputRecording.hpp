@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <lug/Graphics/Node.hpp>
+#include <lug/System/Time.hpp>
+#include <lug/Window/Event.hpp>
+
+/**
+ * @brief      Recording of the input of a sample, to replay a camera flythrough reproducibly.
+ *
+ *             FreeMovement reads the state of the window rather than its events, so a frame is
+ *             recorded as the events received during the frame, the frame time and the pose of
+ *             the camera after the movement. The replay restores the poses instead of running
+ *             FreeMovement, whatever the mouse does.
+ */
+namespace InputRecording {
+
+struct Frame {
+    uint32_t eventCount;
+    uint32_t elapsedMicroseconds;
+    float position[3];
+    float rotation[4];
+};
+
+class Recorder {
+public:
+    Recorder() = default;
+
+    Recorder(const Recorder&) = delete;
+    Recorder(Recorder&&) = delete;
+
+    Recorder& operator=(const Recorder&) = delete;
+    Recorder& operator=(Recorder&&) = delete;
+
+    ~Recorder() = default;
+
+    void addEvent(const lug::Window::Event& event);
+
+    /**
+     * @brief      Records the frame with the events added since the previous one.
+     *
+     * @param[in]  elapsedTime  The frame time.
+     * @param[in]  camera       The node moved by FreeMovement.
+     */
+    void endFrame(const lug::System::Time& elapsedTime, const lug::Graphics::Node& camera);
+
+    bool save(const std::string& filename) const;
+
+    uint32_t getFrameCount() const;
+
+private:
+    std::vector<Frame> _frames;
+    std::vector<lug::Window::Event> _events;
+    uint32_t _pendingEventCount{0};
+};
+
+class Replay {
+public:
+    Replay() = default;
+
+    Replay(const Replay&) = delete;
+    Replay(Replay&&) = delete;
+
+    Replay& operator=(const Replay&) = delete;
+    Replay& operator=(Replay&&) = delete;
+
+    ~Replay() = default;
+
+    bool load(const std::string& filename);
+    bool isLoaded() const;
+
+    /**
+     * @brief      Moves to the next recorded frame and restores its camera pose.
+     *
+     * @param      camera       The node moved by FreeMovement when recording.
+     * @param[in]  elapsedTime  The real frame time, accumulated for the report.
+     *
+     * @return     False if all the frames were replayed.
+     */
+    bool nextFrame(lug::Graphics::Node& camera, const lug::System::Time& elapsedTime);
+
+    /**
+     * @brief      Returns the recorded frame time of the current frame, to use it for the
+     *             simulation instead of the real one.
+     */
+    lug::System::Time getElapsedTime() const;
+
+    const lug::Window::Event* getFrameEvents() const;
+    uint32_t getFrameEventCount() const;
+
+    uint32_t getFrameCount() const;
+    uint32_t getReplayedFrameCount() const;
+    double getReplayedMilliseconds() const;
+
+private:
+    std::vector<Frame> _frames;
+    std::vector<lug::Window::Event> _events;
+
+    uint32_t _frameIndex{0};
+    uint32_t _firstEvent{0};
+    double _replayedMilliseconds{0.0};
+};
+
+} // InputRecording
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+#include "AsyncHandler.hpp"
+
+namespace LoggingBenchmark {
+
+/**
+ * @brief      Logs from several threads through a StdoutHandler, then through an AsyncHandler,
+ *             and writes the calls per second of both to LUG_LOG.
+ *
+ * @param[in]  policy             The overflow policy of the AsyncHandler.
+ * @param[in]  threadCount        The number of logging threads.
+ * @param[in]  messagesPerThread  The number of messages logged by each thread.
+ */
+void run(AsyncHandler::OverflowPolicy policy, uint32_t threadCount = 8, uint32_t messagesPerThread = 20000);
+
+} // LoggingBenchmark
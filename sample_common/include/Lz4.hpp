@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief      Compression in the LZ4 block format: fast to decompress, with a modest ratio.
+ */
+namespace Lz4 {
+
+size_t getMaxCompressedSize(size_t size);
+
+/**
+ * @brief      Compresses a block.
+ *
+ * @param[in]  src   The data to compress.
+ * @param[in]  size  The size of the data.
+ * @param      dst   The output, of at least getMaxCompressedSize(size) bytes.
+ *
+ * @return     The compressed size.
+ */
+size_t compress(const uint8_t* src, size_t size, uint8_t* dst);
+
+/**
+ * @brief      Decompresses a block, checking every read and write against the bounds.
+ *
+ * @return     False if the block is corrupted or doesn't decompress to exactly dstSize bytes.
+ */
+bool decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+
+} // Lz4
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "BlockCompress.hpp"
+#include "MipGenerator.hpp"
+
+/**
+ * @brief      Writes a cooked texture, see MipFormat.
+ */
+namespace MipFileWriter {
+
+/**
+ * @brief      Writes a mip chain, coarsest level first.
+ *
+ * @param[in]  filename  The cooked texture to write.
+ * @param[in]  levels    The full chain, from MipGenerator::generate, the texels of each level
+ *                       already in format (see BlockCompress::encode).
+ * @param[in]  format    The format of the texels.
+ *
+ * @return     False if the file can't be written.
+ */
+bool write(const std::string& filename, const std::vector<MipGenerator::Level>& levels, BlockCompress::Format format = BlockCompress::Format::Rgba8);
+
+} // MipFileWriter
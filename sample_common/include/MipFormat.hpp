@@ -0,0 +1,57 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "BlockCompress.hpp"
+
+/**
+ * @brief      Layout of a cooked texture (.lugm), written by lug-cook-mips and streamed by MipStreamer.
+ *
+ *             Header | levels | data
+ *
+ *             The levels are indexed by mip, 0 being the full size one, but their data is stored
+ *             coarsest first: a reader going forward gets a complete, ever sharper texture at each
+ *             level it reaches. The texels are RGBA8 or compressed in blocks (see BlockCompress), the
+ *             data of each level aligned on dataAlignment.
+ */
+namespace MipFormat {
+
+constexpr char magic[4] = {'L', 'U', 'G', 'M'};
+constexpr uint32_t version = 2;
+constexpr uint64_t dataAlignment = 64;
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t levelCount;
+    uint32_t format; // BlockCompress::Format
+    uint32_t reserved[2];
+};
+
+struct Level {
+    uint64_t offset;
+    uint64_t size;
+    uint32_t width;
+    uint32_t height;
+};
+
+static_assert(sizeof(Header) == 32, "The header must have no padding");
+static_assert(sizeof(Level) == 24, "The levels must have no padding");
+
+/**
+ * @brief      Returns the number of levels of a full mip chain, down to 1x1.
+ */
+inline uint32_t getLevelCount(uint32_t width, uint32_t height) {
+    uint32_t count = 1;
+
+    while ((std::max(width, height) >> count) > 0) {
+        ++count;
+    }
+
+    return count;
+}
+
+} // MipFormat
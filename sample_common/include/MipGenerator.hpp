@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "PixelConvert.hpp"
+
+/**
+ * @brief      CPU generation of the mip chain of a RGBA8 texture.
+ *
+ *             Each level is filtered from the previous one in linear space, separably, with the
+ *             edges clamped: the color channels of sRGB textures are decoded before and encoded
+ *             after the filtering, the normals of normal maps are renormalized at each level.
+ *             The rows of a level are split between the threads. The box kernel averages the 2x2
+ *             blocks with PixelConvert::downsample when a level halves exactly.
+ */
+namespace MipGenerator {
+
+enum class Kernel : uint8_t {
+    Box,      // The average of the covered texels, the blurriest and the most aliased
+    Triangle,
+    Kaiser,   // Windowed sinc, alpha 4 over two texels of the level, sharp with little ringing
+    Lanczos3  // Windowed sinc over three texels, the sharpest and the most ringing
+};
+
+enum class Content : uint8_t {
+    Color,  // sRGB color, linear alpha
+    Linear, // Data in linear space (metallic, roughness, occlusion)
+    Normal  // Tangent space normals in RGB, from [0, 1] to [-1, 1], alpha linear
+};
+
+struct Settings {
+    Kernel kernel{Kernel::Kaiser};
+    Content content{Content::Color};
+    uint32_t threadCount{1};
+    PixelConvert::Path path{PixelConvert::getBestPath()};
+};
+
+struct Level {
+    uint32_t width;
+    uint32_t height;
+    std::vector<uint8_t> texels;
+};
+
+const char* getName(Kernel kernel);
+const char* getName(Content content);
+
+/**
+ * @brief      Generates the full chain, down to 1x1. Each level is max(1, width / 2) x max(1, height / 2)
+ *             of the previous one, the first one is a copy of the texture.
+ */
+void generate(uint32_t width, uint32_t height, const uint8_t* texels, const Settings& settings, std::vector<Level>& levels);
+
+} // MipGenerator
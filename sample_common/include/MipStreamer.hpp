@@ -0,0 +1,141 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "MipFormat.hpp"
+
+/**
+ * @brief      Streams the levels of cooked textures (see MipFormat), coarsest first.
+ *
+ *             The coarsest level of each texture is read when it is added, so the first frame
+ *             can show it. The finer ones are read in the background, one level of every texture
+ *             before the next finer one, and become resident at the next update. Until its full
+ *             size level arrives, the minimum LOD of a texture is clamped to its finest resident one.
+ *
+ *             The time to the first frame and the time to the full quality are measured from the
+ *             first addTexture() to the end of the frames showing them, so they don't include the
+ *             loading the application does before.
+ */
+class MipStreamer {
+public:
+    static constexpr uint32_t invalidTexture = std::numeric_limits<uint32_t>::max();
+
+    struct Level {
+        uint32_t width;
+        uint32_t height;
+        std::vector<uint8_t> data; // In the format of the texture
+    };
+
+    struct Stats {
+        double firstFrameMilliseconds;
+        double fullQualityMilliseconds; // Negative until all the levels are resident
+
+        double initialMilliseconds; // Spent reading the coarsest levels in addTexture()
+        uint64_t initialBytes;
+        uint64_t streamedBytes;
+        uint32_t streamedLevelCount;
+        uint32_t failedTextureCount;
+    };
+
+public:
+    /**
+     * @param[in]  bytesPerSecond  Limits the reads to emulate a slower storage, 0 for no limit.
+     */
+    explicit MipStreamer(uint64_t bytesPerSecond = 0);
+
+    MipStreamer(const MipStreamer&) = delete;
+    MipStreamer(MipStreamer&&) = delete;
+
+    MipStreamer& operator=(const MipStreamer&) = delete;
+    MipStreamer& operator=(MipStreamer&&) = delete;
+
+    ~MipStreamer();
+
+    /**
+     * @brief      Reads the levels table and the coarsest level of a cooked texture.
+     *
+     *             The textures must all be added before start().
+     *
+     * @return     The identifier of the texture, invalidTexture if the file can't be read.
+     */
+    uint32_t addTexture(const std::string& filename);
+
+    /**
+     * @brief      Starts reading the finer levels in the background.
+     */
+    void start();
+
+    /**
+     * @brief      Makes the levels read since the last update resident.
+     *
+     * @return     The number of levels that became resident.
+     */
+    uint32_t update();
+
+    /**
+     * @brief      Marks the end of a frame, drawn with the resident levels.
+     */
+    void endFrame();
+
+    bool isComplete() const;
+
+    uint32_t getTextureCount() const;
+    BlockCompress::Format getFormat(uint32_t texture) const;
+    uint32_t getMipCount(uint32_t texture) const;
+
+    /**
+     * @brief      Returns the finest resident level, the minimum LOD the sampler is clamped to.
+     */
+    uint32_t getMinLod(uint32_t texture) const;
+
+    /**
+     * @brief      Returns a resident level, mip must not be finer than getMinLod().
+     */
+    const Level& getLevel(uint32_t texture, uint32_t mip) const;
+
+    const Stats& getStats() const;
+
+    void draw();
+    void logStats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Texture {
+        std::string filename;
+        BlockCompress::Format format;
+        std::vector<MipFormat::Level> table;
+
+        // A level belongs to the streaming thread until it is resident
+        std::vector<Level> levels;
+        uint32_t residentMip;
+    };
+
+    void stream();
+
+private:
+    uint64_t _bytesPerSecond;
+    Clock::time_point _start;
+
+    std::vector<Texture> _textures;
+    uint32_t _pendingLevelCount{0};
+
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _stopCondition;
+    bool _stop{false};
+
+    // The levels read and not yet resident, guarded by _mutex
+    std::vector<std::pair<uint32_t, uint32_t>> _readLevels;
+    uint32_t _failedTextureCount{0};
+
+    Stats _stats{-1.0, -1.0, 0.0, 0, 0, 0, 0};
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+/**
+ * @brief      Frame timing overlay drawn with ImGui.
+ *
+ *             Every frame pushes a record in a fixed size ring buffer: the frame time, the CPU
+ *             time of the sections the sample declared and the value of its counters. Nothing is
+ *             allocated after the construction, and the whole buffer can be dumped to CSV.
+ */
+class PerfOverlay {
+public:
+    static constexpr uint32_t maxSections = 8;
+    static constexpr uint32_t maxCounters = 8;
+    static constexpr uint32_t invalidIndex = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @brief      Measures a section from its construction to its destruction.
+     */
+    class ScopedSection {
+    public:
+        ScopedSection(PerfOverlay& overlay, uint32_t section);
+
+        ScopedSection(const ScopedSection&) = delete;
+        ScopedSection(ScopedSection&&) = delete;
+
+        ScopedSection& operator=(const ScopedSection&) = delete;
+        ScopedSection& operator=(ScopedSection&&) = delete;
+
+        ~ScopedSection();
+
+    private:
+        PerfOverlay& _overlay;
+        uint32_t _section;
+        std::chrono::high_resolution_clock::time_point _start;
+    };
+
+public:
+    /**
+     * @param[in]  capacity  The number of frames recorded, at least 1.
+     */
+    explicit PerfOverlay(uint32_t capacity = 512);
+
+    PerfOverlay(const PerfOverlay&) = delete;
+    PerfOverlay(PerfOverlay&&) = delete;
+
+    PerfOverlay& operator=(const PerfOverlay&) = delete;
+    PerfOverlay& operator=(PerfOverlay&&) = delete;
+
+    ~PerfOverlay() = default;
+
+    /**
+     * @brief      Declares a section, or a counter. Must be done before the first frame.
+     *
+     * @return     The identifier to pass to ScopedSection or setCounter, invalidIndex if there
+     *             are already maxSections or maxCounters. The invalid index is ignored.
+     */
+    uint32_t addSection(const std::string& name);
+    uint32_t addCounter(const std::string& name);
+
+    /**
+     * @brief      Starts the record of a new frame.
+     *
+     * @param[in]  frameMilliseconds  The duration of the previous frame.
+     */
+    void beginFrame(float frameMilliseconds);
+
+    void addSectionTime(uint32_t section, float milliseconds);
+    void setCounter(uint32_t counter, uint64_t value);
+
+    /**
+     * @brief      Draws the overlay window, if visible.
+     */
+    void draw() const;
+
+    void toggle();
+    bool isVisible() const;
+
+    /**
+     * @brief      Writes the records, oldest first, to a CSV file.
+     */
+    bool dumpCsv(const std::string& filename) const;
+
+private:
+    struct Record {
+        float frameMilliseconds;
+        float sectionMilliseconds[maxSections];
+        uint64_t counters[maxCounters];
+    };
+
+    // Index of the i-th oldest record
+    uint32_t getRecordIndex(uint32_t i) const;
+
+private:
+    std::vector<Record> _records;
+    uint32_t _head;
+    uint32_t _count{0};
+
+    std::vector<std::string> _sections;
+    std::vector<std::string> _counters;
+
+    bool _visible{false};
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief      The conversions of the texels done while building a texture: RGB to RGBA expansion,
+ *             8 bits to linear floats and back (through the sRGB curve for the color channels),
+ *             and the 2x2 box downsampling of a mip level.
+ *
+ *             Each conversion has a scalar path and vectorized ones, the best path the CPU supports
+ *             is picked at runtime on x86 (SSE4.1, AVX2), NEON is used when built for it. All the
+ *             paths give the same results.
+ *
+ *             The texels are RGBA, row by row, alpha is always linear.
+ */
+namespace PixelConvert {
+
+enum class Path : uint8_t {
+    Scalar,
+    Sse41,
+    Avx2,
+    Neon
+};
+
+bool isSupported(Path path);
+
+/**
+ * @brief      Returns the fastest supported path.
+ */
+Path getBestPath();
+
+const char* getName(Path path);
+
+/**
+ * @brief      Expands RGB8 texels to RGBA8, with an opaque alpha.
+ */
+void rgbToRgba(const uint8_t* rgb, uint8_t* rgba, size_t pixelCount, Path path = getBestPath());
+
+/**
+ * @brief      Converts RGBA8 texels to linear floats, from [0, 255] to [0, 1].
+ *
+ * @param[in]  srgb  Whether the color channels are sRGB encoded.
+ */
+void decode(const uint8_t* rgba, float* linear, size_t pixelCount, bool srgb, Path path = getBestPath());
+
+/**
+ * @brief      Converts linear floats to RGBA8 texels, clamped to [0, 1] and rounded to the nearest.
+ *
+ * @param[in]  srgb  Whether to encode the color channels with the sRGB curve.
+ */
+void encode(const float* linear, uint8_t* rgba, size_t pixelCount, bool srgb, Path path = getBestPath());
+
+/**
+ * @brief      Averages the 2x2 blocks of a level of linear texels into the next one.
+ *
+ *             The next level is max(1, width / 2) x max(1, height / 2), the last row and column
+ *             of an odd level are dropped.
+ */
+void downsample(const float* source, uint32_t width, uint32_t height, float* destination, Path path = getBestPath());
+
+} // PixelConvert
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <lug/Graphics/Render/Mesh.hpp>
+#include <lug/Graphics/Renderer.hpp>
+#include <lug/Math/Vector.hpp>
+
+/**
+ * @brief      The meshes the samples generate instead of loading.
+ */
+namespace ProceduralMesh {
+
+/**
+ * @brief      Builds a cube of side 2 centered on the origin, each face of its own color.
+ *
+ * @return     The mesh, null if it can't be built.
+ */
+lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Mesh> buildCube(lug::Graphics::Renderer& renderer);
+
+/**
+ * @brief      Generates the vertices of a unit UV sphere, (xSegments + 1) * (ySegments + 1) of them, row by row.
+ */
+void generateSphere(
+    uint32_t xSegments,
+    uint32_t ySegments,
+    std::vector<lug::Math::Vec3f>& positions,
+    std::vector<lug::Math::Vec3f>& normals,
+    std::vector<lug::Math::Vec2f>& uvs
+);
+
+/**
+ * @brief      Generates the triangle list of the unit UV sphere of generateSphere, two triangles per segment.
+ */
+void generateSphereTriangles(uint32_t xSegments, uint32_t ySegments, std::vector<uint16_t>& indices);
+
+/**
+ * @brief      Builds a unit UV sphere as a single triangle strip.
+ *
+ * @return     The mesh, null if it can't be built.
+ */
+lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Mesh> buildSphere(lug::Graphics::Renderer& renderer, uint32_t xSegments, uint32_t ySegments);
+
+} // ProceduralMesh
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief      Reads the resources of a sample from the mounted archives, or from the files
+ *             next to the executable if no archive has them.
+ *
+ *             The engine loads its resources (the glTF scenes, the textures) itself, only the
+ *             files the samples read directly go through it.
+ */
+namespace ResourceFileSystem {
+
+struct File {
+    const uint8_t* data{nullptr};
+    size_t size{0};
+
+    // Holds the content when it can't point in a mapped archive
+    std::vector<uint8_t> buffer;
+};
+
+struct Stats {
+    uint32_t readCount;
+    uint32_t archiveReadCount;
+    uint32_t fileOpenCount;
+    uint64_t bytes;
+    double milliseconds;
+};
+
+/**
+ * @brief      Mounts an archive, looked up before the ones mounted before it.
+ */
+bool mount(const std::string& filename);
+void unmountAll();
+
+bool read(const std::string& path, File& file);
+
+const Stats& getStats();
+
+} // ResourceFileSystem
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <string>
+
+#include <lug/Core/Application.hpp>
+#include <lug/Core/FreeMovement.hpp>
+#include <lug/Graphics/Scene/Node.hpp>
+
+#include "FramePacer.hpp"
+#include "InputRecording.hpp"
+#include "PerfOverlay.hpp"
+
+/**
+ * @brief      Base of the applications of the samples 04 to 09.
+ *
+ *             Reads the arguments common to these samples:
+ *             --perf-csv <file>      writes the performance records to the file on close
+ *             --record-input <file>  records the input and the camera poses to the file on close
+ *             --replay-input <file>  replays a recording instead of reading the mouse and the keyboard
+ *             and the frame pacing ones of FramePacer.
+ *
+ *             Each frame is paced and measured, the camera is moved, then the sample does its
+ *             own work in onSampleFrame before the performance overlay is drawn. F3 toggles the
+ *             overlay.
+ */
+class SampleApplication : public ::lug::Core::Application {
+public:
+    explicit SampleApplication(const lug::Core::Application::Info& info);
+
+    SampleApplication(const SampleApplication&) = delete;
+    SampleApplication(SampleApplication&&) = delete;
+
+    SampleApplication& operator=(const SampleApplication&) = delete;
+    SampleApplication& operator=(SampleApplication&&) = delete;
+
+    ~SampleApplication() override = default;
+
+    /**
+     * @brief      Initializes the engine and reads the common arguments, first thing in the init
+     *             of the samples.
+     */
+    bool init(int argc, char* argv[]);
+
+    void onEvent(const lug::Window::Event& event) override final;
+    void onFrame(const lug::System::Time& elapsedTime) override final;
+
+protected:
+    /**
+     * @brief      Moves the node of the camera with the mouse and the keyboard, or along the
+     *             poses of the replay.
+     */
+    void setMovedCamera(lug::Graphics::Scene::Node& node);
+
+    /**
+     * @brief      Returns the time the simulation of the sample advances by: the frame time, or the
+     *             recorded one during a replay.
+     */
+    lug::System::Time getSimulationTime(const lug::System::Time& elapsedTime) const;
+
+    /**
+     * @brief      The work of the sample in a frame, after the camera moved.
+     */
+    virtual void onSampleFrame(const lug::System::Time& elapsedTime) = 0;
+
+    /**
+     * @brief      Called when the window is closed, after the common records are written.
+     */
+    virtual void onClose() {}
+
+protected:
+    PerfOverlay _perfOverlay;
+    FramePacer _framePacer;
+
+private:
+    void updateMovement(const lug::System::Time& elapsedTime);
+
+private:
+    lug::Core::FreeMovement _mover;
+    lug::Graphics::Scene::Node* _movedCamera{nullptr};
+
+    std::string _perfCsvFilename;
+    uint32_t _perfUpdateSection;
+
+    std::string _recordInputFilename;
+    InputRecording::Recorder _inputRecorder;
+    InputRecording::Replay _inputReplay;
+};
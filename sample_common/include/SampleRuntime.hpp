@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+
+#include <lug/System/Logger/Logger.hpp>
+
+#include "Trace.hpp"
+
+/**
+ * @brief      The main of the samples.
+ *
+ *             --trace <file>       records the trace zones and writes them to the file
+ *             --log-sync           logs from the calling thread, for the samples using the asynchronous handler
+ *             --log-drop           drops the messages instead of blocking when the log queue is full
+ *             --benchmark-logging  compares the handlers and exits
+ */
+namespace SampleRuntime {
+
+enum class Logging : uint8_t {
+    Sync, // The StdoutHandler
+    Async // The AsyncHandler, except with --log-sync
+};
+
+/**
+ * @brief      Installs the log handler and starts the trace.
+ *
+ * @return     False if the sample must not run (the logging benchmark ran instead).
+ */
+bool begin(int argc, char* argv[], Logging logging = Logging::Sync);
+
+/**
+ * @brief      Writes the trace.
+ */
+void end();
+
+template <typename T>
+int run(int argc, char* argv[], Logging logging = Logging::Sync) {
+    if (!begin(argc, argv, logging)) {
+        return 0;
+    }
+
+    T app;
+
+    bool initialized;
+
+    {
+        SAMPLE_TRACE_ZONE("init");
+        initialized = app.init(argc, argv);
+    }
+
+    // The trace of a failed init is written too
+    if (!initialized) {
+        end();
+        return 1;
+    }
+
+    const bool success = app.run();
+
+    end();
+
+    return success ? 0 : 1;
+}
+
+} // SampleRuntime
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <lug/Graphics/Renderer.hpp>
+#include <lug/Graphics/Scene/Scene.hpp>
+#include <lug/Math/Vector.hpp>
+
+/**
+ * @brief      The cameras and the lights set up the same way by the samples.
+ */
+namespace SampleScene {
+
+/**
+ * @brief      Builds a camera (45 degrees of vertical field of view, from 0.1 to 100), attaches it
+ *             to a new node of the root and to a render view of the window.
+ *
+ * @param[in]  name             The name of the node.
+ * @param[in]  renderViewIndex  The render view that displays the camera.
+ *
+ * @return     The node of the camera, null if it can't be created.
+ */
+lug::Graphics::Scene::Node* attachCamera(lug::Graphics::Renderer& renderer, lug::Graphics::Scene::Scene& scene, const std::string& name, uint32_t renderViewIndex);
+
+bool attachAmbientLight(lug::Graphics::Renderer& renderer, lug::Graphics::Scene::Scene& scene, const lug::Math::Vec4f& color);
+
+/**
+ * @brief      Attaches four bright point lights at the corners of a square in front of the origin,
+ *             the lighting of the PBR samples. The nodes are named "light0" to "light3".
+ */
+bool attachPointLights(lug::Graphics::Renderer& renderer, lug::Graphics::Scene::Scene& scene);
+
+} // SampleScene
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <initializer_list>
+
+/**
+ * @brief      The helpers of the tests of the samples, small executables run by ctest that check
+ *             the CPU side of a sample.
+ */
+namespace SampleTest {
+
+struct Test {
+    const char* name;
+    bool (*function)();
+};
+
+/**
+ * @brief      Prints the message if the condition is false.
+ *
+ * @return     The condition.
+ */
+bool check(bool condition, const char* message);
+
+/**
+ * @brief      Runs all the tests, even after one failed, and prints their result.
+ *
+ * @return     The exit code of the test executable: 0 if all of them passed, 1 otherwise.
+ */
+int run(std::initializer_list<Test> tests);
+
+} // SampleTest
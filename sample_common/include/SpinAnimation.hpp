@@ -0,0 +1,41 @@
+#pragma once
+
+#include "FramePacer.hpp"
+
+/**
+ * @brief      The angle of a node spinning at a constant speed.
+ *
+ *             With the fixed step mode of the frame pacer the angle advances by its ticks and the
+ *             rendered one is interpolated between the last two, otherwise it advances by the
+ *             frame time.
+ */
+class SpinAnimation {
+public:
+    /**
+     * @param[in]  speed  The speed, in radians per second.
+     */
+    explicit SpinAnimation(float speed);
+
+    SpinAnimation(const SpinAnimation&) = delete;
+    SpinAnimation(SpinAnimation&&) = delete;
+
+    SpinAnimation& operator=(const SpinAnimation&) = delete;
+    SpinAnimation& operator=(SpinAnimation&&) = delete;
+
+    ~SpinAnimation() = default;
+
+    /**
+     * @brief      Advances the animation.
+     *
+     * @return     The angle to rotate the node by since the last update, in radians.
+     */
+    float update(FramePacer& framePacer, float elapsedSeconds);
+
+private:
+    float _speed;
+
+    // Simulated angle at the last two ticks, and angle of the node
+    float _angle{0.0f};
+    float _previousAngle{0.0f};
+    float _renderedAngle{0.0f};
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include <lug/Graphics/Render/Texture.hpp>
+#include <lug/Graphics/Renderer.hpp>
+#include <lug/Graphics/Resource.hpp>
+
+/**
+ * @brief      Shares the textures loaded from the same file with the same settings.
+ *
+ *             The textures are keyed by their canonical path, "textures/./a.jpg" and "textures/a.jpg"
+ *             are the same, and by the settings of their sampler. Resource::SharedPtr has no weak
+ *             counterpart, the cache holds a reference to each texture until it is cleared.
+ */
+class TextureCache {
+public:
+    struct Settings {
+        lug::Graphics::Render::Texture::Filter minFilter{lug::Graphics::Render::Texture::Filter::Linear};
+        lug::Graphics::Render::Texture::Filter magFilter{lug::Graphics::Render::Texture::Filter::Linear};
+    };
+
+    struct Stats {
+        uint32_t hitCount;
+        uint32_t missCount;
+        uint64_t loadedBytes;
+        uint64_t savedBytes; // The bytes the hits would have uploaded again
+    };
+
+public:
+    TextureCache() = default;
+
+    TextureCache(const TextureCache&) = delete;
+    TextureCache(TextureCache&&) = delete;
+
+    TextureCache& operator=(const TextureCache&) = delete;
+    TextureCache& operator=(TextureCache&&) = delete;
+
+    ~TextureCache() = default;
+
+    /**
+     * @brief      Returns the texture of a file, built with Builder::Texture the first time.
+     *
+     * @return     The texture, null if it can't be built.
+     */
+    lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Texture> load(lug::Graphics::Renderer& renderer, const std::string& filename, const Settings& settings);
+    lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Texture> load(lug::Graphics::Renderer& renderer, const std::string& filename);
+
+    /**
+     * @brief      Drops the references of the cache, the textures live as long as their users.
+     */
+    void clear();
+
+    uint32_t getTextureCount() const;
+    const Stats& getStats() const;
+
+    void logStats() const;
+
+    /**
+     * @brief      Returns a path with forward slashes, without "." and resolved ".." components.
+     */
+    static std::string canonicalize(const std::string& path);
+
+private:
+    struct Entry {
+        lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Texture> texture;
+        uint64_t size;
+    };
+
+    std::unordered_map<std::string, Entry> _entries;
+
+    Stats _stats{};
+};
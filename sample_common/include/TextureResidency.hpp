@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <list>
+#include <string>
+#include <vector>
+
+/**
+ * @brief      Decides which mip levels of the textures are resident, within a byte budget.
+ *
+ *             The mip tail of each texture (the levels of at most tailSize texels) is resident
+ *             from its registration to the end. The finer levels are streamed in, finest last,
+ *             down to the level matching the largest projected size the texture was requested
+ *             with in the frame. When the budget is full, the levels finer than needed are
+ *             evicted from the least recently used textures first, finest first.
+ *
+ *             The memory comes from an Allocator, FakeAllocator counts the bytes on the CPU.
+ */
+class TextureResidency {
+public:
+    static constexpr uint32_t tailSize = 128;
+    static constexpr uint32_t invalidTexture = std::numeric_limits<uint32_t>::max();
+
+    class Allocator {
+    public:
+        virtual ~Allocator() = default;
+
+        /**
+         * @brief      Backs a mip level, or the whole mip tail of a texture.
+         *
+         * @return     False if there is no memory left.
+         */
+        virtual bool allocate(uint32_t texture, uint32_t mip, uint64_t size) = 0;
+        virtual void release(uint32_t texture, uint32_t mip, uint64_t size) = 0;
+    };
+
+    class FakeAllocator : public Allocator {
+    public:
+        explicit FakeAllocator(uint64_t capacity = std::numeric_limits<uint64_t>::max());
+
+        bool allocate(uint32_t texture, uint32_t mip, uint64_t size) override;
+        void release(uint32_t texture, uint32_t mip, uint64_t size) override;
+
+        uint64_t getAllocatedBytes() const;
+        uint64_t getAllocationCount() const;
+
+    private:
+        uint64_t _capacity;
+        uint64_t _allocatedBytes{0};
+        uint64_t _allocationCount{0};
+    };
+
+    struct Stats {
+        uint64_t residentBytes;
+        uint64_t peakResidentBytes;
+        uint64_t tailBytes;
+        uint32_t residentMipCount;
+
+        uint64_t streamedBytes;
+        uint32_t streamedMipCount;
+
+        uint64_t evictedBytes;
+        uint32_t evictionCount;
+
+        uint32_t budgetLimitedCount;   // Levels not streamed in as the budget was full of needed ones
+        uint32_t failedAllocationCount;
+    };
+
+public:
+    /**
+     * @param      allocator             Backs the resident levels, must outlive the manager.
+     * @param[in]  budget                The bytes the resident levels can use, the mip tails included.
+     * @param[in]  streamBytesPerUpdate  The bytes that can be streamed in by one update.
+     */
+    TextureResidency(Allocator& allocator, uint64_t budget, uint64_t streamBytesPerUpdate);
+
+    TextureResidency(const TextureResidency&) = delete;
+    TextureResidency(TextureResidency&&) = delete;
+
+    TextureResidency& operator=(const TextureResidency&) = delete;
+    TextureResidency& operator=(TextureResidency&&) = delete;
+
+    ~TextureResidency();
+
+    /**
+     * @brief      Registers a texture and makes its mip tail resident.
+     *
+     * @return     The identifier of the texture, invalidTexture if its mip tail can't be allocated.
+     */
+    uint32_t addTexture(const std::string& name, uint32_t width, uint32_t height, uint32_t bytesPerTexel);
+
+    /**
+     * @brief      Requests a texture for the current frame.
+     *
+     * @param[in]  texture  The texture.
+     * @param[in]  pixels   The number of screen pixels its width spans, the largest of the frame is kept.
+     */
+    void request(uint32_t texture, float pixels);
+
+    /**
+     * @brief      Ends the frame: streams in the requested levels and evicts to make room for them.
+     *
+     * @param[in]  elapsedSeconds  The frame time, for the streaming bandwidth.
+     */
+    void update(float elapsedSeconds);
+
+    uint32_t getTextureCount() const;
+    uint32_t getMipCount(uint32_t texture) const;
+
+    /**
+     * @brief      Returns the finest resident level, the minimum LOD the sampler of the texture is clamped to.
+     */
+    uint32_t getResidentMip(uint32_t texture) const;
+    uint32_t getWantedMip(uint32_t texture) const;
+
+    uint64_t getBudget() const;
+    const Stats& getStats() const;
+
+    /**
+     * @brief      Returns the streaming bandwidth averaged over the last second, in bytes per second.
+     */
+    float getBandwidth() const;
+
+    /**
+     * @brief      Returns the number of pixels spanned by the width of a texture mapped once around a sphere.
+     */
+    static float getSpherePixels(float radius, float distance, float fovY, float viewportHeight);
+
+    void draw();
+    void logStats() const;
+
+private:
+    struct Texture {
+        std::string name;
+        uint32_t width;
+        uint32_t height;
+        uint32_t bytesPerTexel;
+
+        uint32_t mipCount;
+        uint32_t tailMip;     // The coarsest levels, from tailMip, are always resident
+        uint32_t residentMip;
+        uint32_t wantedMip;
+
+        float requestedPixels;
+    };
+
+    uint64_t getMipSize(const Texture& texture, uint32_t mip) const;
+
+    void touch(uint32_t texture);
+    bool makeRoom(uint64_t size);
+    void evictMip(uint32_t texture);
+
+private:
+    Allocator& _allocator;
+    uint64_t _budget;
+    uint64_t _streamBytesPerUpdate;
+
+    std::vector<Texture> _textures;
+
+    // Most recently requested first
+    std::list<uint32_t> _lru;
+    std::vector<std::list<uint32_t>::iterator> _lruPositions;
+
+    Stats _stats{};
+    float _bandwidth{0.0f};
+};
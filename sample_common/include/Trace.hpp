@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// The time stamp counter is much cheaper to read than the system clocks
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+
+    #define SAMPLE_TRACE_TSC
+#endif
+
+/**
+ * @brief      Scoped zones recorded in the Chrome trace event format.
+ *
+ *             Each thread appends its zones to its own buffer, made of chunks of 1024 events
+ *             allocated as it fills up. The first zone of a thread takes a lock to register its
+ *             buffer and allocates it, the following ones take no lock and allocate once per
+ *             chunk. Zone names must be string literals, only the pointer is stored.
+ *             When SAMPLE_TRACE is not defined the macros compile to nothing.
+ */
+namespace Trace {
+
+/**
+ * @brief      Starts recording.
+ *
+ * @param[in]  eventsPerThread  The maximum number of events of each thread, events past it are dropped.
+ */
+void start(uint32_t eventsPerThread = 1 << 16);
+
+/**
+ * @brief      Names the calling thread in the trace.
+ */
+void setThreadName(const char* name);
+
+/**
+ * @brief      Writes the events recorded so far, the threads may still be recording.
+ */
+bool write(const std::string& filename);
+
+namespace priv {
+
+extern std::atomic<bool> enabled;
+
+// In ticks, converted to time when the trace is written
+inline uint64_t now() {
+#if defined(SAMPLE_TRACE_TSC)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void record(const char* name, uint64_t begin, uint64_t end);
+
+} // priv
+
+class Zone {
+public:
+    explicit Zone(const char* name) : _name(priv::enabled.load(std::memory_order_relaxed) ? name : nullptr), _begin(_name ? priv::now() : 0) {}
+
+    Zone(const Zone&) = delete;
+    Zone(Zone&&) = delete;
+
+    Zone& operator=(const Zone&) = delete;
+    Zone& operator=(Zone&&) = delete;
+
+    ~Zone() {
+        if (_name) {
+            priv::record(_name, _begin, priv::now());
+        }
+    }
+
+private:
+    const char* _name;
+    uint64_t _begin;
+};
+
+} // Trace
+
+#define SAMPLE_TRACE_CONCAT_IMPL(a, b) a##b
+#define SAMPLE_TRACE_CONCAT(a, b) SAMPLE_TRACE_CONCAT_IMPL(a, b)
+
+#if defined(SAMPLE_TRACE)
+    #define SAMPLE_TRACE_ZONE(name) ::Trace::Zone SAMPLE_TRACE_CONCAT(traceZone, __LINE__)(name)
+    #define SAMPLE_TRACE_THREAD_NAME(name) ::Trace::setThreadName(name)
+#else
+    #define SAMPLE_TRACE_ZONE(name) (void)0
+    #define SAMPLE_TRACE_THREAD_NAME(name) (void)0
+#endif
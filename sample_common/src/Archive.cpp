@@ -0,0 +1,217 @@
+#include "Archive.hpp"
+
+#include <cstring>
+
+#if defined(LUG_SYSTEM_WINDOWS)
+    #define NOMINMAX
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <lug/System/Logger/Logger.hpp>
+
+#include "ArchiveFormat.hpp"
+#include "Lz4.hpp"
+
+namespace {
+
+bool fits(uint64_t offset, uint64_t size, uint64_t total) {
+    return offset <= total && size <= total - offset;
+}
+
+} // anonymous
+
+Archive::~Archive() {
+    close();
+}
+
+bool Archive::open(const std::string& filename) {
+    close();
+
+#if defined(LUG_SYSTEM_WINDOWS)
+    _file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (_file == INVALID_HANDLE_VALUE) {
+        _file = nullptr;
+        LUG_LOG.error("Archive: Can't open {}", filename);
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(_file, &fileSize) || !fileSize.QuadPart) {
+        LUG_LOG.error("Archive: Can't get the size of {}", filename);
+        close();
+        return false;
+    }
+
+    _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = _mapping ? MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+    if (!view) {
+        LUG_LOG.error("Archive: Can't map {}", filename);
+        close();
+        return false;
+    }
+
+    _data = static_cast<const uint8_t*>(view);
+    _size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+
+    if (fd == -1) {
+        LUG_LOG.error("Archive: Can't open {}", filename);
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) == -1 || !status.st_size) {
+        LUG_LOG.error("Archive: Can't get the size of {}", filename);
+        ::close(fd);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping keeps the file alive
+    ::close(fd);
+
+    if (view == MAP_FAILED) {
+        LUG_LOG.error("Archive: Can't map {}", filename);
+        return false;
+    }
+
+    _data = static_cast<const uint8_t*>(view);
+    _size = static_cast<size_t>(status.st_size);
+#endif
+
+    _header = reinterpret_cast<const ArchiveFormat::Header*>(_data);
+
+    if (_size < sizeof(ArchiveFormat::Header)
+        || std::memcmp(_header->magic, ArchiveFormat::magic, sizeof(ArchiveFormat::magic)) != 0
+        || _header->version != ArchiveFormat::version) {
+        LUG_LOG.error("Archive: {} is not a resource archive of version {}", filename, ArchiveFormat::version);
+        close();
+        return false;
+    }
+
+    if (!_header->bucketCount || (_header->bucketCount & (_header->bucketCount - 1))
+        || _header->bucketsOffset % alignof(uint32_t) || _header->entriesOffset % alignof(ArchiveFormat::Entry)
+        || !fits(_header->bucketsOffset, uint64_t(_header->bucketCount) * sizeof(uint32_t), _size)
+        || !fits(_header->entriesOffset, uint64_t(_header->entryCount) * sizeof(ArchiveFormat::Entry), _size)
+        || !fits(_header->pathsOffset, _header->pathsSize, _size)) {
+        LUG_LOG.error("Archive: The index of {} is corrupted", filename);
+        close();
+        return false;
+    }
+
+    _buckets = reinterpret_cast<const uint32_t*>(_data + _header->bucketsOffset);
+    _entries = reinterpret_cast<const ArchiveFormat::Entry*>(_data + _header->entriesOffset);
+    _paths = reinterpret_cast<const char*>(_data + _header->pathsOffset);
+
+    return true;
+}
+
+void Archive::close() {
+#if defined(LUG_SYSTEM_WINDOWS)
+    if (_data) {
+        UnmapViewOfFile(_data);
+    }
+
+    if (_mapping) {
+        CloseHandle(_mapping);
+        _mapping = nullptr;
+    }
+
+    if (_file) {
+        CloseHandle(_file);
+        _file = nullptr;
+    }
+#else
+    if (_data) {
+        munmap(const_cast<uint8_t*>(_data), _size);
+    }
+#endif
+
+    _data = nullptr;
+    _size = 0;
+    _header = nullptr;
+    _buckets = nullptr;
+    _entries = nullptr;
+    _paths = nullptr;
+}
+
+bool Archive::contains(const std::string& path) const {
+    return find(path) != nullptr;
+}
+
+bool Archive::read(const std::string& path, std::vector<uint8_t>& buffer, const uint8_t*& data, size_t& size) const {
+    const ArchiveFormat::Entry* entry = find(path);
+
+    if (!entry) {
+        return false;
+    }
+
+    if (!fits(entry->offset, entry->storedSize, _size)) {
+        LUG_LOG.error("Archive: The entry {} is out of the archive", path);
+        return false;
+    }
+
+    if (!(entry->flags & ArchiveFormat::EntryFlags::Compressed)) {
+        data = _data + entry->offset;
+        size = static_cast<size_t>(entry->size);
+        return entry->size == entry->storedSize;
+    }
+
+    buffer.resize(static_cast<size_t>(entry->size));
+
+    if (!Lz4::decompress(_data + entry->offset, static_cast<size_t>(entry->storedSize), buffer.data(), buffer.size())) {
+        LUG_LOG.error("Archive: The entry {} is corrupted", path);
+        return false;
+    }
+
+    data = buffer.data();
+    size = buffer.size();
+
+    return true;
+}
+
+uint32_t Archive::getEntryCount() const {
+    return _header ? _header->entryCount : 0;
+}
+
+const ArchiveFormat::Entry* Archive::find(const std::string& path) const {
+    if (!_header) {
+        return nullptr;
+    }
+
+    const uint64_t hash = ArchiveFormat::hashPath(path);
+    const uint32_t mask = _header->bucketCount - 1;
+
+    uint32_t bucket = static_cast<uint32_t>(hash) & mask;
+
+    for (uint32_t probe = 0; probe < _header->bucketCount; ++probe) {
+        const uint32_t index = _buckets[bucket];
+
+        if (!index || index > _header->entryCount) {
+            return nullptr;
+        }
+
+        const ArchiveFormat::Entry& entry = _entries[index - 1];
+
+        if (entry.pathHash == hash
+            && entry.pathLength == path.size()
+            && fits(entry.pathOffset, entry.pathLength, _header->pathsSize)
+            && std::memcmp(_paths + entry.pathOffset, path.data(), path.size()) == 0) {
+            return &entry;
+        }
+
+        bucket = (bucket + 1) & mask;
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,138 @@
+#include "ArchiveWriter.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "ArchiveFormat.hpp"
+#include "Lz4.hpp"
+
+namespace {
+
+uint64_t align(uint64_t offset) {
+    return (offset + ArchiveFormat::dataAlignment - 1) & ~(ArchiveFormat::dataAlignment - 1);
+}
+
+} // anonymous
+
+bool ArchiveWriter::add(const std::string& path, std::vector<uint8_t> data, bool compress) {
+    const auto sameFile = [&path](const File& file) {
+        return file.path == path;
+    };
+
+    if (std::find_if(_files.begin(), _files.end(), sameFile) != _files.end()) {
+        return false;
+    }
+
+    File file{path, data.size(), false, {}};
+
+    if (compress && !data.empty()) {
+        std::vector<uint8_t> compressed(Lz4::getMaxCompressedSize(data.size()));
+        compressed.resize(Lz4::compress(data.data(), data.size(), compressed.data()));
+
+        if (compressed.size() <= data.size() - data.size() / 8) {
+            file.compressed = true;
+            data = std::move(compressed);
+        }
+    }
+
+    file.data = std::move(data);
+    _files.push_back(std::move(file));
+
+    return true;
+}
+
+bool ArchiveWriter::write(const std::string& filename) const {
+    const uint32_t entryCount = static_cast<uint32_t>(_files.size());
+
+    // At most half full, the probes stay short
+    uint32_t bucketCount = 1;
+    while (bucketCount < entryCount * 2) {
+        bucketCount *= 2;
+    }
+
+    ArchiveFormat::Header header{};
+    std::memcpy(header.magic, ArchiveFormat::magic, sizeof(header.magic));
+    header.version = ArchiveFormat::version;
+    header.entryCount = entryCount;
+    header.bucketCount = bucketCount;
+    header.bucketsOffset = sizeof(ArchiveFormat::Header);
+    header.entriesOffset = header.bucketsOffset + bucketCount * sizeof(uint32_t);
+    header.pathsOffset = header.entriesOffset + entryCount * sizeof(ArchiveFormat::Entry);
+
+    std::vector<uint32_t> buckets(bucketCount, 0);
+    std::vector<ArchiveFormat::Entry> entries(entryCount);
+    std::string paths;
+
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        const File& file = _files[i];
+        ArchiveFormat::Entry& entry = entries[i];
+
+        entry.pathHash = ArchiveFormat::hashPath(file.path);
+        entry.size = file.size;
+        entry.storedSize = file.data.size();
+        entry.pathOffset = static_cast<uint32_t>(paths.size());
+        entry.pathLength = static_cast<uint32_t>(file.path.size());
+        entry.flags = file.compressed ? static_cast<uint32_t>(ArchiveFormat::EntryFlags::Compressed) : 0;
+
+        paths += file.path;
+
+        uint32_t bucket = static_cast<uint32_t>(entry.pathHash) & (bucketCount - 1);
+        while (buckets[bucket]) {
+            bucket = (bucket + 1) & (bucketCount - 1);
+        }
+
+        buckets[bucket] = i + 1;
+    }
+
+    header.pathsSize = paths.size();
+
+    uint64_t offset = align(header.pathsOffset + header.pathsSize);
+    for (ArchiveFormat::Entry& entry : entries) {
+        entry.offset = offset;
+        offset = align(offset + entry.storedSize);
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+
+    if (!file) {
+        return false;
+    }
+
+    const char padding[ArchiveFormat::dataAlignment] = {};
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(buckets.data()), buckets.size() * sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(ArchiveFormat::Entry));
+    file.write(paths.data(), paths.size());
+
+    uint64_t position = header.pathsOffset + header.pathsSize;
+
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        file.write(padding, entries[i].offset - position);
+        file.write(reinterpret_cast<const char*>(_files[i].data.data()), _files[i].data.size());
+        position = entries[i].offset + entries[i].storedSize;
+    }
+
+    return static_cast<bool>(file);
+}
+
+uint64_t ArchiveWriter::getSize() const {
+    uint64_t size = 0;
+
+    for (const File& file : _files) {
+        size += file.size;
+    }
+
+    return size;
+}
+
+uint64_t ArchiveWriter::getStoredSize() const {
+    uint64_t size = 0;
+
+    for (const File& file : _files) {
+        size += file.data.size();
+    }
+
+    return size;
+}
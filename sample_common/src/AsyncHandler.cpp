@@ -0,0 +1,151 @@
+#include "AsyncHandler.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+constexpr size_t AsyncHandler::maxMessageSize;
+
+AsyncHandler::AsyncHandler(const std::string& name, std::ostream& ostream, OverflowPolicy policy, size_t capacity) :
+    lug::System::Logger::Handler(name), _ostream(ostream), _policy(policy), _start(std::chrono::steady_clock::now()) {
+    // The capacity is rounded up to a power of two
+    size_t size = 2;
+    while (size < capacity) {
+        size *= 2;
+    }
+
+    _slots.reset(new Slot[size]);
+    _mask = size - 1;
+
+    for (size_t i = 0; i < size; ++i) {
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    _thread = std::thread(&AsyncHandler::run, this);
+}
+
+AsyncHandler::~AsyncHandler() {
+    _stop.store(true, std::memory_order_release);
+    _thread.join();
+}
+
+void AsyncHandler::handle(const lug::System::Logger::priv::Message& msg) {
+    const auto timestamp = std::chrono::steady_clock::now();
+
+    // Reserve a slot, bounded queue of Dmitry Vyukov
+    size_t position = _enqueuePosition.value.load(std::memory_order_relaxed);
+    Slot* slot;
+
+    for (;;) {
+        slot = &_slots[position & _mask];
+
+        const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+        if (difference == 0) {
+            if (_enqueuePosition.value.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The ring is full
+            if (_policy == OverflowPolicy::Drop) {
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            std::this_thread::yield();
+            position = _enqueuePosition.value.load(std::memory_order_relaxed);
+        } else {
+            position = _enqueuePosition.value.load(std::memory_order_relaxed);
+        }
+    }
+
+    const size_t size = std::min(static_cast<size_t>(msg.formatted.size()), maxMessageSize);
+
+    slot->timestamp = timestamp;
+    slot->size = static_cast<uint32_t>(size);
+    std::memcpy(slot->text, msg.formatted.data(), size);
+
+    if (size < msg.formatted.size()) {
+        std::memcpy(slot->text + size - 4, "...\n", 4);
+    }
+
+    slot->sequence.store(position + 1, std::memory_order_release);
+}
+
+void AsyncHandler::flush() {
+    const size_t target = _enqueuePosition.value.load(std::memory_order_acquire);
+
+    while (_flushedPosition.load(std::memory_order_acquire) < target) {
+        std::this_thread::yield();
+    }
+}
+
+uint64_t AsyncHandler::getDroppedCount() const {
+    return _dropped.load(std::memory_order_relaxed);
+}
+
+void AsyncHandler::run() {
+    for (;;) {
+        // Read the flag before draining, nothing can be left behind once it is set
+        const bool stop = _stop.load(std::memory_order_acquire);
+        const size_t count = drain();
+
+        if (count) {
+            _ostream.flush();
+        }
+
+        _flushedPosition.store(_dequeuePosition.value.load(std::memory_order_relaxed), std::memory_order_release);
+
+        if (stop && !count) {
+            break;
+        }
+
+        if (!count) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+size_t AsyncHandler::drain() {
+    size_t count = 0;
+    size_t position = _dequeuePosition.value.load(std::memory_order_relaxed);
+
+    char prefix[32];
+
+    for (;;) {
+        Slot& slot = _slots[position & _mask];
+
+        if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+            break;
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(slot.timestamp - _start).count();
+        const int prefixSize = std::snprintf(prefix, sizeof(prefix), "[%6lld.%06lld] ", static_cast<long long>(elapsed / 1000000), static_cast<long long>(elapsed % 1000000));
+
+        _ostream.write(prefix, prefixSize);
+        _ostream.write(slot.text, slot.size);
+
+        if (!slot.size || slot.text[slot.size - 1] != '\n') {
+            _ostream.put('\n');
+        }
+
+        // Hand the slot back to the producers, one lap later
+        slot.sequence.store(position + _mask + 1, std::memory_order_release);
+
+        ++position;
+        ++count;
+    }
+
+    _dequeuePosition.value.store(position, std::memory_order_relaxed);
+
+    const uint64_t dropped = _dropped.load(std::memory_order_relaxed);
+
+    if (dropped != _reportedDropped) {
+        _ostream << "[AsyncHandler] " << dropped - _reportedDropped << " message(s) dropped\n";
+        _reportedDropped = dropped;
+        ++count;
+    }
+
+    return count;
+}
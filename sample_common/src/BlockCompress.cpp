@@ -0,0 +1,740 @@
+#include "BlockCompress.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <thread>
+
+#include "Trace.hpp"
+
+namespace BlockCompress {
+
+namespace {
+
+// The block rows are handed to the threads by groups
+constexpr uint32_t blockRowsPerJob = 4;
+
+// The weights of color0 and color1 for each index of a BC1 block
+constexpr float colorWeights[4][2] = {
+    {1.0f, 0.0f},
+    {0.0f, 1.0f},
+    {2.0f / 3.0f, 1.0f / 3.0f},
+    {1.0f / 3.0f, 2.0f / 3.0f}
+};
+
+void parallelFor(uint32_t count, uint32_t threadCount, const std::function<void(uint32_t)>& function) {
+    std::atomic<uint32_t> next{0};
+
+    const auto worker = [&next, count, &function]() {
+        SAMPLE_TRACE_ZONE("block compression job");
+
+        for (uint32_t i = next++; i < count; i = next++) {
+            function(i);
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (uint32_t i = 1; i < std::min(threadCount, count); ++i) {
+        threads.emplace_back([&worker]() {
+            SAMPLE_TRACE_THREAD_NAME("block compression worker");
+            worker();
+        });
+    }
+
+    worker();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+uint16_t packRgb565(const float color[3]) {
+    const auto quantize = [](float value, float maximum) {
+        return static_cast<uint32_t>(std::min(std::max(value, 0.0f), 255.0f) * maximum / 255.0f + 0.5f);
+    };
+
+    return static_cast<uint16_t>((quantize(color[0], 31.0f) << 11) | (quantize(color[1], 63.0f) << 5) | quantize(color[2], 31.0f));
+}
+
+void unpackRgb565(uint16_t packed, int32_t color[3]) {
+    const int32_t r = (packed >> 11) & 31;
+    const int32_t g = (packed >> 5) & 63;
+    const int32_t b = packed & 31;
+
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+// The last color of the three colors mode is transparent black
+void getColorPalette(uint16_t color0, uint16_t color1, bool fourColors, int32_t palette[4][4]) {
+    unpackRgb565(color0, palette[0]);
+    unpackRgb565(color1, palette[1]);
+
+    for (uint32_t c = 0; c < 3; ++c) {
+        if (fourColors) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        } else {
+            palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+            palette[3][c] = 0;
+        }
+    }
+
+    palette[0][3] = 255;
+    palette[1][3] = 255;
+    palette[2][3] = 255;
+    palette[3][3] = fourColors ? 255 : 0;
+}
+
+// Picks the nearest color of each texel, returns the squared error
+uint32_t fitColorIndices(const uint8_t pixels[16][4], uint16_t color0, uint16_t color1, uint32_t& indices) {
+    int32_t palette[4][4];
+    getColorPalette(color0, color1, true, palette);
+
+    uint32_t error = 0;
+    indices = 0;
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        uint32_t bestIndex = 0;
+        uint32_t bestError = std::numeric_limits<uint32_t>::max();
+
+        for (uint32_t index = 0; index < 4; ++index) {
+            uint32_t distance = 0;
+
+            for (uint32_t c = 0; c < 3; ++c) {
+                const int32_t difference = pixels[i][c] - palette[index][c];
+                distance += difference * difference;
+            }
+
+            if (distance < bestError) {
+                bestError = distance;
+                bestIndex = index;
+            }
+        }
+
+        indices |= bestIndex << (2 * i);
+        error += bestError;
+    }
+
+    return error;
+}
+
+// Solves the endpoints that minimize the error of the indices, false if the indices can't tell them apart
+bool solveColorEndpoints(const uint8_t pixels[16][4], uint32_t indices, float endpoints[2][3]) {
+    float aa = 0.0f;
+    float ab = 0.0f;
+    float bb = 0.0f;
+    float ax[3] = {0.0f, 0.0f, 0.0f};
+    float bx[3] = {0.0f, 0.0f, 0.0f};
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        const uint32_t index = (indices >> (2 * i)) & 3;
+        const float a = colorWeights[index][0];
+        const float b = colorWeights[index][1];
+
+        aa += a * a;
+        ab += a * b;
+        bb += b * b;
+
+        for (uint32_t c = 0; c < 3; ++c) {
+            ax[c] += a * pixels[i][c];
+            bx[c] += b * pixels[i][c];
+        }
+    }
+
+    const float determinant = aa * bb - ab * ab;
+
+    if (std::abs(determinant) < 1e-6f) {
+        return false;
+    }
+
+    for (uint32_t c = 0; c < 3; ++c) {
+        endpoints[0][c] = (ax[c] * bb - bx[c] * ab) / determinant;
+        endpoints[1][c] = (bx[c] * aa - ax[c] * ab) / determinant;
+    }
+
+    return true;
+}
+
+// Moves the 565 components of the endpoints by one step while the error goes down
+void searchColorEndpoints(const uint8_t pixels[16][4], uint16_t colors[2], uint32_t& indices, uint32_t& error) {
+    constexpr uint32_t shifts[3] = {11, 5, 0};
+    constexpr uint32_t masks[3] = {31, 63, 31};
+
+    for (uint32_t round = 0; round < 4 && error > 0; ++round) {
+        bool improved = false;
+
+        for (uint32_t endpoint = 0; endpoint < 2; ++endpoint) {
+            for (uint32_t c = 0; c < 3; ++c) {
+                for (int32_t step : {-1, 1}) {
+                    const int32_t component = ((colors[endpoint] >> shifts[c]) & masks[c]) + step;
+
+                    if (component < 0 || component > static_cast<int32_t>(masks[c])) {
+                        continue;
+                    }
+
+                    uint16_t candidates[2] = {colors[0], colors[1]};
+                    candidates[endpoint] = static_cast<uint16_t>((colors[endpoint] & ~(masks[c] << shifts[c])) | (component << shifts[c]));
+
+                    uint32_t candidateIndices;
+                    const uint32_t candidateError = fitColorIndices(pixels, candidates[0], candidates[1], candidateIndices);
+
+                    if (candidateError < error) {
+                        colors[0] = candidates[0];
+                        colors[1] = candidates[1];
+                        indices = candidateIndices;
+                        error = candidateError;
+                        improved = true;
+                    }
+                }
+            }
+        }
+
+        if (!improved) {
+            return;
+        }
+    }
+}
+
+// The endpoints of the BC1 blocks of a single color: for each 8 bits value, the pair of 5 or 6 bits
+// endpoints whose color 2, (2 * color0 + color1) / 3, is the nearest to it. The principal axis of a
+// flat block is a single 565 color, 8 bits values between two of them get the interpolated color.
+// The ties go to the closest endpoints, the hardware interpolates them with less rounding error.
+struct SingleColorTable {
+    uint8_t endpoints[256][2];
+};
+
+SingleColorTable buildSingleColorTable(uint32_t bits) {
+    const int32_t count = 1 << bits;
+
+    const auto expand = [bits](int32_t value) {
+        return (value << (8 - bits)) | (value >> (2 * bits - 8));
+    };
+
+    SingleColorTable table;
+
+    for (int32_t value = 0; value < 256; ++value) {
+        int32_t bestError = std::numeric_limits<int32_t>::max();
+        int32_t bestSpread = std::numeric_limits<int32_t>::max();
+
+        for (int32_t endpoint0 = 0; endpoint0 < count; ++endpoint0) {
+            for (int32_t endpoint1 = 0; endpoint1 < count; ++endpoint1) {
+                const int32_t error = std::abs((2 * expand(endpoint0) + expand(endpoint1)) / 3 - value);
+                const int32_t spread = std::abs(expand(endpoint0) - expand(endpoint1));
+
+                if (error < bestError || (error == bestError && spread < bestSpread)) {
+                    bestError = error;
+                    bestSpread = spread;
+                    table.endpoints[value][0] = static_cast<uint8_t>(endpoint0);
+                    table.endpoints[value][1] = static_cast<uint8_t>(endpoint1);
+                }
+            }
+        }
+    }
+
+    return table;
+}
+
+// Built once, on the first single color block
+const SingleColorTable& getSingleColorTable(uint32_t bits) {
+    static const SingleColorTable table5 = buildSingleColorTable(5);
+    static const SingleColorTable table6 = buildSingleColorTable(6);
+
+    return bits == 5 ? table5 : table6;
+}
+
+bool isSingleColor(const uint8_t pixels[16][4]) {
+    for (uint32_t i = 1; i < 16; ++i) {
+        if (pixels[i][0] != pixels[0][0] || pixels[i][1] != pixels[0][1] || pixels[i][2] != pixels[0][2]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void writeColorBlock(uint16_t color0, uint16_t color1, uint32_t indices, uint8_t* block) {
+    // The four colors mode needs color0 > color1, swapping them swaps the indices 0 and 1, 2 and 3
+    if (color0 < color1) {
+        std::swap(color0, color1);
+        indices ^= 0x55555555;
+    } else if (color0 == color1) {
+        indices = 0;
+    }
+
+    block[0] = static_cast<uint8_t>(color0);
+    block[1] = static_cast<uint8_t>(color0 >> 8);
+    block[2] = static_cast<uint8_t>(color1);
+    block[3] = static_cast<uint8_t>(color1 >> 8);
+    std::memcpy(block + 4, &indices, 4);
+}
+
+void encodeColorBlock(const uint8_t pixels[16][4], Quality quality, uint8_t* block) {
+    // Every texel takes the color 2 of the endpoints of the tables, the fit along an axis can't do better than a 565 color
+    if (isSingleColor(pixels)) {
+        const SingleColorTable& table5 = getSingleColorTable(5);
+        const SingleColorTable& table6 = getSingleColorTable(6);
+
+        const uint8_t* r = table5.endpoints[pixels[0][0]];
+        const uint8_t* g = table6.endpoints[pixels[0][1]];
+        const uint8_t* b = table5.endpoints[pixels[0][2]];
+
+        const uint16_t color0 = static_cast<uint16_t>((r[0] << 11) | (g[0] << 5) | b[0]);
+        const uint16_t color1 = static_cast<uint16_t>((r[1] << 11) | (g[1] << 5) | b[1]);
+
+        writeColorBlock(color0, color1, 0xAAAAAAAA, block);
+        return;
+    }
+
+    // The principal axis of the colors, by power iteration on their covariance
+    float mean[3] = {0.0f, 0.0f, 0.0f};
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        for (uint32_t c = 0; c < 3; ++c) {
+            mean[c] += pixels[i][c] / 16.0f;
+        }
+    }
+
+    float covariance[3][3] = {};
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        const float difference[3] = {pixels[i][0] - mean[0], pixels[i][1] - mean[1], pixels[i][2] - mean[2]};
+
+        for (uint32_t row = 0; row < 3; ++row) {
+            for (uint32_t column = 0; column < 3; ++column) {
+                covariance[row][column] += difference[row] * difference[column];
+            }
+        }
+    }
+
+    float axis[3] = {1.0f, 1.0f, 1.0f};
+
+    for (uint32_t iteration = 0; iteration < 8; ++iteration) {
+        float next[3];
+
+        for (uint32_t row = 0; row < 3; ++row) {
+            next[row] = covariance[row][0] * axis[0] + covariance[row][1] * axis[1] + covariance[row][2] * axis[2];
+        }
+
+        const float length = std::max({std::abs(next[0]), std::abs(next[1]), std::abs(next[2])});
+
+        // A flat block has no axis, its endpoints are the mean
+        if (length < 1e-6f) {
+            break;
+        }
+
+        for (uint32_t c = 0; c < 3; ++c) {
+            axis[c] = next[c] / length;
+        }
+    }
+
+    float minimum = std::numeric_limits<float>::max();
+    float maximum = -std::numeric_limits<float>::max();
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        const float t = (pixels[i][0] - mean[0]) * axis[0] + (pixels[i][1] - mean[1]) * axis[1] + (pixels[i][2] - mean[2]) * axis[2];
+
+        minimum = std::min(minimum, t);
+        maximum = std::max(maximum, t);
+    }
+
+    // The extremes are pulled in by 1/16 of the range, the interpolated colors cover the block better
+    const float inset = (maximum - minimum) / 16.0f;
+
+    float endpoints[2][3];
+
+    for (uint32_t c = 0; c < 3; ++c) {
+        endpoints[0][c] = mean[c] + axis[c] * (maximum - inset);
+        endpoints[1][c] = mean[c] + axis[c] * (minimum + inset);
+    }
+
+    uint16_t colors[2] = {packRgb565(endpoints[0]), packRgb565(endpoints[1])};
+
+    uint32_t indices;
+    uint32_t error = fitColorIndices(pixels, colors[0], colors[1], indices);
+
+    const uint32_t refinementCount = quality == Quality::Fast ? 0 : (quality == Quality::Normal ? 2 : 8);
+
+    for (uint32_t iteration = 0; iteration < refinementCount && error > 0; ++iteration) {
+        if (!solveColorEndpoints(pixels, indices, endpoints)) {
+            break;
+        }
+
+        const uint16_t candidates[2] = {packRgb565(endpoints[0]), packRgb565(endpoints[1])};
+
+        uint32_t candidateIndices;
+        const uint32_t candidateError = fitColorIndices(pixels, candidates[0], candidates[1], candidateIndices);
+
+        if (candidateError >= error) {
+            break;
+        }
+
+        colors[0] = candidates[0];
+        colors[1] = candidates[1];
+        indices = candidateIndices;
+        error = candidateError;
+    }
+
+    if (quality == Quality::High) {
+        searchColorEndpoints(pixels, colors, indices, error);
+    }
+
+    writeColorBlock(colors[0], colors[1], indices, block);
+}
+
+// The eight values of a BC4 block, six interpolated ones if value0 > value1, four and 0, 255 otherwise
+void getChannelPalette(uint8_t value0, uint8_t value1, int32_t palette[8]) {
+    palette[0] = value0;
+    palette[1] = value1;
+
+    if (value0 > value1) {
+        for (int32_t k = 1; k < 7; ++k) {
+            palette[k + 1] = ((7 - k) * value0 + k * value1 + 3) / 7;
+        }
+    } else {
+        for (int32_t k = 1; k < 5; ++k) {
+            palette[k + 1] = ((5 - k) * value0 + k * value1 + 2) / 5;
+        }
+
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+uint32_t fitChannelIndices(const uint8_t values[16], uint8_t value0, uint8_t value1, uint64_t& indices) {
+    int32_t palette[8];
+    getChannelPalette(value0, value1, palette);
+
+    uint32_t error = 0;
+    indices = 0;
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        uint32_t bestIndex = 0;
+        uint32_t bestError = std::numeric_limits<uint32_t>::max();
+
+        for (uint32_t index = 0; index < 8; ++index) {
+            const int32_t difference = values[i] - palette[index];
+            const uint32_t distance = difference * difference;
+
+            if (distance < bestError) {
+                bestError = distance;
+                bestIndex = index;
+            }
+        }
+
+        indices |= uint64_t(bestIndex) << (3 * i);
+        error += bestError;
+    }
+
+    return error;
+}
+
+void encodeChannelBlock(const uint8_t values[16], Quality quality, uint8_t* block) {
+    uint8_t minimum = 255;
+    uint8_t maximum = 0;
+
+    // The range of the values other than 0 and 255, for the six values mode
+    uint8_t innerMinimum = 255;
+    uint8_t innerMaximum = 0;
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        minimum = std::min(minimum, values[i]);
+        maximum = std::max(maximum, values[i]);
+
+        if (values[i] != 0 && values[i] != 255) {
+            innerMinimum = std::min(innerMinimum, values[i]);
+            innerMaximum = std::max(innerMaximum, values[i]);
+        }
+    }
+
+    uint8_t best[2] = {maximum, minimum};
+
+    uint64_t indices;
+    uint32_t error = fitChannelIndices(values, best[0], best[1], indices);
+
+    const auto tryEndpoints = [&](uint8_t value0, uint8_t value1) {
+        uint64_t candidateIndices;
+        const uint32_t candidateError = fitChannelIndices(values, value0, value1, candidateIndices);
+
+        if (candidateError < error) {
+            best[0] = value0;
+            best[1] = value1;
+            indices = candidateIndices;
+            error = candidateError;
+        }
+    };
+
+    if (quality != Quality::Fast && error > 0) {
+        if (innerMinimum <= innerMaximum) {
+            tryEndpoints(innerMinimum, innerMaximum);
+        }
+    }
+
+    // Pulls the endpoints in, the extremes are often isolated texels
+    if (quality == Quality::High && error > 0) {
+        for (uint32_t inset0 = 0; inset0 < 4; ++inset0) {
+            for (uint32_t inset1 = 0; inset1 < 4; ++inset1) {
+                if (maximum - inset0 > minimum + inset1) {
+                    tryEndpoints(static_cast<uint8_t>(maximum - inset0), static_cast<uint8_t>(minimum + inset1));
+                }
+            }
+        }
+    }
+
+    block[0] = best[0];
+    block[1] = best[1];
+
+    for (uint32_t i = 0; i < 6; ++i) {
+        block[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+    }
+}
+
+void decodeColorBlock(const uint8_t* block, bool allowThreeColors, uint8_t pixels[16][4]) {
+    const uint16_t color0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+    const uint16_t color1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+
+    int32_t palette[4][4];
+    getColorPalette(color0, color1, !allowThreeColors || color0 > color1, palette);
+
+    uint32_t indices;
+    std::memcpy(&indices, block + 4, 4);
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        const uint32_t index = (indices >> (2 * i)) & 3;
+
+        for (uint32_t c = 0; c < 4; ++c) {
+            pixels[i][c] = static_cast<uint8_t>(palette[index][c]);
+        }
+    }
+}
+
+void decodeChannelBlock(const uint8_t* block, uint8_t pixels[16][4], uint32_t channel) {
+    int32_t palette[8];
+    getChannelPalette(block[0], block[1], palette);
+
+    uint64_t indices = 0;
+
+    for (uint32_t i = 0; i < 6; ++i) {
+        indices |= uint64_t(block[2 + i]) << (8 * i);
+    }
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        pixels[i][channel] = static_cast<uint8_t>(palette[(indices >> (3 * i)) & 7]);
+    }
+}
+
+// Calls function(blockX, blockY, block) on each block, the rows of blocks split between the threads
+void forEachBlock(uint32_t width, uint32_t height, uint32_t threadCount, const std::function<void(uint32_t, uint32_t)>& function) {
+    const uint32_t blockWidth = (width + 3) / 4;
+    const uint32_t blockHeight = (height + 3) / 4;
+
+    parallelFor((blockHeight + blockRowsPerJob - 1) / blockRowsPerJob, threadCount, [&](uint32_t job) {
+        for (uint32_t y = job * blockRowsPerJob; y < std::min(blockHeight, (job + 1) * blockRowsPerJob); ++y) {
+            for (uint32_t x = 0; x < blockWidth; ++x) {
+                function(x, y);
+            }
+        }
+    });
+}
+
+} // anonymous
+
+const char* getName(Format format) {
+    switch (format) {
+        case Format::Rgba8:
+            return "rgba8";
+        case Format::Bc1:
+            return "bc1";
+        case Format::Bc3:
+            return "bc3";
+        case Format::Bc5:
+            return "bc5";
+    }
+
+    return "unknown";
+}
+
+const char* getName(Quality quality) {
+    switch (quality) {
+        case Quality::Fast:
+            return "fast";
+        case Quality::Normal:
+            return "normal";
+        case Quality::High:
+            return "high";
+    }
+
+    return "unknown";
+}
+
+uint32_t getBlockSize(Format format) {
+    switch (format) {
+        case Format::Rgba8:
+            return 0;
+        case Format::Bc1:
+            return 8;
+        case Format::Bc3:
+        case Format::Bc5:
+            return 16;
+    }
+
+    return 0;
+}
+
+uint64_t getSize(Format format, uint32_t width, uint32_t height) {
+    if (format == Format::Rgba8) {
+        return uint64_t(width) * height * 4;
+    }
+
+    return uint64_t((width + 3) / 4) * ((height + 3) / 4) * getBlockSize(format);
+}
+
+Format selectFormat(const uint8_t* rgba, size_t pixelCount, bool normalMap) {
+    if (normalMap) {
+        return Format::Bc5;
+    }
+
+    for (size_t i = 0; i < pixelCount; ++i) {
+        if (rgba[i * 4 + 3] != 255) {
+            return Format::Bc3;
+        }
+    }
+
+    return Format::Bc1;
+}
+
+void encode(uint32_t width, uint32_t height, const uint8_t* rgba, const Settings& settings, std::vector<uint8_t>& data) {
+    SAMPLE_TRACE_ZONE("BlockCompress::encode");
+
+    if (settings.format == Format::Rgba8) {
+        data.assign(rgba, rgba + size_t(width) * height * 4);
+        return;
+    }
+
+    data.resize(static_cast<size_t>(getSize(settings.format, width, height)));
+
+    const uint32_t blockWidth = (width + 3) / 4;
+    const uint32_t blockSize = getBlockSize(settings.format);
+
+    forEachBlock(width, height, std::max(1u, settings.threadCount), [&](uint32_t blockX, uint32_t blockY) {
+        // The edge blocks repeat the last column and row
+        uint8_t pixels[16][4];
+        uint8_t channels[2][16];
+
+        for (uint32_t i = 0; i < 16; ++i) {
+            const uint32_t x = std::min(blockX * 4 + i % 4, width - 1);
+            const uint32_t y = std::min(blockY * 4 + i / 4, height - 1);
+
+            std::memcpy(pixels[i], rgba + (size_t(y) * width + x) * 4, 4);
+        }
+
+        uint8_t* block = data.data() + (size_t(blockY) * blockWidth + blockX) * blockSize;
+
+        switch (settings.format) {
+            case Format::Rgba8:
+                break;
+            case Format::Bc1:
+                encodeColorBlock(pixels, settings.quality, block);
+                break;
+            case Format::Bc3:
+                for (uint32_t i = 0; i < 16; ++i) {
+                    channels[0][i] = pixels[i][3];
+                }
+
+                encodeChannelBlock(channels[0], settings.quality, block);
+                encodeColorBlock(pixels, settings.quality, block + 8);
+                break;
+            case Format::Bc5:
+                for (uint32_t i = 0; i < 16; ++i) {
+                    channels[0][i] = pixels[i][0];
+                    channels[1][i] = pixels[i][1];
+                }
+
+                encodeChannelBlock(channels[0], settings.quality, block);
+                encodeChannelBlock(channels[1], settings.quality, block + 8);
+                break;
+        }
+    });
+}
+
+void decode(Format format, uint32_t width, uint32_t height, const uint8_t* data, std::vector<uint8_t>& rgba) {
+    rgba.resize(size_t(width) * height * 4);
+
+    if (format == Format::Rgba8) {
+        std::memcpy(rgba.data(), data, rgba.size());
+        return;
+    }
+
+    const uint32_t blockWidth = (width + 3) / 4;
+    const uint32_t blockSize = getBlockSize(format);
+
+    forEachBlock(width, height, 1, [&](uint32_t blockX, uint32_t blockY) {
+        const uint8_t* block = data + (size_t(blockY) * blockWidth + blockX) * blockSize;
+
+        uint8_t pixels[16][4];
+
+        switch (format) {
+            case Format::Rgba8:
+                break;
+            case Format::Bc1:
+                decodeColorBlock(block, true, pixels);
+                break;
+            case Format::Bc3:
+                decodeColorBlock(block + 8, false, pixels);
+                decodeChannelBlock(block, pixels, 3);
+                break;
+            case Format::Bc5:
+                decodeChannelBlock(block, pixels, 0);
+                decodeChannelBlock(block + 8, pixels, 1);
+
+                for (uint32_t i = 0; i < 16; ++i) {
+                    const float x = pixels[i][0] / 127.5f - 1.0f;
+                    const float y = pixels[i][1] / 127.5f - 1.0f;
+                    const float z = std::sqrt(std::max(0.0f, 1.0f - x * x - y * y));
+
+                    pixels[i][2] = static_cast<uint8_t>((z * 0.5f + 0.5f) * 255.0f + 0.5f);
+                    pixels[i][3] = 255;
+                }
+                break;
+        }
+
+        for (uint32_t i = 0; i < 16; ++i) {
+            const uint32_t x = blockX * 4 + i % 4;
+            const uint32_t y = blockY * 4 + i / 4;
+
+            if (x < width && y < height) {
+                std::memcpy(rgba.data() + (size_t(y) * width + x) * 4, pixels[i], 4);
+            }
+        }
+    });
+}
+
+float computePsnr(Format format, uint32_t width, uint32_t height, const uint8_t* rgba, const uint8_t* data) {
+    std::vector<uint8_t> decoded;
+    decode(format, width, height, data, decoded);
+
+    const uint32_t channelCount = format == Format::Bc1 ? 3 : (format == Format::Bc5 ? 2 : 4);
+
+    double error = 0.0;
+
+    for (size_t i = 0; i < size_t(width) * height; ++i) {
+        for (uint32_t c = 0; c < channelCount; ++c) {
+            const int32_t difference = rgba[i * 4 + c] - decoded[i * 4 + c];
+            error += difference * difference;
+        }
+    }
+
+    if (error == 0.0) {
+        return std::numeric_limits<float>::infinity();
+    }
+
+    const double meanError = error / (double(width) * height * channelCount);
+    return static_cast<float>(10.0 * std::log10(255.0 * 255.0 / meanError));
+}
+
+} // BlockCompress
@@ -0,0 +1,279 @@
+#include "FramePacer.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include <imgui.h>
+
+#include <lug/System/Logger/Logger.hpp>
+
+constexpr uint8_t FramePacer::modeCount;
+
+namespace {
+
+const char* modeNames[FramePacer::modeCount] = {
+    "uncapped",
+    "fixed-step",
+    "capped",
+    "low-latency"
+};
+
+// The sleeps stop that long before the deadline, the rest is spun
+constexpr std::chrono::microseconds spinDuration{2000};
+
+// Past this many ticks in a frame the simulation drops time instead of spiraling
+constexpr uint32_t maxTicksPerFrame = 8;
+
+} // anonymous
+
+double FramePacer::Stats::getVariance() const {
+    return frameCount > 1 ? sumSquaredDifferences / (frameCount - 1) : 0.0;
+}
+
+const char* FramePacer::getModeName(Mode mode) {
+    return modeNames[static_cast<uint8_t>(mode)];
+}
+
+bool FramePacer::parseMode(const std::string& name, Mode& mode) {
+    for (uint8_t i = 0; i < modeCount; ++i) {
+        if (name == modeNames[i]) {
+            mode = static_cast<Mode>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool FramePacer::parseArguments(int argc, char* argv[]) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::strcmp(argv[i], "--frame-pacing") == 0) {
+            Mode mode;
+
+            if (!parseMode(argv[i + 1], mode)) {
+                LUG_LOG.error("FramePacer: Unknown mode {}", argv[i + 1]);
+                return false;
+            }
+
+            if (!isSupported(mode)) {
+                LUG_LOG.error("FramePacer: The mode {} is not supported by this sample", argv[i + 1]);
+                return false;
+            }
+
+            setMode(mode);
+        } else if (std::strcmp(argv[i], "--frame-rate") == 0) {
+            const float frameRate = std::strtof(argv[i + 1], nullptr);
+
+            if (frameRate <= 0.0f) {
+                LUG_LOG.error("FramePacer: Invalid frame rate {}", argv[i + 1]);
+                return false;
+            }
+
+            setFrameRate(frameRate);
+        } else if (std::strcmp(argv[i], "--tick-rate") == 0) {
+            const float tickRate = std::strtof(argv[i + 1], nullptr);
+
+            if (tickRate <= 0.0f) {
+                LUG_LOG.error("FramePacer: Invalid tick rate {}", argv[i + 1]);
+                return false;
+            }
+
+            setTickRate(tickRate);
+        }
+    }
+
+    return true;
+}
+
+void FramePacer::setMode(Mode mode) {
+    _mode = mode;
+    _restart = true;
+    _accumulatedSeconds = 0.0f;
+}
+
+FramePacer::Mode FramePacer::getMode() const {
+    return _mode;
+}
+
+void FramePacer::setFixedStepSupported(bool supported) {
+    _fixedStepSupported = supported;
+
+    if (!supported && _mode == Mode::FixedStep) {
+        setMode(Mode::Uncapped);
+    }
+}
+
+bool FramePacer::isSupported(Mode mode) const {
+    return mode != Mode::FixedStep || _fixedStepSupported;
+}
+
+void FramePacer::setFrameRate(float frameRate) {
+    _frameRate = frameRate;
+    _restart = true;
+}
+
+float FramePacer::getFrameRate() const {
+    return _frameRate;
+}
+
+void FramePacer::setTickRate(float tickRate) {
+    _tickSeconds = 1.0f / tickRate;
+    _accumulatedSeconds = 0.0f;
+}
+
+float FramePacer::getTickSeconds() const {
+    return _tickSeconds;
+}
+
+void FramePacer::beginFrame() {
+    if (_restart) {
+        _deadline = Clock::now() + getPeriod();
+    } else if (_mode == Mode::LowLatency) {
+        pace();
+    }
+
+    const Clock::time_point now = Clock::now();
+
+    // The first frame of a mode has no previous frame to measure from
+    if (!_restart) {
+        Stats& stats = _stats[static_cast<uint8_t>(_mode)];
+
+        const double milliseconds = std::chrono::duration<double, std::milli>(now - _frameStart).count();
+        const double difference = milliseconds - stats.meanMilliseconds;
+
+        ++stats.frameCount;
+        stats.meanMilliseconds += difference / stats.frameCount;
+        stats.sumSquaredDifferences += difference * (milliseconds - stats.meanMilliseconds);
+    }
+
+    _frameStart = now;
+    _restart = false;
+}
+
+void FramePacer::endFrame() {
+    if (_mode == Mode::Capped) {
+        pace();
+    }
+}
+
+uint32_t FramePacer::advance(float elapsedSeconds) {
+    _accumulatedSeconds += elapsedSeconds;
+
+    if (_accumulatedSeconds > maxTicksPerFrame * _tickSeconds) {
+        _accumulatedSeconds = maxTicksPerFrame * _tickSeconds;
+    }
+
+    uint32_t tickCount = 0;
+
+    while (_accumulatedSeconds >= _tickSeconds) {
+        _accumulatedSeconds -= _tickSeconds;
+        ++tickCount;
+    }
+
+    return tickCount;
+}
+
+float FramePacer::getInterpolation() const {
+    return _accumulatedSeconds / _tickSeconds;
+}
+
+const FramePacer::Stats& FramePacer::getStats(Mode mode) const {
+    return _stats[static_cast<uint8_t>(mode)];
+}
+
+void FramePacer::draw() {
+    ImGui::Begin("Frame pacing");
+    {
+        ImGui::SetWindowSize({260, 170});
+        ImGui::SetWindowPos({320, 300});
+
+        // Only the supported modes are listed
+        const char* names[modeCount];
+        Mode modes[modeCount];
+        int count = 0;
+        int current = 0;
+
+        for (uint8_t i = 0; i < modeCount; ++i) {
+            const Mode mode = static_cast<Mode>(i);
+
+            if (!isSupported(mode)) {
+                continue;
+            }
+
+            if (mode == _mode) {
+                current = count;
+            }
+
+            names[count] = modeNames[i];
+            modes[count] = mode;
+            ++count;
+        }
+
+        if (ImGui::Combo("mode", &current, names, count)) {
+            setMode(modes[current]);
+        }
+
+        float frameRate = _frameRate;
+        if (ImGui::SliderFloat("frame rate", &frameRate, 10.0f, 240.0f) && frameRate != _frameRate) {
+            setFrameRate(frameRate);
+        }
+
+        ImGui::Separator();
+
+        for (uint8_t i = 0; i < modeCount; ++i) {
+            if (_stats[i].frameCount) {
+                ImGui::Text("%s: %.2f ms, var %.4f ms^2", modeNames[i], _stats[i].meanMilliseconds, _stats[i].getVariance());
+            }
+        }
+    }
+    ImGui::End();
+}
+
+void FramePacer::logStats() const {
+    for (uint8_t i = 0; i < modeCount; ++i) {
+        const Stats& stats = _stats[i];
+
+        if (!stats.frameCount) {
+            continue;
+        }
+
+        LUG_LOG.info(
+            "FramePacer: {}: {} frames, mean {:.3f} ms, variance {:.4f} ms^2, waited {:.1f} ms",
+            modeNames[i], stats.frameCount, stats.meanMilliseconds, stats.getVariance(), stats.waitMilliseconds
+        );
+    }
+}
+
+void FramePacer::pace() {
+    const Clock::time_point start = Clock::now();
+
+    for (;;) {
+        const Clock::time_point now = Clock::now();
+
+        if (now >= _deadline) {
+            break;
+        }
+
+        if (_deadline - now > spinDuration) {
+            std::this_thread::sleep_for(_deadline - now - spinDuration);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    const Clock::time_point end = Clock::now();
+
+    _stats[static_cast<uint8_t>(_mode)].waitMilliseconds += std::chrono::duration<double, std::milli>(end - start).count();
+
+    _deadline += getPeriod();
+
+    // Late by more than a frame, the next one isn't shortened to catch up
+    if (_deadline < end) {
+        _deadline = end + getPeriod();
+    }
+}
+
+FramePacer::Clock::duration FramePacer::getPeriod() const {
+    return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / _frameRate));
+}
@@ -0,0 +1,126 @@
+#include "ImageFile.hpp"
+
+// stb_image is also built inside the engine, keep this copy private to the translation unit, the
+// samples and the tools decode their images through ImageFile
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+
+#if defined(_MSC_VER)
+    #pragma warning(push, 0)
+#else
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wpragmas"
+    #pragma GCC diagnostic ignored "-Wunused-function"
+    #pragma GCC diagnostic ignored "-Wunused-parameter"
+    #pragma GCC diagnostic ignored "-Wsign-compare"
+    #pragma GCC diagnostic ignored "-Wimplicit-fallthrough"
+#endif
+
+#include <stb_image.h>
+
+#if defined(_MSC_VER)
+    #pragma warning(pop)
+#else
+    #pragma GCC diagnostic pop
+#endif
+
+#include <lug/System/Logger/Logger.hpp>
+
+#include "PixelConvert.hpp"
+#include "ResourceFileSystem.hpp"
+
+namespace ImageFile {
+
+bool getInfo(const std::string& filename, uint32_t& width, uint32_t& height, uint32_t& components) {
+    ResourceFileSystem::File file;
+    if (!ResourceFileSystem::read(filename, file)) {
+        return false;
+    }
+
+    int x;
+    int y;
+    int n;
+
+    if (!stbi_info_from_memory(file.data, static_cast<int>(file.size), &x, &y, &n)) {
+        LUG_LOG.error("ImageFile: Can't read the header of {}: {}", filename, stbi_failure_reason());
+        return false;
+    }
+
+    width = static_cast<uint32_t>(x);
+    height = static_cast<uint32_t>(y);
+    components = static_cast<uint32_t>(n);
+
+    return true;
+}
+
+bool load(const std::string& filename, Image& image, uint32_t components) {
+    ResourceFileSystem::File file;
+    if (!ResourceFileSystem::read(filename, file)) {
+        return false;
+    }
+
+    int x;
+    int y;
+    int n;
+
+    if (!stbi_info_from_memory(file.data, static_cast<int>(file.size), &x, &y, &n)) {
+        LUG_LOG.error("ImageFile: Can't read the header of {}: {}", filename, stbi_failure_reason());
+        return false;
+    }
+
+    // RGB files are expanded to RGBA by PixelConvert, faster than the scalar conversion of stb_image
+    const bool expandRgb = components == 4 && n == 3;
+
+    stbi_uc* texels = stbi_load_from_memory(file.data, static_cast<int>(file.size), &x, &y, &n, expandRgb ? 3 : static_cast<int>(components));
+
+    if (!texels) {
+        LUG_LOG.error("ImageFile: Can't decode {}: {}", filename, stbi_failure_reason());
+        return false;
+    }
+
+    image.width = static_cast<uint32_t>(x);
+    image.height = static_cast<uint32_t>(y);
+    image.components = components ? components : static_cast<uint32_t>(n);
+
+    const size_t pixelCount = size_t(image.width) * image.height;
+
+    if (expandRgb) {
+        image.texels.resize(pixelCount * 4);
+        PixelConvert::rgbToRgba(texels, image.texels.data(), pixelCount);
+    } else {
+        image.texels.assign(texels, texels + pixelCount * image.components);
+    }
+
+    stbi_image_free(texels);
+
+    return true;
+}
+
+bool loadFloat(const std::string& filename, FloatImage& image, uint32_t components) {
+    ResourceFileSystem::File file;
+    if (!ResourceFileSystem::read(filename, file)) {
+        return false;
+    }
+
+    int x;
+    int y;
+    int n;
+
+    float* texels = stbi_loadf_from_memory(file.data, static_cast<int>(file.size), &x, &y, &n, static_cast<int>(components));
+
+    if (!texels) {
+        LUG_LOG.error("ImageFile: Can't decode {}: {}", filename, stbi_failure_reason());
+        return false;
+    }
+
+    image.width = static_cast<uint32_t>(x);
+    image.height = static_cast<uint32_t>(y);
+    image.components = components ? components : static_cast<uint32_t>(n);
+    image.texels.assign(texels, texels + size_t(image.width) * image.height * image.components);
+
+    stbi_image_free(texels);
+
+    return true;
+}
+
+} // ImageFile
@@ -0,0 +1,195 @@
+#include "InputRecording.hpp"
+
+#include <fstream>
+#include <type_traits>
+#include <utility>
+
+#include <lug/System/Logger/Logger.hpp>
+
+namespace InputRecording {
+
+namespace {
+
+constexpr char magic[4] = {'L', 'U', 'G', 'I'};
+constexpr uint32_t version = 1;
+
+// An hour at 1000 frames per second, the counts of a corrupted header aren't allocated
+constexpr uint32_t maxFrameCount = 3600 * 1000;
+constexpr uint32_t maxEventCount = 64 * maxFrameCount;
+
+// The events are stored as they are in memory, the size of the structure identifies the layout
+static_assert(std::is_trivially_copyable<lug::Window::Event>::value, "lug::Window::Event can't be written as raw bytes");
+constexpr uint32_t eventSize = sizeof(lug::Window::Event);
+
+struct Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t eventSize;
+    uint32_t frameCount;
+    uint32_t eventCount;
+};
+
+} // anonymous
+
+void Recorder::addEvent(const lug::Window::Event& event) {
+    _events.push_back(event);
+    ++_pendingEventCount;
+}
+
+void Recorder::endFrame(const lug::System::Time& elapsedTime, const lug::Graphics::Node& camera) {
+    const lug::Math::Vec3f& position = camera.getPosition();
+    const lug::Math::Quatf& rotation = camera.getRotation();
+
+    Frame frame;
+
+    frame.eventCount = _pendingEventCount;
+    frame.elapsedMicroseconds = static_cast<uint32_t>(elapsedTime.getMicroseconds<int64_t>());
+
+    frame.position[0] = position.x();
+    frame.position[1] = position.y();
+    frame.position[2] = position.z();
+
+    frame.rotation[0] = rotation.w();
+    frame.rotation[1] = rotation.x();
+    frame.rotation[2] = rotation.y();
+    frame.rotation[3] = rotation.z();
+
+    _frames.push_back(frame);
+    _pendingEventCount = 0;
+}
+
+bool Recorder::save(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+
+    if (!file) {
+        return false;
+    }
+
+    // The events of an unfinished frame are left out
+    const Header header{
+        {magic[0], magic[1], magic[2], magic[3]},
+        version,
+        eventSize,
+        static_cast<uint32_t>(_frames.size()),
+        static_cast<uint32_t>(_events.size()) - _pendingEventCount
+    };
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(_frames.data()), _frames.size() * sizeof(Frame));
+    file.write(reinterpret_cast<const char*>(_events.data()), header.eventCount * sizeof(lug::Window::Event));
+
+    return !!file;
+}
+
+uint32_t Recorder::getFrameCount() const {
+    return static_cast<uint32_t>(_frames.size());
+}
+
+bool Replay::load(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+
+    if (!file) {
+        LUG_LOG.error("InputRecording: Can't open {}", filename);
+        return false;
+    }
+
+    Header header;
+
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || std::string(header.magic, 4) != std::string(magic, 4)) {
+        LUG_LOG.error("InputRecording: {} is not an input recording", filename);
+        return false;
+    }
+
+    if (header.version != version || header.eventSize != eventSize) {
+        LUG_LOG.error("InputRecording: {} was recorded by an incompatible build", filename);
+        return false;
+    }
+
+    if (header.frameCount > maxFrameCount || header.eventCount > maxEventCount) {
+        LUG_LOG.error("InputRecording: {} is corrupted", filename);
+        return false;
+    }
+
+    // Nothing to replay, and isLoaded() would report it as not loaded
+    if (header.frameCount == 0) {
+        LUG_LOG.error("InputRecording: {} is empty", filename);
+        return false;
+    }
+
+    std::vector<Frame> frames(header.frameCount);
+    std::vector<lug::Window::Event> events(header.eventCount);
+
+    if (!file.read(reinterpret_cast<char*>(frames.data()), frames.size() * sizeof(Frame))
+        || !file.read(reinterpret_cast<char*>(events.data()), events.size() * sizeof(lug::Window::Event))) {
+        LUG_LOG.error("InputRecording: {} is truncated", filename);
+        return false;
+    }
+
+    uint64_t frameEventCount = 0;
+    for (const Frame& frame : frames) {
+        frameEventCount += frame.eventCount;
+    }
+
+    if (frameEventCount != events.size()) {
+        LUG_LOG.error("InputRecording: {} is corrupted", filename);
+        return false;
+    }
+
+    _frames = std::move(frames);
+    _events = std::move(events);
+
+    _frameIndex = 0;
+    _firstEvent = 0;
+    _replayedMilliseconds = 0.0;
+
+    return true;
+}
+
+bool Replay::isLoaded() const {
+    return !_frames.empty();
+}
+
+bool Replay::nextFrame(lug::Graphics::Node& camera, const lug::System::Time& elapsedTime) {
+    if (_frameIndex == _frames.size()) {
+        return false;
+    }
+
+    if (_frameIndex > 0) {
+        _firstEvent += _frames[_frameIndex - 1].eventCount;
+    }
+
+    const Frame& frame = _frames[_frameIndex++];
+
+    camera.setPosition({frame.position[0], frame.position[1], frame.position[2]}, lug::Graphics::Node::TransformSpace::Local);
+    camera.setRotation(lug::Math::Quatf(frame.rotation[0], frame.rotation[1], frame.rotation[2], frame.rotation[3]), lug::Graphics::Node::TransformSpace::Local);
+
+    _replayedMilliseconds += elapsedTime.getMilliseconds<double>();
+
+    return true;
+}
+
+lug::System::Time Replay::getElapsedTime() const {
+    return lug::System::Time(_frameIndex > 0 ? _frames[_frameIndex - 1].elapsedMicroseconds : 0);
+}
+
+const lug::Window::Event* Replay::getFrameEvents() const {
+    return _events.data() + _firstEvent;
+}
+
+uint32_t Replay::getFrameEventCount() const {
+    return _frameIndex > 0 ? _frames[_frameIndex - 1].eventCount : 0;
+}
+
+uint32_t Replay::getFrameCount() const {
+    return static_cast<uint32_t>(_frames.size());
+}
+
+uint32_t Replay::getReplayedFrameCount() const {
+    return _frameIndex;
+}
+
+double Replay::getReplayedMilliseconds() const {
+    return _replayedMilliseconds;
+}
+
+} // InputRecording
@@ -0,0 +1,89 @@
+#include "LoggingBenchmark.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <lug/System/Logger/Logger.hpp>
+#include <lug/System/Logger/OstreamHandler.hpp>
+
+#include "Trace.hpp"
+
+namespace LoggingBenchmark {
+
+namespace {
+
+struct Result {
+    double callsMilliseconds;
+    double totalMilliseconds;
+};
+
+Result measure(lug::System::Logger::Handler& handler, uint32_t threadCount, uint32_t messagesPerThread) {
+    lug::System::Logger::Logger logger("benchmark");
+    logger.addHandler(&handler);
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+
+    for (uint32_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back([&logger, i, messagesPerThread]() {
+            SAMPLE_TRACE_THREAD_NAME("logging benchmark");
+
+            for (uint32_t j = 0; j < messagesPerThread; ++j) {
+                logger.info("Benchmark: Thread {} message {}", i, j);
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    handler.flush();
+
+    const auto flushed = std::chrono::high_resolution_clock::now();
+
+    return {
+        std::chrono::duration<double, std::milli>(end - start).count(),
+        std::chrono::duration<double, std::milli>(flushed - start).count()
+    };
+}
+
+} // anonymous
+
+void run(AsyncHandler::OverflowPolicy policy, uint32_t threadCount, uint32_t messagesPerThread) {
+    SAMPLE_TRACE_ZONE("LoggingBenchmark::run");
+
+    const double messageCount = static_cast<double>(threadCount) * messagesPerThread;
+
+    Result stdoutResult;
+    {
+        lug::System::Logger::StdoutHandler handler("benchmark-stdout");
+        stdoutResult = measure(handler, threadCount, messagesPerThread);
+    }
+
+    Result asyncResult;
+    uint64_t dropped;
+    {
+        AsyncHandler handler("benchmark-async", std::cout, policy);
+        asyncResult = measure(handler, threadCount, messagesPerThread);
+        dropped = handler.getDroppedCount();
+    }
+
+    LUG_LOG.info("LoggingBenchmark: {} thread(s), {} messages each", threadCount, messagesPerThread);
+    LUG_LOG.info(
+        "LoggingBenchmark: StdoutHandler {:.0f} calls/s ({:.1f} ms, {:.1f} ms until flushed)",
+        messageCount * 1000.0 / stdoutResult.callsMilliseconds, stdoutResult.callsMilliseconds, stdoutResult.totalMilliseconds
+    );
+    LUG_LOG.info(
+        "LoggingBenchmark: AsyncHandler {:.0f} calls/s ({:.1f} ms, {:.1f} ms until flushed, {} dropped)",
+        messageCount * 1000.0 / asyncResult.callsMilliseconds, asyncResult.callsMilliseconds, asyncResult.totalMilliseconds, dropped
+    );
+}
+
+} // LoggingBenchmark
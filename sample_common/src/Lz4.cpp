@@ -0,0 +1,189 @@
+#include "Lz4.hpp"
+
+#include <cstring>
+#include <vector>
+
+namespace Lz4 {
+
+namespace {
+
+constexpr size_t minMatch = 4;
+
+// The format requires the last 5 bytes to be literals, and the last match to start 12 bytes before the end
+constexpr size_t lastLiterals = 5;
+constexpr size_t matchFindLimit = 12;
+
+constexpr size_t maxOffset = 65535;
+constexpr uint32_t hashBits = 16;
+
+inline uint32_t read32(const uint8_t* data) {
+    uint32_t value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline uint32_t hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - hashBits);
+}
+
+inline uint8_t* writeLength(uint8_t* out, size_t length) {
+    while (length >= 255) {
+        *out++ = 255;
+        length -= 255;
+    }
+
+    *out++ = static_cast<uint8_t>(length);
+    return out;
+}
+
+inline uint8_t* writeLiterals(uint8_t* out, uint8_t& token, const uint8_t* literals, size_t length) {
+    if (length >= 15) {
+        token = 15 << 4;
+        out = writeLength(out, length - 15);
+    } else {
+        token = static_cast<uint8_t>(length << 4);
+    }
+
+    std::memcpy(out, literals, length);
+    return out + length;
+}
+
+inline bool readLength(const uint8_t*& in, const uint8_t* end, size_t& length) {
+    uint8_t byte;
+
+    do {
+        if (in == end) {
+            return false;
+        }
+
+        byte = *in++;
+        length += byte;
+    } while (byte == 255);
+
+    return true;
+}
+
+} // anonymous
+
+size_t getMaxCompressedSize(size_t size) {
+    return size + size / 255 + 16;
+}
+
+size_t compress(const uint8_t* src, size_t size, uint8_t* dst) {
+    // Positions plus one, zero is empty
+    std::vector<uint32_t> table(1 << hashBits, 0);
+
+    uint8_t* out = dst;
+    size_t anchor = 0;
+    size_t position = 0;
+
+    while (position + matchFindLimit <= size) {
+        const uint32_t sequence = read32(src + position);
+        uint32_t& slot = table[hash(sequence)];
+
+        const size_t candidate = slot;
+        slot = static_cast<uint32_t>(position + 1);
+
+        if (!candidate || position - (candidate - 1) > maxOffset || read32(src + candidate - 1) != sequence) {
+            ++position;
+            continue;
+        }
+
+        const size_t reference = candidate - 1;
+
+        size_t length = minMatch;
+        while (position + length < size - lastLiterals && src[reference + length] == src[position + length]) {
+            ++length;
+        }
+
+        uint8_t* token = out++;
+        out = writeLiterals(out, *token, src + anchor, position - anchor);
+
+        const size_t offset = position - reference;
+        *out++ = static_cast<uint8_t>(offset);
+        *out++ = static_cast<uint8_t>(offset >> 8);
+
+        if (length - minMatch >= 15) {
+            *token |= 15;
+            out = writeLength(out, length - minMatch - 15);
+        } else {
+            *token |= static_cast<uint8_t>(length - minMatch);
+        }
+
+        position += length;
+        anchor = position;
+    }
+
+    uint8_t* token = out++;
+    out = writeLiterals(out, *token, src + anchor, size - anchor);
+
+    return static_cast<size_t>(out - dst);
+}
+
+bool decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+    const uint8_t* in = src;
+    const uint8_t* inEnd = src + srcSize;
+    uint8_t* out = dst;
+    uint8_t* outEnd = dst + dstSize;
+
+    while (in < inEnd) {
+        const uint8_t token = *in++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(in, inEnd, literalLength)) {
+            return false;
+        }
+
+        if (literalLength > static_cast<size_t>(inEnd - in) || literalLength > static_cast<size_t>(outEnd - out)) {
+            return false;
+        }
+
+        std::memcpy(out, in, literalLength);
+        in += literalLength;
+        out += literalLength;
+
+        // The last sequence has no match
+        if (in == inEnd) {
+            break;
+        }
+
+        if (inEnd - in < 2) {
+            return false;
+        }
+
+        const size_t offset = in[0] | (in[1] << 8);
+        in += 2;
+
+        if (!offset || offset > static_cast<size_t>(out - dst)) {
+            return false;
+        }
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(in, inEnd, matchLength)) {
+            return false;
+        }
+
+        matchLength += minMatch;
+
+        if (matchLength > static_cast<size_t>(outEnd - out)) {
+            return false;
+        }
+
+        const uint8_t* match = out - offset;
+
+        if (offset >= matchLength) {
+            std::memcpy(out, match, matchLength);
+        } else {
+            // The match overlaps the output, it repeats a pattern
+            for (size_t i = 0; i < matchLength; ++i) {
+                out[i] = match[i];
+            }
+        }
+
+        out += matchLength;
+    }
+
+    return out == outEnd;
+}
+
+} // Lz4
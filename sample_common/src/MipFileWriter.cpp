@@ -0,0 +1,70 @@
+#include "MipFileWriter.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#include "MipFormat.hpp"
+
+namespace MipFileWriter {
+
+namespace {
+
+uint64_t align(uint64_t offset) {
+    return (offset + MipFormat::dataAlignment - 1) & ~(MipFormat::dataAlignment - 1);
+}
+
+} // anonymous
+
+bool write(const std::string& filename, const std::vector<MipGenerator::Level>& levels, BlockCompress::Format format) {
+    const uint32_t levelCount = static_cast<uint32_t>(levels.size());
+
+    if (levelCount == 0 || levelCount != MipFormat::getLevelCount(levels[0].width, levels[0].height)) {
+        return false;
+    }
+
+    std::vector<MipFormat::Level> table(levelCount);
+
+    // Coarsest first
+    uint64_t offset = align(sizeof(MipFormat::Header) + levelCount * sizeof(MipFormat::Level));
+
+    for (uint32_t mip = levelCount; mip-- > 0;) {
+        if (levels[mip].texels.size() != BlockCompress::getSize(format, levels[mip].width, levels[mip].height)) {
+            return false;
+        }
+
+        table[mip].offset = offset;
+        table[mip].size = levels[mip].texels.size();
+        table[mip].width = levels[mip].width;
+        table[mip].height = levels[mip].height;
+
+        offset = align(offset + table[mip].size);
+    }
+
+    MipFormat::Header header{};
+    std::memcpy(header.magic, MipFormat::magic, sizeof(header.magic));
+    header.version = MipFormat::version;
+    header.width = levels[0].width;
+    header.height = levels[0].height;
+    header.levelCount = levelCount;
+    header.format = static_cast<uint32_t>(format);
+
+    std::ofstream file(filename, std::ios::binary);
+
+    if (!file) {
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(table.data()), levelCount * sizeof(MipFormat::Level));
+
+    const char padding[MipFormat::dataAlignment] = {};
+
+    for (uint32_t mip = levelCount; mip-- > 0;) {
+        file.write(padding, table[mip].offset - static_cast<uint64_t>(file.tellp()));
+        file.write(reinterpret_cast<const char*>(levels[mip].texels.data()), levels[mip].texels.size());
+    }
+
+    return static_cast<bool>(file);
+}
+
+} // MipFileWriter
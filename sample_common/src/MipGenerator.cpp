@@ -0,0 +1,352 @@
+#include "MipGenerator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <thread>
+
+#include "Trace.hpp"
+
+namespace MipGenerator {
+
+namespace {
+
+constexpr float pi = 3.14159265358979f;
+
+// The rows are handed to the threads by blocks, a level of a few texels is done by one thread
+constexpr uint32_t rowsPerJob = 16;
+
+struct Taps {
+    // The taps of destination texel i are first[i] to first[i + 1]
+    std::vector<uint32_t> first;
+    std::vector<uint32_t> indices;
+    std::vector<float> weights;
+};
+
+float sinc(float x) {
+    return x == 0.0f ? 1.0f : std::sin(pi * x) / (pi * x);
+}
+
+// Modified Bessel function of the first kind, order 0
+float besselI0(float x) {
+    float sum = 1.0f;
+    float term = 1.0f;
+
+    for (uint32_t k = 1; k < 20; ++k) {
+        term *= (x * x / 4.0f) / (k * k);
+        sum += term;
+    }
+
+    return sum;
+}
+
+float getSupport(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Box:
+            return 0.5f;
+        case Kernel::Triangle:
+            return 1.0f;
+        case Kernel::Kaiser:
+            return 2.0f;
+        case Kernel::Lanczos3:
+            return 3.0f;
+    }
+
+    return 0.5f;
+}
+
+float evaluate(Kernel kernel, float x) {
+    x = std::abs(x);
+
+    switch (kernel) {
+        case Kernel::Box:
+            return x <= 0.5f ? 1.0f : 0.0f;
+        case Kernel::Triangle:
+            return std::max(0.0f, 1.0f - x);
+        case Kernel::Kaiser: {
+            constexpr float alpha = 4.0f;
+
+            if (x >= 2.0f) {
+                return 0.0f;
+            }
+
+            const float t = x / 2.0f;
+            return sinc(x) * besselI0(alpha * std::sqrt(1.0f - t * t)) / besselI0(alpha);
+        }
+        case Kernel::Lanczos3:
+            return x < 3.0f ? sinc(x) * sinc(x / 3.0f) : 0.0f;
+    }
+
+    return 0.0f;
+}
+
+// The weights of the source texels of each destination texel, the distances are in destination texels
+Taps computeTaps(Kernel kernel, uint32_t sourceSize, uint32_t destinationSize) {
+    Taps taps;
+
+    const float scale = static_cast<float>(sourceSize) / destinationSize;
+    const float radius = getSupport(kernel) * scale;
+
+    taps.first.reserve(destinationSize + 1);
+
+    for (uint32_t i = 0; i < destinationSize; ++i) {
+        taps.first.push_back(static_cast<uint32_t>(taps.indices.size()));
+
+        const float center = (i + 0.5f) * scale;
+        const int32_t begin = static_cast<int32_t>(std::floor(center - radius));
+        const int32_t end = static_cast<int32_t>(std::ceil(center + radius));
+
+        const size_t firstWeight = taps.weights.size();
+        float sum = 0.0f;
+
+        for (int32_t j = begin; j <= end; ++j) {
+            const float weight = evaluate(kernel, (j + 0.5f - center) / scale);
+
+            if (weight == 0.0f) {
+                continue;
+            }
+
+            taps.indices.push_back(static_cast<uint32_t>(std::min(std::max(j, 0), static_cast<int32_t>(sourceSize) - 1)));
+            taps.weights.push_back(weight);
+            sum += weight;
+        }
+
+        for (size_t j = firstWeight; j < taps.weights.size(); ++j) {
+            taps.weights[j] /= sum;
+        }
+    }
+
+    taps.first.push_back(static_cast<uint32_t>(taps.indices.size()));
+
+    return taps;
+}
+
+void parallelFor(uint32_t count, uint32_t threadCount, const std::function<void(uint32_t)>& function) {
+    std::atomic<uint32_t> next{0};
+
+    const auto worker = [&next, count, &function]() {
+        SAMPLE_TRACE_ZONE("mip job");
+
+        for (uint32_t i = next++; i < count; i = next++) {
+            function(i);
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (uint32_t i = 1; i < std::min(threadCount, count); ++i) {
+        threads.emplace_back([&worker]() {
+            SAMPLE_TRACE_THREAD_NAME("mip worker");
+            worker();
+        });
+    }
+
+    worker();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+// Calls function(begin, end) on blocks of rows
+void parallelRows(uint32_t rowCount, uint32_t threadCount, const std::function<void(uint32_t, uint32_t)>& function) {
+    parallelFor((rowCount + rowsPerJob - 1) / rowsPerJob, threadCount, [rowCount, &function](uint32_t job) {
+        function(job * rowsPerJob, std::min(rowCount, (job + 1) * rowsPerJob));
+    });
+}
+
+void renormalize(float* texels, size_t pixelCount) {
+    for (size_t i = 0; i < pixelCount; ++i) {
+        float* texel = texels + i * 4;
+
+        const float x = texel[0] * 2.0f - 1.0f;
+        const float y = texel[1] * 2.0f - 1.0f;
+        const float z = texel[2] * 2.0f - 1.0f;
+        const float length = std::sqrt(x * x + y * y + z * z);
+
+        // The normals of a block can cancel out, it faces the surface then
+        if (length < 1e-6f) {
+            texel[0] = 0.5f;
+            texel[1] = 0.5f;
+            texel[2] = 1.0f;
+            continue;
+        }
+
+        texel[0] = x / length * 0.5f + 0.5f;
+        texel[1] = y / length * 0.5f + 0.5f;
+        texel[2] = z / length * 0.5f + 0.5f;
+    }
+}
+
+// Renormalizes the normals of a filtered row, then encodes it to RGBA8
+void encodeRow(float* row, uint32_t width, const Settings& settings, bool srgb, uint8_t* texels) {
+    if (settings.content == Content::Normal) {
+        renormalize(row, width);
+    }
+
+    PixelConvert::encode(row, texels, width, srgb, settings.path);
+}
+
+} // anonymous
+
+const char* getName(Kernel kernel) {
+    switch (kernel) {
+        case Kernel::Box:
+            return "box";
+        case Kernel::Triangle:
+            return "triangle";
+        case Kernel::Kaiser:
+            return "kaiser";
+        case Kernel::Lanczos3:
+            return "lanczos3";
+    }
+
+    return "unknown";
+}
+
+const char* getName(Content content) {
+    switch (content) {
+        case Content::Color:
+            return "color";
+        case Content::Linear:
+            return "linear";
+        case Content::Normal:
+            return "normal";
+    }
+
+    return "unknown";
+}
+
+void generate(uint32_t width, uint32_t height, const uint8_t* texels, const Settings& settings, std::vector<Level>& levels) {
+    SAMPLE_TRACE_ZONE("MipGenerator::generate");
+
+    const bool srgb = settings.content == Content::Color;
+    const uint32_t threadCount = std::max(1u, settings.threadCount);
+
+    levels.clear();
+    levels.push_back({width, height, std::vector<uint8_t>(texels, texels + size_t(width) * height * 4)});
+
+    // The linear texels of the previous level, the first one is decoded row by row when it is filtered
+    std::vector<float> source;
+    std::vector<float> horizontal;
+    std::vector<float> destination;
+
+    while (levels.back().width > 1 || levels.back().height > 1) {
+        SAMPLE_TRACE_ZONE("mip level");
+
+        const uint32_t sourceWidth = levels.back().width;
+        const uint32_t sourceHeight = levels.back().height;
+        const uint8_t* sourceTexels = levels.back().texels.data();
+
+        const uint32_t destinationWidth = std::max(1u, sourceWidth / 2);
+        const uint32_t destinationHeight = std::max(1u, sourceHeight / 2);
+
+        const bool decoded = !source.empty();
+
+        // A box halving a level exactly weights each 2x2 block by a quarter, the average of PixelConvert::downsample
+        const bool halvedByBox = settings.kernel == Kernel::Box
+            && (sourceWidth == 1 || sourceWidth % 2 == 0)
+            && (sourceHeight == 1 || sourceHeight % 2 == 0);
+
+        if (halvedByBox) {
+            const size_t sourceRowSize = size_t(sourceWidth) * 4;
+
+            if (!decoded) {
+                source.resize(sourceRowSize * sourceHeight);
+
+                parallelRows(sourceHeight, threadCount, [&](uint32_t begin, uint32_t end) {
+                    PixelConvert::decode(sourceTexels + begin * sourceRowSize, source.data() + begin * sourceRowSize, size_t(end - begin) * sourceWidth, srgb, settings.path);
+                });
+            }
+
+            destination.resize(size_t(destinationWidth) * destinationHeight * 4);
+            levels.push_back({destinationWidth, destinationHeight, std::vector<uint8_t>(size_t(destinationWidth) * destinationHeight * 4)});
+
+            uint8_t* destinationTexels = levels.back().texels.data();
+            const size_t rowSize = size_t(destinationWidth) * 4;
+
+            parallelRows(destinationHeight, threadCount, [&](uint32_t begin, uint32_t end) {
+                // The source rows of the block, a single one for a level of height 1
+                const uint32_t sourceRowCount = std::min(end * 2, sourceHeight) - begin * 2;
+
+                PixelConvert::downsample(source.data() + begin * 2 * sourceRowSize, sourceWidth, sourceRowCount, destination.data() + begin * rowSize, settings.path);
+
+                for (uint32_t y = begin; y < end; ++y) {
+                    encodeRow(destination.data() + y * rowSize, destinationWidth, settings, srgb, destinationTexels + y * rowSize);
+                }
+            });
+
+            source.swap(destination);
+            continue;
+        }
+
+        const Taps columns = computeTaps(settings.kernel, sourceWidth, destinationWidth);
+        const Taps rows = computeTaps(settings.kernel, sourceHeight, destinationHeight);
+
+        // Filter the rows
+        horizontal.resize(size_t(destinationWidth) * sourceHeight * 4);
+
+        parallelRows(sourceHeight, threadCount, [&](uint32_t begin, uint32_t end) {
+            std::vector<float> decodedRow(decoded ? 0 : size_t(sourceWidth) * 4);
+
+            for (uint32_t y = begin; y < end; ++y) {
+                const float* row = source.data() + size_t(y) * sourceWidth * 4;
+
+                if (!decoded) {
+                    PixelConvert::decode(sourceTexels + size_t(y) * sourceWidth * 4, decodedRow.data(), sourceWidth, srgb, settings.path);
+                    row = decodedRow.data();
+                }
+
+                float* out = horizontal.data() + size_t(y) * destinationWidth * 4;
+
+                for (uint32_t x = 0; x < destinationWidth; ++x) {
+                    float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+                    for (uint32_t tap = columns.first[x]; tap < columns.first[x + 1]; ++tap) {
+                        const float* texel = row + columns.indices[tap] * 4;
+                        const float weight = columns.weights[tap];
+
+                        for (uint32_t c = 0; c < 4; ++c) {
+                            sum[c] += texel[c] * weight;
+                        }
+                    }
+
+                    for (uint32_t c = 0; c < 4; ++c) {
+                        out[x * 4 + c] = sum[c];
+                    }
+                }
+            }
+        });
+
+        // Filter the columns, then encode the level
+        destination.resize(size_t(destinationWidth) * destinationHeight * 4);
+        levels.push_back({destinationWidth, destinationHeight, std::vector<uint8_t>(size_t(destinationWidth) * destinationHeight * 4)});
+
+        uint8_t* destinationTexels = levels.back().texels.data();
+        const size_t rowSize = size_t(destinationWidth) * 4;
+
+        parallelRows(destinationHeight, threadCount, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t y = begin; y < end; ++y) {
+                float* out = destination.data() + y * rowSize;
+                std::fill(out, out + rowSize, 0.0f);
+
+                for (uint32_t tap = rows.first[y]; tap < rows.first[y + 1]; ++tap) {
+                    const float* row = horizontal.data() + rows.indices[tap] * rowSize;
+                    const float weight = rows.weights[tap];
+
+                    for (size_t i = 0; i < rowSize; ++i) {
+                        out[i] += row[i] * weight;
+                    }
+                }
+
+                encodeRow(out, destinationWidth, settings, srgb, destinationTexels + y * rowSize);
+            }
+        });
+
+        // The next level is filtered from the linear texels, not from the rounded ones
+        source.swap(destination);
+    }
+}
+
+} // MipGenerator
@@ -0,0 +1,298 @@
+#include "MipStreamer.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include <imgui.h>
+
+#include <lug/System/Logger/Logger.hpp>
+
+constexpr uint32_t MipStreamer::invalidTexture;
+
+namespace {
+
+constexpr float bytesPerMegabyte = 1024.0f * 1024.0f;
+
+bool readLevel(std::ifstream& file, const MipFormat::Level& entry, MipStreamer::Level& level) {
+    level.width = entry.width;
+    level.height = entry.height;
+    level.data.resize(static_cast<size_t>(entry.size));
+
+    file.seekg(static_cast<std::streamoff>(entry.offset));
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(level.data.data()), level.data.size()));
+}
+
+} // anonymous
+
+MipStreamer::MipStreamer(uint64_t bytesPerSecond) : _bytesPerSecond(bytesPerSecond) {}
+
+MipStreamer::~MipStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+
+    _stopCondition.notify_all();
+
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+uint32_t MipStreamer::addTexture(const std::string& filename) {
+    if (_thread.joinable()) {
+        LUG_LOG.error("MipStreamer: Can't add {} once the streaming started", filename);
+        return invalidTexture;
+    }
+
+    const Clock::time_point start = Clock::now();
+
+    // The times of the stats start with the first texture
+    if (_textures.empty()) {
+        _start = start;
+    }
+
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+
+    if (!file) {
+        LUG_LOG.error("MipStreamer: Can't open {}", filename);
+        return invalidTexture;
+    }
+
+    const uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+
+    MipFormat::Header header;
+
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || std::memcmp(header.magic, MipFormat::magic, sizeof(header.magic)) != 0
+        || header.version != MipFormat::version
+        || header.levelCount == 0
+        || header.levelCount != MipFormat::getLevelCount(header.width, header.height)
+        || header.format > static_cast<uint32_t>(BlockCompress::Format::Bc5)) {
+        LUG_LOG.error("MipStreamer: {} is not a cooked texture", filename);
+        return invalidTexture;
+    }
+
+    Texture texture{
+        filename,
+        static_cast<BlockCompress::Format>(header.format),
+        std::vector<MipFormat::Level>(header.levelCount),
+        std::vector<Level>(header.levelCount),
+        header.levelCount - 1
+    };
+
+    if (!file.read(reinterpret_cast<char*>(texture.table.data()), header.levelCount * sizeof(MipFormat::Level))) {
+        LUG_LOG.error("MipStreamer: Can't read the levels of {}", filename);
+        return invalidTexture;
+    }
+
+    for (uint32_t mip = 0; mip < header.levelCount; ++mip) {
+        const MipFormat::Level& level = texture.table[mip];
+
+        if (level.width != std::max(1u, header.width >> mip)
+            || level.height != std::max(1u, header.height >> mip)
+            || level.size != BlockCompress::getSize(texture.format, level.width, level.height)
+            || level.offset > fileSize
+            || level.size > fileSize - level.offset) {
+            LUG_LOG.error("MipStreamer: The level {} of {} is invalid", mip, filename);
+            return invalidTexture;
+        }
+    }
+
+    // The coarsest level is there for the first frame
+    if (!readLevel(file, texture.table[texture.residentMip], texture.levels[texture.residentMip])) {
+        LUG_LOG.error("MipStreamer: Can't read the level {} of {}", texture.residentMip, filename);
+        return invalidTexture;
+    }
+
+    _stats.initialMilliseconds += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    _stats.initialBytes += texture.table[texture.residentMip].size;
+    _pendingLevelCount += texture.residentMip;
+
+    _textures.push_back(std::move(texture));
+
+    return static_cast<uint32_t>(_textures.size() - 1);
+}
+
+void MipStreamer::start() {
+    if (!_thread.joinable() && _pendingLevelCount > 0) {
+        _thread = std::thread(&MipStreamer::stream, this);
+    }
+}
+
+uint32_t MipStreamer::update() {
+    std::vector<std::pair<uint32_t, uint32_t>> readLevels;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        readLevels.swap(_readLevels);
+        _stats.failedTextureCount = _failedTextureCount;
+    }
+
+    // The levels of a texture are read coarsest first, each one is finer than the resident ones
+    for (const auto& read : readLevels) {
+        Texture& texture = _textures[read.first];
+
+        texture.residentMip = read.second;
+
+        _stats.streamedBytes += texture.table[read.second].size;
+        ++_stats.streamedLevelCount;
+        --_pendingLevelCount;
+    }
+
+    return static_cast<uint32_t>(readLevels.size());
+}
+
+void MipStreamer::endFrame() {
+    if (_textures.empty()) {
+        return;
+    }
+
+    const double milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - _start).count();
+
+    if (_stats.firstFrameMilliseconds < 0.0) {
+        _stats.firstFrameMilliseconds = milliseconds;
+    }
+
+    if (_stats.fullQualityMilliseconds < 0.0 && isComplete()) {
+        _stats.fullQualityMilliseconds = milliseconds;
+    }
+}
+
+bool MipStreamer::isComplete() const {
+    return _pendingLevelCount == 0;
+}
+
+uint32_t MipStreamer::getTextureCount() const {
+    return static_cast<uint32_t>(_textures.size());
+}
+
+BlockCompress::Format MipStreamer::getFormat(uint32_t texture) const {
+    return _textures[texture].format;
+}
+
+uint32_t MipStreamer::getMipCount(uint32_t texture) const {
+    return static_cast<uint32_t>(_textures[texture].table.size());
+}
+
+uint32_t MipStreamer::getMinLod(uint32_t texture) const {
+    return _textures[texture].residentMip;
+}
+
+const MipStreamer::Level& MipStreamer::getLevel(uint32_t texture, uint32_t mip) const {
+    return _textures[texture].levels[mip];
+}
+
+const MipStreamer::Stats& MipStreamer::getStats() const {
+    return _stats;
+}
+
+void MipStreamer::draw() {
+    ImGui::Begin("Mip streaming");
+    {
+        ImGui::SetWindowSize({300, 80 + 15.0f * _textures.size()});
+        ImGui::SetWindowPos({490, 190});
+
+        ImGui::Text("first frame: %.1f ms (coarsest levels: %.1f ms)", _stats.firstFrameMilliseconds, _stats.initialMilliseconds);
+
+        if (_stats.fullQualityMilliseconds < 0.0) {
+            ImGui::Text("full quality: streaming (%.1f MB)", _stats.streamedBytes / bytesPerMegabyte);
+        } else {
+            ImGui::Text("full quality: %.1f ms", _stats.fullQualityMilliseconds);
+        }
+
+        ImGui::Separator();
+
+        for (const Texture& texture : _textures) {
+            ImGui::Text(
+                "%s (%s): min LOD %u (%ux%u)",
+                texture.filename.c_str(),
+                BlockCompress::getName(texture.format),
+                texture.residentMip,
+                texture.table[texture.residentMip].width,
+                texture.table[texture.residentMip].height
+            );
+        }
+    }
+    ImGui::End();
+}
+
+void MipStreamer::logStats() const {
+    LUG_LOG.info(
+        "MipStreamer: First frame after {:.1f} ms ({:.1f} MB of coarsest levels read in {:.1f} ms)",
+        _stats.firstFrameMilliseconds, _stats.initialBytes / bytesPerMegabyte, _stats.initialMilliseconds
+    );
+
+    if (_stats.fullQualityMilliseconds < 0.0) {
+        LUG_LOG.info("MipStreamer: Full quality not reached ({} levels, {:.1f} MB streamed)", _stats.streamedLevelCount, _stats.streamedBytes / bytesPerMegabyte);
+    } else {
+        LUG_LOG.info(
+            "MipStreamer: Full quality after {:.1f} ms ({} levels, {:.1f} MB streamed)",
+            _stats.fullQualityMilliseconds, _stats.streamedLevelCount, _stats.streamedBytes / bytesPerMegabyte
+        );
+    }
+
+    if (_stats.failedTextureCount > 0) {
+        LUG_LOG.warn("MipStreamer: {} textures stopped streaming on a read error", _stats.failedTextureCount);
+    }
+}
+
+void MipStreamer::stream() {
+    const Clock::time_point start = Clock::now();
+
+    std::vector<std::ifstream> files;
+    std::vector<bool> failed(_textures.size(), false);
+
+    for (const Texture& texture : _textures) {
+        files.emplace_back(texture.filename, std::ios::binary);
+    }
+
+    uint64_t bytes = 0;
+
+    // One level of every texture before the next finer one, the whole scene sharpens evenly
+    for (uint32_t step = 1; ; ++step) {
+        bool read = false;
+
+        for (uint32_t id = 0; id < _textures.size(); ++id) {
+            Texture& texture = _textures[id];
+            const uint32_t levelCount = static_cast<uint32_t>(texture.table.size());
+
+            if (failed[id] || step >= levelCount) {
+                continue;
+            }
+
+            const uint32_t mip = levelCount - 1 - step;
+            read = true;
+
+            if (!readLevel(files[id], texture.table[mip], texture.levels[mip])) {
+                LUG_LOG.error("MipStreamer: Can't read the level {} of {}", mip, texture.filename);
+                failed[id] = true;
+
+                std::lock_guard<std::mutex> lock(_mutex);
+                ++_failedTextureCount;
+
+                continue;
+            }
+
+            bytes += texture.table[mip].size;
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            _readLevels.emplace_back(id, mip);
+
+            if (_bytesPerSecond > 0) {
+                const auto deadline = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(double(bytes) / _bytesPerSecond));
+                _stopCondition.wait_until(lock, deadline, [this] { return _stop; });
+            }
+
+            if (_stop) {
+                return;
+            }
+        }
+
+        if (!read) {
+            return;
+        }
+    }
+}
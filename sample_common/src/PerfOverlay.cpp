@@ -0,0 +1,174 @@
+#include "PerfOverlay.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+#include <imgui.h>
+
+#include <lug/System/Logger/Logger.hpp>
+
+constexpr uint32_t PerfOverlay::maxSections;
+constexpr uint32_t PerfOverlay::maxCounters;
+constexpr uint32_t PerfOverlay::invalidIndex;
+
+PerfOverlay::ScopedSection::ScopedSection(PerfOverlay& overlay, uint32_t section) : _overlay(overlay), _section(section), _start(std::chrono::high_resolution_clock::now()) {}
+
+PerfOverlay::ScopedSection::~ScopedSection() {
+    _overlay.addSectionTime(_section, std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - _start).count());
+}
+
+// The first record goes to the index 0, so that the records are in order until the buffer is full
+PerfOverlay::PerfOverlay(uint32_t capacity) : _records(std::max(capacity, 1u)), _head(static_cast<uint32_t>(_records.size() - 1)) {
+    if (!capacity) {
+        LUG_LOG.error("PerfOverlay: The capacity can't be 0, 1 frame is recorded");
+    }
+}
+
+uint32_t PerfOverlay::addSection(const std::string& name) {
+    if (_sections.size() == maxSections) {
+        LUG_LOG.error("PerfOverlay: Can't add the section {}, there are already {}", name, maxSections);
+        return invalidIndex;
+    }
+
+    _sections.push_back(name);
+    return static_cast<uint32_t>(_sections.size() - 1);
+}
+
+uint32_t PerfOverlay::addCounter(const std::string& name) {
+    if (_counters.size() == maxCounters) {
+        LUG_LOG.error("PerfOverlay: Can't add the counter {}, there are already {}", name, maxCounters);
+        return invalidIndex;
+    }
+
+    _counters.push_back(name);
+    return static_cast<uint32_t>(_counters.size() - 1);
+}
+
+void PerfOverlay::beginFrame(float frameMilliseconds) {
+    _head = (_head + 1) % _records.size();
+    _count = std::min(_count + 1, static_cast<uint32_t>(_records.size()));
+
+    Record& record = _records[_head];
+
+    record = {};
+    record.frameMilliseconds = frameMilliseconds;
+}
+
+void PerfOverlay::addSectionTime(uint32_t section, float milliseconds) {
+    if (section == invalidIndex) {
+        return;
+    }
+
+    _records[_head].sectionMilliseconds[section] += milliseconds;
+}
+
+void PerfOverlay::setCounter(uint32_t counter, uint64_t value) {
+    if (counter == invalidIndex) {
+        return;
+    }
+
+    _records[_head].counters[counter] = value;
+}
+
+void PerfOverlay::draw() const {
+    if (!_visible || !_count) {
+        return;
+    }
+
+    ImGui::Begin("Performance");
+    {
+        ImGui::SetWindowSize({300, 150 + 15.0f * (_sections.size() + _counters.size())});
+        ImGui::SetWindowPos({10, 300});
+
+        float average = 0.0f;
+        float maximum = 0.0f;
+
+        for (uint32_t i = 0; i < _count; ++i) {
+            const float frameMilliseconds = _records[getRecordIndex(i)].frameMilliseconds;
+
+            average += frameMilliseconds;
+            maximum = std::max(maximum, frameMilliseconds);
+        }
+
+        average /= _count;
+
+        ImGui::Text("Frame: %.2f ms (avg %.2f ms, max %.2f ms)", _records[_head].frameMilliseconds, average, maximum);
+
+        // Plot straight from the ring buffer, the oldest record is after the head
+        ImGui::PlotLines(
+            "##frames",
+            &_records[0].frameMilliseconds,
+            static_cast<int>(_count),
+            static_cast<int>(getRecordIndex(0)),
+            nullptr,
+            0.0f,
+            maximum,
+            {280, 60},
+            sizeof(Record)
+        );
+
+        // The current record is still being filled, show the previous one
+        const Record& previous = _records[getRecordIndex(_count > 1 ? _count - 2 : 0)];
+
+        for (size_t i = 0; i < _sections.size(); ++i) {
+            ImGui::Text("%s: %.3f ms", _sections[i].c_str(), previous.sectionMilliseconds[i]);
+        }
+
+        for (size_t i = 0; i < _counters.size(); ++i) {
+            ImGui::Text("%s: %llu", _counters[i].c_str(), static_cast<unsigned long long>(previous.counters[i]));
+        }
+    }
+    ImGui::End();
+}
+
+void PerfOverlay::toggle() {
+    _visible = !_visible;
+}
+
+bool PerfOverlay::isVisible() const {
+    return _visible;
+}
+
+bool PerfOverlay::dumpCsv(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file) {
+        return false;
+    }
+
+    file << "frame,frame_ms";
+
+    for (const std::string& section : _sections) {
+        file << "," << section << "_ms";
+    }
+
+    for (const std::string& counter : _counters) {
+        file << "," << counter;
+    }
+
+    file << "\n";
+
+    for (uint32_t i = 0; i < _count; ++i) {
+        const Record& record = _records[getRecordIndex(i)];
+
+        file << i << "," << record.frameMilliseconds;
+
+        for (size_t j = 0; j < _sections.size(); ++j) {
+            file << "," << record.sectionMilliseconds[j];
+        }
+
+        for (size_t j = 0; j < _counters.size(); ++j) {
+            file << "," << record.counters[j];
+        }
+
+        file << "\n";
+    }
+
+    return !!file;
+}
+
+uint32_t PerfOverlay::getRecordIndex(uint32_t i) const {
+    const uint32_t size = static_cast<uint32_t>(_records.size());
+    const uint32_t oldest = _count == size ? (_head + 1) % size : 0;
+
+    return (oldest + i) % size;
+}
@@ -0,0 +1,588 @@
+#include "PixelConvert.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define PIXEL_CONVERT_X86
+
+    #include <immintrin.h>
+
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #define PIXEL_CONVERT_NEON
+
+    #include <arm_neon.h>
+#endif
+
+// The x86 paths are built for their instruction set whatever the flags of the build, and only run if the CPU has it
+#if defined(PIXEL_CONVERT_X86) && !defined(_MSC_VER)
+    #define PIXEL_CONVERT_TARGET(instructions) __attribute__((target(instructions)))
+#else
+    #define PIXEL_CONVERT_TARGET(instructions)
+#endif
+
+namespace PixelConvert {
+
+namespace {
+
+struct Tables {
+    // The texel value of each channel to its linear value, the offset of channel c is 256 * c
+    float srgbToLinear[4 * 256];
+    float unormToLinear[4 * 256];
+
+    // A color channel quantized to 16 bits to its sRGB texel, the smallest steps of the curve are above 1 / 65535
+    uint8_t linearToSrgb[65536];
+
+    Tables() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            const float value = i * (1.0f / 255.0f);
+            const float linear = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+
+            for (uint32_t c = 0; c < 4; ++c) {
+                srgbToLinear[c * 256 + i] = c < 3 ? linear : value;
+                unormToLinear[c * 256 + i] = value;
+            }
+        }
+
+        for (uint32_t i = 0; i < 65536; ++i) {
+            const float linear = i / 65535.0f;
+            const float value = linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+
+            linearToSrgb[i] = static_cast<uint8_t>(std::min(255.0f, value * 255.0f + 0.5f));
+        }
+    }
+};
+
+const Tables& getTables() {
+    static const Tables tables;
+    return tables;
+}
+
+// The scale of each channel before the rounding, the sRGB color channels are looked up in linearToSrgb
+const float unormScales[4] = {255.0f, 255.0f, 255.0f, 255.0f};
+const float srgbScales[4] = {65535.0f, 65535.0f, 65535.0f, 255.0f};
+
+inline uint8_t encodeChannel(float value, uint32_t channel, bool srgb, const Tables& tables) {
+    const float scale = srgb ? srgbScales[channel] : unormScales[channel];
+    const uint32_t index = static_cast<uint32_t>(std::min(1.0f, std::max(0.0f, value)) * scale + 0.5f);
+
+    return srgb && channel < 3 ? tables.linearToSrgb[index] : static_cast<uint8_t>(index);
+}
+
+// Scalar
+
+void rgbToRgbaScalar(const uint8_t* rgb, uint8_t* rgba, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        rgba[i * 4 + 0] = rgb[i * 3 + 0];
+        rgba[i * 4 + 1] = rgb[i * 3 + 1];
+        rgba[i * 4 + 2] = rgb[i * 3 + 2];
+        rgba[i * 4 + 3] = 255;
+    }
+}
+
+void decodeScalar(const uint8_t* rgba, float* linear, size_t begin, size_t end, bool srgb) {
+    const float* table = srgb ? getTables().srgbToLinear : getTables().unormToLinear;
+
+    for (size_t i = begin * 4; i < end * 4; ++i) {
+        linear[i] = table[(i % 4) * 256 + rgba[i]];
+    }
+}
+
+void encodeScalar(const float* linear, uint8_t* rgba, size_t begin, size_t end, bool srgb) {
+    const Tables& tables = getTables();
+
+    for (size_t i = begin * 4; i < end * 4; ++i) {
+        rgba[i] = encodeChannel(linear[i], static_cast<uint32_t>(i % 4), srgb, tables);
+    }
+}
+
+void downsampleScalar(const float* row0, const float* row1, uint32_t width, float* destination, uint32_t begin, uint32_t end) {
+    for (uint32_t x = begin; x < end; ++x) {
+        const uint32_t x0 = std::min(x * 2, width - 1) * 4;
+        const uint32_t x1 = std::min(x * 2 + 1, width - 1) * 4;
+
+        for (uint32_t c = 0; c < 4; ++c) {
+            // Summed in the order of the vectorized paths
+            destination[x * 4 + c] = ((row0[x0 + c] + row0[x1 + c]) + (row1[x0 + c] + row1[x1 + c])) * 0.25f;
+        }
+    }
+}
+
+#if defined(PIXEL_CONVERT_X86)
+
+// SSE4.1, the max before the min turns a NaN in 0 like the scalar path
+
+PIXEL_CONVERT_TARGET("sse4.1")
+void rgbToRgbaSse41(const uint8_t* rgb, uint8_t* rgba, size_t pixelCount) {
+    const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+    size_t i = 0;
+
+    // 4 texels from each 16 bytes load, the last 4 bytes belong to the next ones
+    for (; i + 6 <= pixelCount; i += 4) {
+        const __m128i texels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb + i * 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + i * 4), _mm_or_si128(_mm_shuffle_epi8(texels, shuffle), alpha));
+    }
+
+    rgbToRgbaScalar(rgb, rgba, i, pixelCount);
+}
+
+PIXEL_CONVERT_TARGET("sse4.1")
+void decodeSse41(const uint8_t* rgba, float* linear, size_t pixelCount, bool srgb) {
+    size_t i = 0;
+
+    if (srgb) {
+        const float* table = getTables().srgbToLinear;
+
+        for (; i < pixelCount; ++i) {
+            const uint8_t* texel = rgba + i * 4;
+            _mm_storeu_ps(linear + i * 4, _mm_setr_ps(table[texel[0]], table[256 + texel[1]], table[512 + texel[2]], table[768 + texel[3]]));
+        }
+    } else {
+        const __m128 scale = _mm_set1_ps(1.0f / 255.0f);
+
+        for (; i < pixelCount; ++i) {
+            int32_t texel;
+            std::memcpy(&texel, rgba + i * 4, sizeof(texel));
+
+            const __m128i channels = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(texel));
+            _mm_storeu_ps(linear + i * 4, _mm_mul_ps(_mm_cvtepi32_ps(channels), scale));
+        }
+    }
+}
+
+PIXEL_CONVERT_TARGET("sse4.1")
+void encodeSse41(const float* linear, uint8_t* rgba, size_t pixelCount, bool srgb) {
+    const Tables& tables = getTables();
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 scale = _mm_loadu_ps(srgb ? srgbScales : unormScales);
+
+    size_t i = 0;
+
+    if (srgb) {
+        alignas(16) int32_t indices[4];
+
+        for (; i < pixelCount; ++i) {
+            const __m128 texel = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(linear + i * 4), zero), one);
+            _mm_store_si128(reinterpret_cast<__m128i*>(indices), _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(texel, scale), half)));
+
+            rgba[i * 4 + 0] = tables.linearToSrgb[indices[0]];
+            rgba[i * 4 + 1] = tables.linearToSrgb[indices[1]];
+            rgba[i * 4 + 2] = tables.linearToSrgb[indices[2]];
+            rgba[i * 4 + 3] = static_cast<uint8_t>(indices[3]);
+        }
+    } else {
+        // 4 texels packed together in 16 bytes
+        for (; i + 4 <= pixelCount; i += 4) {
+            __m128i channels[4];
+
+            for (uint32_t j = 0; j < 4; ++j) {
+                const __m128 texel = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(linear + (i + j) * 4), zero), one);
+                channels[j] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(texel, scale), half));
+            }
+
+            const __m128i packed = _mm_packus_epi16(_mm_packus_epi32(channels[0], channels[1]), _mm_packus_epi32(channels[2], channels[3]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + i * 4), packed);
+        }
+    }
+
+    encodeScalar(linear, rgba, i, pixelCount, srgb);
+}
+
+PIXEL_CONVERT_TARGET("sse4.1")
+void downsampleSse41(const float* row0, const float* row1, uint32_t width, float* destination, uint32_t destinationWidth) {
+    const __m128 quarter = _mm_set1_ps(0.25f);
+
+    uint32_t x = 0;
+
+    // Both source texels are inside the row
+    for (; x * 2 + 1 < width && x < destinationWidth; ++x) {
+        const __m128 sum = _mm_add_ps(
+            _mm_add_ps(_mm_loadu_ps(row0 + x * 8), _mm_loadu_ps(row0 + x * 8 + 4)),
+            _mm_add_ps(_mm_loadu_ps(row1 + x * 8), _mm_loadu_ps(row1 + x * 8 + 4))
+        );
+
+        _mm_storeu_ps(destination + x * 4, _mm_mul_ps(sum, quarter));
+    }
+
+    downsampleScalar(row0, row1, width, destination, x, destinationWidth);
+}
+
+// AVX2
+
+PIXEL_CONVERT_TARGET("avx2")
+void rgbToRgbaAvx2(const uint8_t* rgb, uint8_t* rgba, size_t pixelCount) {
+    // The shuffle stays in each 128 bits lane, the 12 bytes of the upper texels are moved to the upper lane first
+    const __m256i permute = _mm256_setr_epi32(0, 1, 2, 0, 3, 4, 5, 0);
+    const __m256i shuffle = _mm256_setr_epi8(
+        0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+        0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1
+    );
+    const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+
+    size_t i = 0;
+
+    // 8 texels from each 32 bytes load, the last 8 bytes belong to the next ones
+    for (; i + 11 <= pixelCount; i += 8) {
+        const __m256i texels = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(rgb + i * 3)), permute);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(rgba + i * 4), _mm256_or_si256(_mm256_shuffle_epi8(texels, shuffle), alpha));
+    }
+
+    rgbToRgbaScalar(rgb, rgba, i, pixelCount);
+}
+
+PIXEL_CONVERT_TARGET("avx2")
+void decodeAvx2(const uint8_t* rgba, float* linear, size_t pixelCount, bool srgb) {
+    const float* table = srgb ? getTables().srgbToLinear : getTables().unormToLinear;
+
+    // The table of each channel is 256 floats after the previous one
+    const __m256i offsets = _mm256_setr_epi32(0, 256, 512, 768, 0, 256, 512, 768);
+
+    size_t i = 0;
+
+    for (; i + 2 <= pixelCount; i += 2) {
+        const __m256i channels = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(rgba + i * 4)));
+        _mm256_storeu_ps(linear + i * 4, _mm256_i32gather_ps(table, _mm256_add_epi32(channels, offsets), 4));
+    }
+
+    decodeScalar(rgba, linear, i, pixelCount, srgb);
+}
+
+PIXEL_CONVERT_TARGET("avx2")
+void encodeAvx2(const float* linear, uint8_t* rgba, size_t pixelCount, bool srgb) {
+    const Tables& tables = getTables();
+
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 half = _mm256_set1_ps(0.5f);
+
+    const float* scales = srgb ? srgbScales : unormScales;
+    const __m256 scale = _mm256_setr_ps(scales[0], scales[1], scales[2], scales[3], scales[0], scales[1], scales[2], scales[3]);
+
+    size_t i = 0;
+
+    if (srgb) {
+        alignas(32) int32_t indices[8];
+
+        for (; i + 2 <= pixelCount; i += 2) {
+            const __m256 texels = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(linear + i * 4), zero), one);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(indices), _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(texels, scale), half)));
+
+            for (uint32_t j = 0; j < 8; ++j) {
+                rgba[i * 4 + j] = j % 4 < 3 ? tables.linearToSrgb[indices[j]] : static_cast<uint8_t>(indices[j]);
+            }
+        }
+    } else {
+        // 8 texels packed together in 32 bytes, the packs interleave the lanes that are put back in order at the end
+        const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+        for (; i + 8 <= pixelCount; i += 8) {
+            __m256i channels[4];
+
+            for (uint32_t j = 0; j < 4; ++j) {
+                const __m256 texels = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(linear + (i + j * 2) * 4), zero), one);
+                channels[j] = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(texels, scale), half));
+            }
+
+            const __m256i packed = _mm256_packus_epi16(_mm256_packus_epi32(channels[0], channels[1]), _mm256_packus_epi32(channels[2], channels[3]));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(rgba + i * 4), _mm256_permutevar8x32_epi32(packed, order));
+        }
+    }
+
+    encodeScalar(linear, rgba, i, pixelCount, srgb);
+}
+
+PIXEL_CONVERT_TARGET("avx2")
+void downsampleAvx2(const float* row0, const float* row1, uint32_t width, float* destination, uint32_t destinationWidth) {
+    const __m256 quarter = _mm256_set1_ps(0.25f);
+
+    uint32_t x = 0;
+
+    // 2 texels from the 4 source texels of each row, all inside the row
+    for (; x * 2 + 3 < width && x + 2 <= destinationWidth; x += 2) {
+        const __m256 a0 = _mm256_loadu_ps(row0 + x * 8);
+        const __m256 b0 = _mm256_loadu_ps(row0 + x * 8 + 8);
+        const __m256 a1 = _mm256_loadu_ps(row1 + x * 8);
+        const __m256 b1 = _mm256_loadu_ps(row1 + x * 8 + 8);
+
+        // The even source texels in one vector, the odd ones in the other
+        const __m256 sum0 = _mm256_add_ps(_mm256_permute2f128_ps(a0, b0, 0x20), _mm256_permute2f128_ps(a0, b0, 0x31));
+        const __m256 sum1 = _mm256_add_ps(_mm256_permute2f128_ps(a1, b1, 0x20), _mm256_permute2f128_ps(a1, b1, 0x31));
+
+        _mm256_storeu_ps(destination + x * 4, _mm256_mul_ps(_mm256_add_ps(sum0, sum1), quarter));
+    }
+
+    downsampleScalar(row0, row1, width, destination, x, destinationWidth);
+}
+
+bool hasSse41() {
+#if defined(_MSC_VER)
+    int registers[4];
+    __cpuid(registers, 1);
+
+    return (registers[2] & (1 << 19)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.1");
+#endif
+}
+
+bool hasAvx2() {
+#if defined(_MSC_VER)
+    int registers[4];
+    __cpuid(registers, 0);
+
+    if (registers[0] < 7) {
+        return false;
+    }
+
+    // The OS has to save the AVX registers (OSXSAVE and the YMM state enabled)
+    __cpuid(registers, 1);
+
+    if ((registers[2] & (1 << 27)) == 0 || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+
+    __cpuidex(registers, 7, 0);
+
+    return (registers[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+#if defined(PIXEL_CONVERT_NEON)
+
+// NEON
+
+void rgbToRgbaNeon(const uint8_t* rgb, uint8_t* rgba, size_t pixelCount) {
+    size_t i = 0;
+
+    for (; i + 16 <= pixelCount; i += 16) {
+        const uint8x16x3_t texels = vld3q_u8(rgb + i * 3);
+
+        uint8x16x4_t expanded;
+        expanded.val[0] = texels.val[0];
+        expanded.val[1] = texels.val[1];
+        expanded.val[2] = texels.val[2];
+        expanded.val[3] = vdupq_n_u8(255);
+
+        vst4q_u8(rgba + i * 4, expanded);
+    }
+
+    rgbToRgbaScalar(rgb, rgba, i, pixelCount);
+}
+
+void decodeNeon(const uint8_t* rgba, float* linear, size_t pixelCount, bool srgb) {
+    if (srgb) {
+        decodeScalar(rgba, linear, 0, pixelCount, srgb);
+        return;
+    }
+
+    const float32x4_t scale = vdupq_n_f32(1.0f / 255.0f);
+
+    size_t i = 0;
+
+    // 4 texels widened from 16 bytes
+    for (; i + 4 <= pixelCount; i += 4) {
+        const uint8x16_t texels = vld1q_u8(rgba + i * 4);
+        const uint16x8_t low = vmovl_u8(vget_low_u8(texels));
+        const uint16x8_t high = vmovl_u8(vget_high_u8(texels));
+
+        vst1q_f32(linear + i * 4 + 0, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(low))), scale));
+        vst1q_f32(linear + i * 4 + 4, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(low))), scale));
+        vst1q_f32(linear + i * 4 + 8, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(high))), scale));
+        vst1q_f32(linear + i * 4 + 12, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(high))), scale));
+    }
+
+    decodeScalar(rgba, linear, i, pixelCount, srgb);
+}
+
+void encodeNeon(const float* linear, uint8_t* rgba, size_t pixelCount, bool srgb) {
+    if (srgb) {
+        encodeScalar(linear, rgba, 0, pixelCount, srgb);
+        return;
+    }
+
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    const float32x4_t scale = vdupq_n_f32(255.0f);
+
+    size_t i = 0;
+
+    // 4 texels narrowed to 16 bytes
+    for (; i + 4 <= pixelCount; i += 4) {
+        uint16x4_t channels[4];
+
+        for (uint32_t j = 0; j < 4; ++j) {
+            const float32x4_t texel = vminq_f32(one, vmaxq_f32(zero, vld1q_f32(linear + (i + j) * 4)));
+            channels[j] = vmovn_u32(vcvtq_u32_f32(vaddq_f32(vmulq_f32(texel, scale), half)));
+        }
+
+        const uint8x8_t low = vmovn_u16(vcombine_u16(channels[0], channels[1]));
+        const uint8x8_t high = vmovn_u16(vcombine_u16(channels[2], channels[3]));
+
+        vst1q_u8(rgba + i * 4, vcombine_u8(low, high));
+    }
+
+    encodeScalar(linear, rgba, i, pixelCount, srgb);
+}
+
+void downsampleNeon(const float* row0, const float* row1, uint32_t width, float* destination, uint32_t destinationWidth) {
+    const float32x4_t quarter = vdupq_n_f32(0.25f);
+
+    uint32_t x = 0;
+
+    for (; x * 2 + 1 < width && x < destinationWidth; ++x) {
+        const float32x4_t sum = vaddq_f32(
+            vaddq_f32(vld1q_f32(row0 + x * 8), vld1q_f32(row0 + x * 8 + 4)),
+            vaddq_f32(vld1q_f32(row1 + x * 8), vld1q_f32(row1 + x * 8 + 4))
+        );
+
+        vst1q_f32(destination + x * 4, vmulq_f32(sum, quarter));
+    }
+
+    downsampleScalar(row0, row1, width, destination, x, destinationWidth);
+}
+
+#endif
+
+} // anonymous
+
+bool isSupported(Path path) {
+    switch (path) {
+        case Path::Scalar:
+            return true;
+#if defined(PIXEL_CONVERT_X86)
+        case Path::Sse41: {
+            static const bool supported = hasSse41();
+            return supported;
+        }
+        case Path::Avx2: {
+            static const bool supported = hasAvx2();
+            return supported;
+        }
+#elif defined(PIXEL_CONVERT_NEON)
+        case Path::Neon:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+Path getBestPath() {
+    for (Path path : {Path::Avx2, Path::Neon, Path::Sse41}) {
+        if (isSupported(path)) {
+            return path;
+        }
+    }
+
+    return Path::Scalar;
+}
+
+const char* getName(Path path) {
+    switch (path) {
+        case Path::Scalar:
+            return "scalar";
+        case Path::Sse41:
+            return "SSE4.1";
+        case Path::Avx2:
+            return "AVX2";
+        case Path::Neon:
+            return "NEON";
+    }
+
+    return "unknown";
+}
+
+void rgbToRgba(const uint8_t* rgb, uint8_t* rgba, size_t pixelCount, Path path) {
+    switch (path) {
+#if defined(PIXEL_CONVERT_X86)
+        case Path::Sse41:
+            return rgbToRgbaSse41(rgb, rgba, pixelCount);
+        case Path::Avx2:
+            return rgbToRgbaAvx2(rgb, rgba, pixelCount);
+#elif defined(PIXEL_CONVERT_NEON)
+        case Path::Neon:
+            return rgbToRgbaNeon(rgb, rgba, pixelCount);
+#endif
+        default:
+            return rgbToRgbaScalar(rgb, rgba, 0, pixelCount);
+    }
+}
+
+void decode(const uint8_t* rgba, float* linear, size_t pixelCount, bool srgb, Path path) {
+    switch (path) {
+#if defined(PIXEL_CONVERT_X86)
+        case Path::Sse41:
+            return decodeSse41(rgba, linear, pixelCount, srgb);
+        case Path::Avx2:
+            return decodeAvx2(rgba, linear, pixelCount, srgb);
+#elif defined(PIXEL_CONVERT_NEON)
+        case Path::Neon:
+            return decodeNeon(rgba, linear, pixelCount, srgb);
+#endif
+        default:
+            return decodeScalar(rgba, linear, 0, pixelCount, srgb);
+    }
+}
+
+void encode(const float* linear, uint8_t* rgba, size_t pixelCount, bool srgb, Path path) {
+    switch (path) {
+#if defined(PIXEL_CONVERT_X86)
+        case Path::Sse41:
+            return encodeSse41(linear, rgba, pixelCount, srgb);
+        case Path::Avx2:
+            return encodeAvx2(linear, rgba, pixelCount, srgb);
+#elif defined(PIXEL_CONVERT_NEON)
+        case Path::Neon:
+            return encodeNeon(linear, rgba, pixelCount, srgb);
+#endif
+        default:
+            return encodeScalar(linear, rgba, 0, pixelCount, srgb);
+    }
+}
+
+void downsample(const float* source, uint32_t width, uint32_t height, float* destination, Path path) {
+    const uint32_t destinationWidth = std::max(1u, width / 2);
+    const uint32_t destinationHeight = std::max(1u, height / 2);
+
+    for (uint32_t y = 0; y < destinationHeight; ++y) {
+        const float* row0 = source + size_t(std::min(y * 2, height - 1)) * width * 4;
+        const float* row1 = source + size_t(std::min(y * 2 + 1, height - 1)) * width * 4;
+        float* row = destination + size_t(y) * destinationWidth * 4;
+
+        switch (path) {
+#if defined(PIXEL_CONVERT_X86)
+            case Path::Sse41:
+                downsampleSse41(row0, row1, width, row, destinationWidth);
+                break;
+            case Path::Avx2:
+                downsampleAvx2(row0, row1, width, row, destinationWidth);
+                break;
+#elif defined(PIXEL_CONVERT_NEON)
+            case Path::Neon:
+                downsampleNeon(row0, row1, width, row, destinationWidth);
+                break;
+#endif
+            default:
+                downsampleScalar(row0, row1, width, row, 0, destinationWidth);
+                break;
+        }
+    }
+}
+
+} // PixelConvert
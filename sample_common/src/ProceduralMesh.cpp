@@ -0,0 +1,310 @@
+#include "ProceduralMesh.hpp"
+
+#include <cmath>
+
+#include <lug/Graphics/Builder/Mesh.hpp>
+#include <lug/Math/Geometry/Trigonometry.hpp>
+#include <lug/System/Logger/Logger.hpp>
+
+namespace ProceduralMesh {
+
+lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Mesh> buildCube(lug::Graphics::Renderer& renderer) {
+    const std::vector<lug::Math::Vec3f> positions = {
+        // Back
+        {-1.0f, -1.0f, -1.0f},
+        {1.0f, -1.0f, -1.0f},
+        {-1.0f, 1.0f, -1.0f},
+        {1.0f, 1.0f, -1.0f},
+
+        // Front
+        {-1.0f, -1.0f, 1.0f},
+        {1.0f, -1.0f, 1.0f},
+        {-1.0f, 1.0f, 1.0f},
+        {1.0f, 1.0f, 1.0f},
+
+        // Left
+        {-1.0f, -1.0f, -1.0f},
+        {-1.0f, -1.0f, 1.0f},
+        {-1.0f, 1.0f, -1.0f},
+        {-1.0f, 1.0f, 1.0f},
+
+        // Right
+        {1.0f, -1.0f, -1.0f},
+        {1.0f, -1.0f, 1.0f},
+        {1.0f, 1.0f, -1.0f},
+        {1.0f, 1.0f, 1.0f},
+
+        // Bottom
+        {-1.0f, -1.0f, -1.0f},
+        {-1.0f, -1.0f, 1.0f},
+        {1.0f, -1.0f, -1.0f},
+        {1.0f, -1.0f, 1.0f},
+
+        // Top
+        {-1.0f, 1.0f, -1.0f},
+        {-1.0f, 1.0f, 1.0f},
+        {1.0f, 1.0f, -1.0f},
+        {1.0f, 1.0f, 1.0}
+    };
+
+    const std::vector<lug::Math::Vec3f> normals = {
+        // Back
+        {0.0f, 0.0f, -1.0f},
+        {0.0f, 0.0f, -1.0f},
+        {0.0f, 0.0f, -1.0f},
+        {0.0f, 0.0f, -1.0f},
+
+        // Front
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 0.0f, 1.0f},
+
+        // Left
+        {-1.0f, 0.0f, 0.0f},
+        {-1.0f, 0.0f, 0.0f},
+        {-1.0f, 0.0f, 0.0f},
+        {-1.0f, 0.0f, 0.0f},
+
+        // Right
+        {1.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+
+        // Bottom
+        {0.0f, -1.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f},
+
+        // Top
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    };
+
+    const std::vector<lug::Math::Vec4f> colors = {
+        // Back
+        {0.0f, 0.0f, 1.0f, 1.0f},
+        {0.0f, 0.0f, 1.0f, 1.0f},
+        {0.0f, 0.0f, 1.0f, 1.0f},
+        {0.0f, 0.0f, 1.0f, 1.0f},
+
+        // Front
+        {1.0f, 0.0f, 1.0, 1.0f},
+        {1.0f, 0.0f, 1.0, 1.0f},
+        {1.0f, 0.0f, 1.0, 1.0f},
+        {1.0f, 0.0f, 1.0, 1.0f},
+
+        // Left
+        {1.0f, 0.0f, 0.0, 1.0f},
+        {1.0f, 0.0f, 0.0, 1.0f},
+        {1.0f, 0.0f, 0.0, 1.0f},
+        {1.0f, 0.0f, 0.0, 1.0f},
+
+        // Right
+        {1.0f, 1.0f, 0.0f, 1.0f},
+        {1.0f, 1.0f, 0.0f, 1.0f},
+        {1.0f, 1.0f, 0.0f, 1.0f},
+        {1.0f, 1.0f, 0.0f, 1.0f},
+
+        // Bottom
+        {0.0f, 1.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 0.0f, 1.0f},
+
+        // Top
+        {0.0f, 1.0f, 1.0f, 1.0f},
+        {0.0f, 1.0f, 1.0f, 1.0f},
+        {0.0f, 1.0f, 1.0f, 1.0f},
+        {0.0f, 1.0f, 1.0f, 1.0f}
+    };
+
+    const std::vector<uint16_t> indices = {
+        // Back
+        0, 2, 1,
+        1, 2, 3,
+
+        // Front
+        6, 4, 5,
+        7, 6, 5,
+
+        // Left
+        10, 8, 9,
+        11, 10, 9,
+
+        // Right
+        14, 13, 12,
+        15, 13, 14,
+
+        // Bottom
+        17, 16, 19,
+        19, 16, 18,
+
+        // Top
+        23, 20, 21,
+        22, 20, 23
+    };
+
+    // Build the mesh
+    lug::Graphics::Builder::Mesh meshBuilder(renderer);
+    meshBuilder.setName("cube");
+
+    lug::Graphics::Builder::Mesh::PrimitiveSet* primitiveSet = meshBuilder.addPrimitiveSet();
+
+    primitiveSet->setMode(lug::Graphics::Render::Mesh::PrimitiveSet::Mode::Triangles);
+
+    primitiveSet->addAttributeBuffer(
+        indices.data(),
+        sizeof(uint16_t),
+        static_cast<uint32_t>(indices.size()),
+        lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Indice
+    );
+
+    primitiveSet->addAttributeBuffer(
+        positions.data(),
+        sizeof(lug::Math::Vec3f),
+        static_cast<uint32_t>(positions.size()),
+        lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Position
+    );
+
+    primitiveSet->addAttributeBuffer(
+        normals.data(),
+        sizeof(lug::Math::Vec3f),
+        static_cast<uint32_t>(normals.size()),
+        lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Normal
+    );
+
+    primitiveSet->addAttributeBuffer(
+        colors.data(),
+        sizeof(lug::Math::Vec4f),
+        static_cast<uint32_t>(colors.size()),
+        lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Color
+    );
+
+    lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Mesh> mesh = meshBuilder.build();
+
+    if (!mesh) {
+        LUG_LOG.error("ProceduralMesh: Can't create the cube mesh");
+    }
+
+    return mesh;
+}
+
+void generateSphere(
+    uint32_t xSegments,
+    uint32_t ySegments,
+    std::vector<lug::Math::Vec3f>& positions,
+    std::vector<lug::Math::Vec3f>& normals,
+    std::vector<lug::Math::Vec2f>& uvs
+) {
+    positions.reserve(positions.size() + (xSegments + 1) * (ySegments + 1));
+    normals.reserve(normals.size() + (xSegments + 1) * (ySegments + 1));
+    uvs.reserve(uvs.size() + (xSegments + 1) * (ySegments + 1));
+
+    for (uint32_t y = 0; y <= ySegments; ++y) {
+        for (uint32_t x = 0; x <= xSegments; ++x) {
+            float xSegment = (float)x / (float)xSegments;
+            float ySegment = (float)y / (float)ySegments;
+            float xPos = std::cos(xSegment * 2.0f * lug::Math::pi<float>()) * std::sin(ySegment * lug::Math::pi<float>());
+            float yPos = std::cos(ySegment * lug::Math::pi<float>());
+            float zPos = std::sin(xSegment * 2.0f * lug::Math::pi<float>()) * std::sin(ySegment * lug::Math::pi<float>());
+
+            positions.push_back({xPos, yPos, zPos});
+            normals.push_back({xPos, yPos, zPos});
+            uvs.push_back({xSegment, ySegment});
+        }
+    }
+}
+
+void generateSphereTriangles(uint32_t xSegments, uint32_t ySegments, std::vector<uint16_t>& indices) {
+    indices.reserve(indices.size() + xSegments * ySegments * 6);
+
+    for (uint32_t y = 0; y < ySegments; ++y) {
+        for (uint32_t x = 0; x < xSegments; ++x) {
+            const uint16_t topLeft = static_cast<uint16_t>(y * (xSegments + 1) + x);
+            const uint16_t bottomLeft = static_cast<uint16_t>((y + 1) * (xSegments + 1) + x);
+
+            indices.insert(indices.end(), {
+                bottomLeft, topLeft, static_cast<uint16_t>(bottomLeft + 1),
+                topLeft, static_cast<uint16_t>(topLeft + 1), static_cast<uint16_t>(bottomLeft + 1)
+            });
+        }
+    }
+}
+
+lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Mesh> buildSphere(lug::Graphics::Renderer& renderer, uint32_t xSegments, uint32_t ySegments) {
+    std::vector<lug::Math::Vec3f> positions;
+    std::vector<lug::Math::Vec3f> normals;
+    std::vector<lug::Math::Vec2f> uvs;
+    std::vector<uint16_t> indices;
+
+    generateSphere(xSegments, ySegments, positions, normals, uvs);
+
+    // The rows alternate their direction, the strip goes back and forth without degenerate triangles
+    bool oddRow = false;
+    for (uint32_t y = 0; y < ySegments; ++y) {
+        if (!oddRow) {
+            for (uint32_t x = 0; x <= xSegments; ++x) {
+                indices.push_back(static_cast<uint16_t>((y + 1) * (xSegments + 1) + x));
+                indices.push_back(static_cast<uint16_t>(y       * (xSegments + 1) + x));
+            }
+        } else {
+            for (uint32_t x = xSegments + 1; x-- > 0;) {
+                indices.push_back(static_cast<uint16_t>(y       * (xSegments + 1) + x));
+                indices.push_back(static_cast<uint16_t>((y + 1) * (xSegments + 1) + x));
+            }
+        }
+
+        oddRow = !oddRow;
+    }
+
+    // Build the mesh
+    lug::Graphics::Builder::Mesh meshBuilder(renderer);
+    meshBuilder.setName("sphere");
+
+    lug::Graphics::Builder::Mesh::PrimitiveSet* primitiveSet = meshBuilder.addPrimitiveSet();
+
+    primitiveSet->setMode(lug::Graphics::Render::Mesh::PrimitiveSet::Mode::TriangleStrip);
+
+    primitiveSet->addAttributeBuffer(
+        indices.data(),
+        sizeof(uint16_t),
+        static_cast<uint32_t>(indices.size()),
+        lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Indice
+    );
+
+    primitiveSet->addAttributeBuffer(
+        positions.data(),
+        sizeof(lug::Math::Vec3f),
+        static_cast<uint32_t>(positions.size()),
+        lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Position
+    );
+
+    primitiveSet->addAttributeBuffer(
+        normals.data(),
+        sizeof(lug::Math::Vec3f),
+        static_cast<uint32_t>(normals.size()),
+        lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::Normal
+    );
+
+    primitiveSet->addAttributeBuffer(
+        uvs.data(),
+        sizeof(lug::Math::Vec2f),
+        static_cast<uint32_t>(uvs.size()),
+        lug::Graphics::Render::Mesh::PrimitiveSet::Attribute::Type::TexCoord
+    );
+
+    lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Mesh> mesh = meshBuilder.build();
+
+    if (!mesh) {
+        LUG_LOG.error("ProceduralMesh: Can't create the sphere mesh");
+    }
+
+    return mesh;
+}
+
+} // ProceduralMesh
@@ -0,0 +1,92 @@
+#include "ResourceFileSystem.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+
+#include <lug/System/Logger/Logger.hpp>
+
+#include "Archive.hpp"
+
+namespace ResourceFileSystem {
+
+namespace {
+
+std::vector<std::unique_ptr<Archive>> archives;
+Stats stats{};
+
+bool readFile(const std::string& path, File& file) {
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+
+    ++stats.fileOpenCount;
+
+    if (!stream) {
+        return false;
+    }
+
+    file.buffer.resize(static_cast<size_t>(stream.tellg()));
+    stream.seekg(0);
+
+    if (!stream.read(reinterpret_cast<char*>(file.buffer.data()), file.buffer.size())) {
+        return false;
+    }
+
+    file.data = file.buffer.data();
+    file.size = file.buffer.size();
+
+    return true;
+}
+
+} // anonymous
+
+bool mount(const std::string& filename) {
+    std::unique_ptr<Archive> archive = std::make_unique<Archive>();
+
+    if (!archive->open(filename)) {
+        return false;
+    }
+
+    LUG_LOG.info("ResourceFileSystem: Mounted {} ({} entries)", filename, archive->getEntryCount());
+
+    archives.push_back(std::move(archive));
+
+    return true;
+}
+
+void unmountAll() {
+    archives.clear();
+}
+
+bool read(const std::string& path, File& file) {
+    const auto start = std::chrono::steady_clock::now();
+
+    bool found = false;
+
+    for (auto it = archives.rbegin(); it != archives.rend() && !found; ++it) {
+        if ((*it)->contains(path)) {
+            if (!(*it)->read(path, file.buffer, file.data, file.size)) {
+                return false;
+            }
+
+            found = true;
+            ++stats.archiveReadCount;
+        }
+    }
+
+    if (!found && !readFile(path, file)) {
+        LUG_LOG.error("ResourceFileSystem: Can't read {}", path);
+        return false;
+    }
+
+    ++stats.readCount;
+    stats.bytes += file.size;
+    stats.milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    return true;
+}
+
+const Stats& getStats() {
+    return stats;
+}
+
+} // ResourceFileSystem
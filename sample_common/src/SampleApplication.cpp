@@ -0,0 +1,128 @@
+#include "SampleApplication.hpp"
+
+#include <cstring>
+
+#include <lug/Graphics/Renderer.hpp>
+#include <lug/Graphics/Vulkan/Renderer.hpp>
+#include <lug/System/Logger/Logger.hpp>
+
+#include "Trace.hpp"
+
+SampleApplication::SampleApplication(const lug::Core::Application::Info& info) : lug::Core::Application::Application{info} {}
+
+bool SampleApplication::init(int argc, char* argv[]) {
+    if (!lug::Core::Application::init(argc, argv)) {
+        return false;
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--perf-csv") == 0 && i + 1 < argc) {
+            _perfCsvFilename = argv[++i];
+        } else if (std::strcmp(argv[i], "--record-input") == 0 && i + 1 < argc) {
+            _recordInputFilename = argv[++i];
+        } else if (std::strcmp(argv[i], "--replay-input") == 0 && i + 1 < argc) {
+            if (!_inputReplay.load(argv[++i])) {
+                return false;
+            }
+        }
+    }
+
+    if (!_framePacer.parseArguments(argc, argv)) {
+        return false;
+    }
+
+    _perfUpdateSection = _perfOverlay.addSection("update");
+
+    return true;
+}
+
+void SampleApplication::onEvent(const lug::Window::Event& event) {
+    if (!_recordInputFilename.empty()) {
+        _inputRecorder.addEvent(event);
+    }
+
+    if (event.type == lug::Window::Event::Type::Close) {
+        if (!_perfCsvFilename.empty() && !_perfOverlay.dumpCsv(_perfCsvFilename)) {
+            LUG_LOG.error("Application: Can't write the performance records to {}", _perfCsvFilename);
+        }
+
+        if (!_recordInputFilename.empty() && !_inputRecorder.save(_recordInputFilename)) {
+            LUG_LOG.error("Application: Can't write the input recording to {}", _recordInputFilename);
+        }
+
+        _framePacer.logStats();
+
+        onClose();
+
+        close();
+    } else if (event.type == lug::Window::Event::Type::KeyPressed && event.key.code == lug::Window::Keyboard::Key::F3) {
+        _perfOverlay.toggle();
+    }
+}
+
+void SampleApplication::onFrame(const lug::System::Time& elapsedTime) {
+    SAMPLE_TRACE_ZONE("frame");
+
+    _framePacer.beginFrame();
+
+    _perfOverlay.beginFrame(elapsedTime.getMilliseconds<float>());
+
+    {
+        PerfOverlay::ScopedSection section(_perfOverlay, _perfUpdateSection);
+        updateMovement(elapsedTime);
+    }
+
+    onSampleFrame(elapsedTime);
+
+    _perfOverlay.draw();
+
+    if (_perfOverlay.isVisible()) {
+        _framePacer.draw();
+    }
+
+    _framePacer.endFrame();
+}
+
+void SampleApplication::setMovedCamera(lug::Graphics::Scene::Node& node) {
+    _movedCamera = &node;
+
+    _mover.setTargetNode(node);
+    _mover.setEventSource(*_graphics.getRenderer()->getWindow());
+}
+
+lug::System::Time SampleApplication::getSimulationTime(const lug::System::Time& elapsedTime) const {
+    return _inputReplay.isLoaded() ? _inputReplay.getElapsedTime() : elapsedTime;
+}
+
+void SampleApplication::updateMovement(const lug::System::Time& elapsedTime) {
+    if (!_movedCamera) {
+        return;
+    }
+
+    if (_inputReplay.isLoaded()) {
+        // The camera follows the recorded poses, the mouse and the keyboard are ignored
+        if (!_inputReplay.nextFrame(*_movedCamera, elapsedTime)) {
+            LUG_LOG.info(
+                "Application: Replayed {} frames in {:.1f} ms ({:.3f} ms per frame)",
+                _inputReplay.getReplayedFrameCount(),
+                _inputReplay.getReplayedMilliseconds(),
+                _inputReplay.getReplayedMilliseconds() / _inputReplay.getReplayedFrameCount()
+            );
+
+            lug::Window::Event event{};
+            event.type = lug::Window::Event::Type::Close;
+            onEvent(event);
+            return;
+        }
+
+        for (uint32_t i = 0; i < _inputReplay.getFrameEventCount(); ++i) {
+            onEvent(_inputReplay.getFrameEvents()[i]);
+        }
+    } else {
+        _mover.onFrame(elapsedTime);
+    }
+
+    if (!_recordInputFilename.empty()) {
+        _inputRecorder.endFrame(elapsedTime, *_movedCamera);
+    }
+}
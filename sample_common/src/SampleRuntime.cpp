@@ -0,0 +1,82 @@
+#include "SampleRuntime.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#if defined(LUG_SYSTEM_ANDROID)
+    #include <lug/System/Logger/LogCatHandler.hpp>
+#else
+    #include <lug/System/Logger/OstreamHandler.hpp>
+
+    #include "AsyncHandler.hpp"
+    #include "LoggingBenchmark.hpp"
+#endif
+
+namespace SampleRuntime {
+
+namespace {
+
+std::string traceFilename;
+
+} // anonymous
+
+bool begin(int argc, char* argv[], Logging logging) {
+#if !defined(LUG_SYSTEM_ANDROID)
+    bool asyncLogging = logging == Logging::Async;
+    bool benchmarkLogging = false;
+    AsyncHandler::OverflowPolicy overflowPolicy = AsyncHandler::OverflowPolicy::Block;
+#endif
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            traceFilename = argv[i + 1];
+        }
+#if !defined(LUG_SYSTEM_ANDROID)
+        if (std::strcmp(argv[i], "--log-sync") == 0) {
+            asyncLogging = false;
+        }
+
+        if (std::strcmp(argv[i], "--log-drop") == 0) {
+            overflowPolicy = AsyncHandler::OverflowPolicy::Drop;
+        }
+
+        if (std::strcmp(argv[i], "--benchmark-logging") == 0) {
+            benchmarkLogging = true;
+        }
+#endif
+    }
+
+#if defined(LUG_SYSTEM_ANDROID)
+    (void)logging;
+
+    LUG_LOG.addHandler(lug::System::Logger::makeHandler<lug::System::Logger::LogCatHandler>("logcat"));
+#else
+    // A slow stdout (a pipe to journald for example) would stall the threads that log
+    if (asyncLogging) {
+        LUG_LOG.addHandler(lug::System::Logger::makeHandler<AsyncHandler>("stdout", std::cout, overflowPolicy));
+    } else {
+        LUG_LOG.addHandler(lug::System::Logger::makeHandler<lug::System::Logger::StdoutHandler>("stdout"));
+    }
+
+    if (benchmarkLogging) {
+        LoggingBenchmark::run(overflowPolicy);
+        return false;
+    }
+#endif
+
+    if (!traceFilename.empty()) {
+        Trace::start();
+        SAMPLE_TRACE_THREAD_NAME("main");
+    }
+
+    return true;
+}
+
+void end() {
+    if (!traceFilename.empty() && !Trace::write(traceFilename)) {
+        LUG_LOG.error("SampleRuntime: Can't write the trace to {}", traceFilename);
+    }
+}
+
+} // SampleRuntime
@@ -0,0 +1,87 @@
+#include "SampleScene.hpp"
+
+#include <lug/Graphics/Builder/Camera.hpp>
+#include <lug/Graphics/Builder/Light.hpp>
+#include <lug/Graphics/Vulkan/Renderer.hpp>
+#include <lug/System/Logger/Logger.hpp>
+
+namespace SampleScene {
+
+lug::Graphics::Scene::Node* attachCamera(lug::Graphics::Renderer& renderer, lug::Graphics::Scene::Scene& scene, const std::string& name, uint32_t renderViewIndex) {
+    lug::Graphics::Builder::Camera cameraBuilder(renderer);
+
+    cameraBuilder.setFovY(45.0f);
+    cameraBuilder.setZNear(0.1f);
+    cameraBuilder.setZFar(100.0f);
+
+    lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Camera::Camera> camera = cameraBuilder.build();
+    if (!camera) {
+        LUG_LOG.error("SampleScene: Can't create the camera {}", name);
+        return nullptr;
+    }
+
+    auto& renderViews = renderer.getWindow()->getRenderViews();
+
+    if (renderViewIndex >= renderViews.size()) {
+        LUG_LOG.error("SampleScene: There is no render view {} for the camera {}", renderViewIndex, name);
+        return nullptr;
+    }
+
+    lug::Graphics::Scene::Node* node = scene.createSceneNode(name);
+    scene.getRoot().attachChild(*node);
+
+    node->attachCamera(camera);
+    renderViews[renderViewIndex]->attachCamera(camera);
+
+    return node;
+}
+
+bool attachAmbientLight(lug::Graphics::Renderer& renderer, lug::Graphics::Scene::Scene& scene, const lug::Math::Vec4f& color) {
+    lug::Graphics::Builder::Light lightBuilder(renderer);
+
+    lightBuilder.setType(lug::Graphics::Render::Light::Type::Ambient);
+    lightBuilder.setColor(color);
+
+    lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Light> light = lightBuilder.build();
+    if (!light) {
+        LUG_LOG.error("SampleScene: Can't create the ambient light");
+        return false;
+    }
+
+    scene.getRoot().attachLight(light);
+
+    return true;
+}
+
+bool attachPointLights(lug::Graphics::Renderer& renderer, lug::Graphics::Scene::Scene& scene) {
+    const lug::Math::Vec3f lightPositions[] = {
+        lug::Math::Vec3f{-10.0f,  10.0f, 10.0f},
+        lug::Math::Vec3f{ 10.0f,  10.0f, 10.0f},
+        lug::Math::Vec3f{-10.0f, -10.0f, 10.0f},
+        lug::Math::Vec3f{ 10.0f, -10.0f, 10.0f},
+    };
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        lug::Graphics::Builder::Light lightBuilder(renderer);
+
+        lightBuilder.setType(lug::Graphics::Render::Light::Type::Point);
+        lightBuilder.setColor({300.0f, 300.0f, 300.0f, 1.0f});
+        lightBuilder.setLinearAttenuation(0.0f);
+
+        lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Light> light = lightBuilder.build();
+        if (!light) {
+            LUG_LOG.error("SampleScene: Can't create the point light {}", i);
+            return false;
+        }
+
+        lug::Graphics::Scene::Node* node = scene.createSceneNode("light" + std::to_string(i));
+        scene.getRoot().attachChild(*node);
+
+        node->setPosition(lightPositions[i]);
+        node->attachLight(light);
+    }
+
+    return true;
+}
+
+} // SampleScene
@@ -0,0 +1,33 @@
+#include "SampleTest.hpp"
+
+#include <cstdint>
+#include <cstdio>
+
+namespace SampleTest {
+
+bool check(bool condition, const char* message) {
+    if (!condition) {
+        std::printf("FAILED: %s\n", message);
+    }
+
+    return condition;
+}
+
+int run(std::initializer_list<Test> tests) {
+    uint32_t failedCount = 0;
+
+    for (const Test& test : tests) {
+        const bool success = test.function();
+        std::printf("%s: %s\n", test.name, success ? "passed" : "FAILED");
+
+        if (!success) {
+            ++failedCount;
+        }
+    }
+
+    std::printf("%u of %zu tests failed\n", failedCount, tests.size());
+
+    return failedCount == 0 ? 0 : 1;
+}
+
+} // SampleTest
@@ -0,0 +1,36 @@
+#include "SpinAnimation.hpp"
+
+#include <lug/Math/Geometry/Trigonometry.hpp>
+
+SpinAnimation::SpinAnimation(float speed) : _speed(speed) {}
+
+float SpinAnimation::update(FramePacer& framePacer, float elapsedSeconds) {
+    if (framePacer.getMode() == FramePacer::Mode::FixedStep) {
+        // The simulation advances by fixed ticks, the rendered angle is interpolated between the last two
+        const uint32_t tickCount = framePacer.advance(elapsedSeconds);
+
+        for (uint32_t i = 0; i < tickCount; ++i) {
+            _previousAngle = _angle;
+            _angle += _speed * framePacer.getTickSeconds();
+        }
+    } else {
+        _angle += _speed * elapsedSeconds;
+        _previousAngle = _angle;
+    }
+
+    // Keep the angles small, the precision of the differences would drop over time
+    const float turn = 2.0f * lug::Math::pi<float>();
+
+    if (_previousAngle > turn) {
+        _angle -= turn;
+        _previousAngle -= turn;
+        _renderedAngle -= turn;
+    }
+
+    const float angle = _previousAngle + (_angle - _previousAngle) * framePacer.getInterpolation();
+    const float rotation = angle - _renderedAngle;
+
+    _renderedAngle = angle;
+
+    return rotation;
+}
@@ -0,0 +1,111 @@
+#include "TextureCache.hpp"
+
+#include <vector>
+
+#include <lug/Graphics/Builder/Texture.hpp>
+#include <lug/System/Logger/Logger.hpp>
+
+lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Texture> TextureCache::load(lug::Graphics::Renderer& renderer, const std::string& filename, const Settings& settings) {
+    // The settings can't appear in a path
+    std::string key = canonicalize(filename);
+    key += '\0';
+    key += static_cast<char>(settings.minFilter);
+    key += static_cast<char>(settings.magFilter);
+
+    const auto it = _entries.find(key);
+
+    if (it != _entries.end()) {
+        ++_stats.hitCount;
+        _stats.savedBytes += it->second.size;
+
+        return it->second.texture;
+    }
+
+    lug::Graphics::Builder::Texture textureBuilder(renderer);
+
+    if (!textureBuilder.addLayer(filename)) {
+        LUG_LOG.error("TextureCache: Can't load {}", filename);
+        return nullptr;
+    }
+
+    textureBuilder.setMinFilter(settings.minFilter);
+    textureBuilder.setMagFilter(settings.magFilter);
+
+    lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Texture> texture = textureBuilder.build();
+    if (!texture) {
+        LUG_LOG.error("TextureCache: Can't create the texture of {}", filename);
+        return nullptr;
+    }
+
+    // The engine uploads the textures as RGBA8
+    const uint64_t size = uint64_t(texture->getWidth()) * texture->getHeight() * 4;
+
+    ++_stats.missCount;
+    _stats.loadedBytes += size;
+
+    _entries.emplace(std::move(key), Entry{texture, size});
+
+    return texture;
+}
+
+lug::Graphics::Resource::SharedPtr<lug::Graphics::Render::Texture> TextureCache::load(lug::Graphics::Renderer& renderer, const std::string& filename) {
+    return load(renderer, filename, Settings{});
+}
+
+void TextureCache::clear() {
+    _entries.clear();
+}
+
+uint32_t TextureCache::getTextureCount() const {
+    return static_cast<uint32_t>(_entries.size());
+}
+
+const TextureCache::Stats& TextureCache::getStats() const {
+    return _stats;
+}
+
+void TextureCache::logStats() const {
+    LUG_LOG.info(
+        "TextureCache: {} hits, {} misses, {:.1f} MB loaded, {:.1f} MB saved",
+        _stats.hitCount, _stats.missCount, _stats.loadedBytes / (1024.0f * 1024.0f), _stats.savedBytes / (1024.0f * 1024.0f)
+    );
+}
+
+std::string TextureCache::canonicalize(const std::string& path) {
+    std::vector<std::string> components;
+    const bool absolute = !path.empty() && (path[0] == '/' || path[0] == '\\');
+
+    std::string component;
+
+    for (size_t i = 0; i <= path.size(); ++i) {
+        if (i < path.size() && path[i] != '/' && path[i] != '\\') {
+            component += path[i];
+            continue;
+        }
+
+        if (component == "..") {
+            // A leading ".." of a relative path can't be resolved
+            if (!components.empty() && components.back() != "..") {
+                components.pop_back();
+            } else if (!absolute) {
+                components.push_back(component);
+            }
+        } else if (!component.empty() && component != ".") {
+            components.push_back(component);
+        }
+
+        component.clear();
+    }
+
+    std::string canonical = absolute ? "/" : "";
+
+    for (size_t i = 0; i < components.size(); ++i) {
+        if (i > 0) {
+            canonical += '/';
+        }
+
+        canonical += components[i];
+    }
+
+    return canonical;
+}
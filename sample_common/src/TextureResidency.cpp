@@ -0,0 +1,273 @@
+#include "TextureResidency.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <imgui.h>
+
+#include <lug/System/Logger/Logger.hpp>
+
+constexpr uint32_t TextureResidency::tailSize;
+constexpr uint32_t TextureResidency::invalidTexture;
+
+namespace {
+
+constexpr float megabyte = 1024.0f * 1024.0f;
+
+} // anonymous
+
+TextureResidency::FakeAllocator::FakeAllocator(uint64_t capacity) : _capacity(capacity) {}
+
+bool TextureResidency::FakeAllocator::allocate(uint32_t, uint32_t, uint64_t size) {
+    if (size > _capacity - _allocatedBytes) {
+        return false;
+    }
+
+    _allocatedBytes += size;
+    ++_allocationCount;
+
+    return true;
+}
+
+void TextureResidency::FakeAllocator::release(uint32_t, uint32_t, uint64_t size) {
+    _allocatedBytes -= size;
+}
+
+uint64_t TextureResidency::FakeAllocator::getAllocatedBytes() const {
+    return _allocatedBytes;
+}
+
+uint64_t TextureResidency::FakeAllocator::getAllocationCount() const {
+    return _allocationCount;
+}
+
+TextureResidency::TextureResidency(Allocator& allocator, uint64_t budget, uint64_t streamBytesPerUpdate)
+    : _allocator(allocator), _budget(budget), _streamBytesPerUpdate(streamBytesPerUpdate) {}
+
+TextureResidency::~TextureResidency() {
+    for (uint32_t id = 0; id < _textures.size(); ++id) {
+        Texture& texture = _textures[id];
+
+        while (texture.residentMip < texture.tailMip) {
+            evictMip(id);
+        }
+
+        uint64_t tailBytes = 0;
+        for (uint32_t mip = texture.tailMip; mip < texture.mipCount; ++mip) {
+            tailBytes += getMipSize(texture, mip);
+        }
+
+        _allocator.release(id, texture.tailMip, tailBytes);
+    }
+}
+
+uint32_t TextureResidency::addTexture(const std::string& name, uint32_t width, uint32_t height, uint32_t bytesPerTexel) {
+    const uint32_t id = static_cast<uint32_t>(_textures.size());
+
+    Texture texture{name, width, height, bytesPerTexel, 1, 0, 0, 0, 0.0f};
+
+    while ((std::max(width, height) >> texture.mipCount) > 0) {
+        ++texture.mipCount;
+    }
+
+    while (texture.tailMip + 1 < texture.mipCount && (std::max(width, height) >> texture.tailMip) > tailSize) {
+        ++texture.tailMip;
+    }
+
+    uint64_t tailBytes = 0;
+    for (uint32_t mip = texture.tailMip; mip < texture.mipCount; ++mip) {
+        tailBytes += getMipSize(texture, mip);
+    }
+
+    // The tails are resident whatever the budget, the textures are never missing
+    if (!_allocator.allocate(id, texture.tailMip, tailBytes)) {
+        LUG_LOG.error("TextureResidency: Can't allocate the mip tail of {}", name);
+        ++_stats.failedAllocationCount;
+        return invalidTexture;
+    }
+
+    texture.residentMip = texture.tailMip;
+    texture.wantedMip = texture.tailMip;
+
+    _stats.residentBytes += tailBytes;
+    _stats.peakResidentBytes = std::max(_stats.peakResidentBytes, _stats.residentBytes);
+    _stats.tailBytes += tailBytes;
+    _stats.residentMipCount += texture.mipCount - texture.tailMip;
+
+    _textures.push_back(texture);
+
+    _lru.push_back(id);
+    _lruPositions.push_back(std::prev(_lru.end()));
+
+    return id;
+}
+
+void TextureResidency::request(uint32_t texture, float pixels) {
+    _textures[texture].requestedPixels = std::max(_textures[texture].requestedPixels, pixels);
+    touch(texture);
+}
+
+void TextureResidency::update(float elapsedSeconds) {
+    // The textures that were not requested only need their tail, but keep their levels until evicted
+    for (Texture& texture : _textures) {
+        uint32_t wantedMip = texture.tailMip;
+
+        if (texture.requestedPixels > 0.0f && texture.width > texture.requestedPixels) {
+            wantedMip = std::min(texture.tailMip, static_cast<uint32_t>(std::log2(texture.width / texture.requestedPixels)));
+        } else if (texture.requestedPixels > 0.0f) {
+            wantedMip = 0;
+        }
+
+        texture.wantedMip = wantedMip;
+        texture.requestedPixels = 0.0f;
+    }
+
+    uint64_t streamedBytes = 0;
+    bool bandwidthLeft = true;
+
+    // The most recently requested textures are streamed first
+    for (auto it = _lru.begin(); it != _lru.end() && bandwidthLeft; ++it) {
+        Texture& texture = _textures[*it];
+
+        while (texture.residentMip > texture.wantedMip) {
+            const uint32_t mip = texture.residentMip - 1;
+            const uint64_t size = getMipSize(texture, mip);
+
+            // A level larger than the bandwidth of an update is streamed alone
+            if (streamedBytes && streamedBytes + size > _streamBytesPerUpdate) {
+                bandwidthLeft = false;
+                break;
+            }
+
+            if (!makeRoom(size)) {
+                ++_stats.budgetLimitedCount;
+                break;
+            }
+
+            if (!_allocator.allocate(*it, mip, size)) {
+                ++_stats.failedAllocationCount;
+                break;
+            }
+
+            texture.residentMip = mip;
+            streamedBytes += size;
+
+            _stats.residentBytes += size;
+            _stats.peakResidentBytes = std::max(_stats.peakResidentBytes, _stats.residentBytes);
+            ++_stats.residentMipCount;
+            _stats.streamedBytes += size;
+            ++_stats.streamedMipCount;
+        }
+    }
+
+    if (elapsedSeconds > 0.0f) {
+        _bandwidth += (streamedBytes / elapsedSeconds - _bandwidth) * std::min(1.0f, elapsedSeconds);
+    }
+}
+
+uint32_t TextureResidency::getTextureCount() const {
+    return static_cast<uint32_t>(_textures.size());
+}
+
+uint32_t TextureResidency::getMipCount(uint32_t texture) const {
+    return _textures[texture].mipCount;
+}
+
+uint32_t TextureResidency::getResidentMip(uint32_t texture) const {
+    return _textures[texture].residentMip;
+}
+
+uint32_t TextureResidency::getWantedMip(uint32_t texture) const {
+    return _textures[texture].wantedMip;
+}
+
+uint64_t TextureResidency::getBudget() const {
+    return _budget;
+}
+
+const TextureResidency::Stats& TextureResidency::getStats() const {
+    return _stats;
+}
+
+float TextureResidency::getBandwidth() const {
+    return _bandwidth;
+}
+
+float TextureResidency::getSpherePixels(float radius, float distance, float fovY, float viewportHeight) {
+    // Inside the sphere the texture covers the screen
+    const float diameter = viewportHeight * radius / (std::max(distance, radius) * std::tan(fovY / 2.0f));
+
+    // The texels are the densest at the center of the sphere, where its width spans pi diameters
+    return diameter * 3.14159265f;
+}
+
+void TextureResidency::draw() {
+    ImGui::Begin("Texture residency");
+    {
+        ImGui::SetWindowSize({300, 110 + 15.0f * _textures.size()});
+        ImGui::SetWindowPos({490, 10});
+
+        ImGui::Text("resident: %.1f / %.1f MB (tails %.1f MB)", _stats.residentBytes / megabyte, _budget / megabyte, _stats.tailBytes / megabyte);
+        ImGui::Text("streaming: %.1f MB/s, %.1f MB in total", _bandwidth / megabyte, _stats.streamedBytes / megabyte);
+        ImGui::Text("evictions: %u (%.1f MB)", _stats.evictionCount, _stats.evictedBytes / megabyte);
+
+        ImGui::Separator();
+
+        for (const Texture& texture : _textures) {
+            ImGui::Text(
+                "%s: mip %u (%ux%u), wants %u",
+                texture.name.c_str(),
+                texture.residentMip,
+                std::max(1u, texture.width >> texture.residentMip),
+                std::max(1u, texture.height >> texture.residentMip),
+                texture.wantedMip
+            );
+        }
+    }
+    ImGui::End();
+}
+
+void TextureResidency::logStats() const {
+    LUG_LOG.info(
+        "TextureResidency: {:.1f} MB resident (peak {:.1f} MB, budget {:.1f} MB, tails {:.1f} MB), {} mips",
+        _stats.residentBytes / megabyte, _stats.peakResidentBytes / megabyte, _budget / megabyte, _stats.tailBytes / megabyte, _stats.residentMipCount
+    );
+
+    LUG_LOG.info(
+        "TextureResidency: {} mips streamed ({:.1f} MB), {} evicted ({:.1f} MB), {} limited by the budget, {} failed allocations",
+        _stats.streamedMipCount, _stats.streamedBytes / megabyte, _stats.evictionCount, _stats.evictedBytes / megabyte,
+        _stats.budgetLimitedCount, _stats.failedAllocationCount
+    );
+}
+
+uint64_t TextureResidency::getMipSize(const Texture& texture, uint32_t mip) const {
+    return uint64_t(std::max(1u, texture.width >> mip)) * std::max(1u, texture.height >> mip) * texture.bytesPerTexel;
+}
+
+void TextureResidency::touch(uint32_t texture) {
+    _lru.splice(_lru.begin(), _lru, _lruPositions[texture]);
+}
+
+bool TextureResidency::makeRoom(uint64_t size) {
+    // Only the levels finer than needed are evicted, from the least recently used textures
+    for (auto it = _lru.rbegin(); it != _lru.rend() && _stats.residentBytes + size > _budget; ++it) {
+        while (_textures[*it].residentMip < _textures[*it].wantedMip && _stats.residentBytes + size > _budget) {
+            evictMip(*it);
+        }
+    }
+
+    return _stats.residentBytes + size <= _budget;
+}
+
+void TextureResidency::evictMip(uint32_t id) {
+    Texture& texture = _textures[id];
+    const uint64_t size = getMipSize(texture, texture.residentMip);
+
+    _allocator.release(id, texture.residentMip, size);
+    ++texture.residentMip;
+
+    _stats.residentBytes -= size;
+    --_stats.residentMipCount;
+    _stats.evictedBytes += size;
+    ++_stats.evictionCount;
+}
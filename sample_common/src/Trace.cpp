@@ -0,0 +1,180 @@
+#include "Trace.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Trace {
+
+namespace {
+
+struct Event {
+    const char* name;
+    uint64_t begin;
+    uint64_t end;
+};
+
+constexpr uint32_t chunkSize = 1024;
+
+struct Chunk {
+    Event events[chunkSize];
+    std::atomic<Chunk*> next{nullptr};
+};
+
+// Written only by its thread, a chunk is linked and the count is published after the event, so
+// the writer can read the buffer while the thread keeps recording. Chunks are allocated on
+// demand, short lived threads only cost one chunk.
+struct ThreadBuffer {
+    uint32_t id;
+    std::atomic<const char*> name{nullptr};
+
+    Chunk first;
+    Chunk* current{&first};
+    std::vector<std::unique_ptr<Chunk>> chunks;
+
+    std::atomic<uint32_t> count{0};
+    std::atomic<uint32_t> dropped{0};
+};
+
+std::mutex buffersMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+uint32_t eventsPerThreadCapacity = 0;
+
+// Set by start(), to calibrate the ticks against the steady clock
+uint64_t originTicks = 0;
+std::chrono::steady_clock::time_point originTime;
+
+thread_local ThreadBuffer* threadBuffer = nullptr;
+
+ThreadBuffer& getThreadBuffer() {
+    if (!threadBuffer) {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+
+        std::unique_ptr<ThreadBuffer> buffer = std::make_unique<ThreadBuffer>();
+
+        buffer->id = static_cast<uint32_t>(buffers.size());
+
+        threadBuffer = buffer.get();
+        buffers.push_back(std::move(buffer));
+    }
+
+    return *threadBuffer;
+}
+
+void writeString(std::ofstream& file, const char* string) {
+    file << '"';
+
+    for (const char* c = string; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            file << '\\';
+        }
+
+        file << *c;
+    }
+
+    file << '"';
+}
+
+} // anonymous
+
+namespace priv {
+
+std::atomic<bool> enabled{false};
+
+void record(const char* name, uint64_t begin, uint64_t end) {
+    ThreadBuffer& buffer = getThreadBuffer();
+    const uint32_t count = buffer.count.load(std::memory_order_relaxed);
+
+    if (count >= eventsPerThreadCapacity) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (count && count % chunkSize == 0) {
+        buffer.chunks.push_back(std::make_unique<Chunk>());
+        buffer.current->next.store(buffer.chunks.back().get(), std::memory_order_release);
+        buffer.current = buffer.chunks.back().get();
+    }
+
+    buffer.current->events[count % chunkSize] = {name, begin, end};
+    buffer.count.store(count + 1, std::memory_order_release);
+}
+
+} // priv
+
+void start(uint32_t eventsPerThread) {
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        eventsPerThreadCapacity = eventsPerThread;
+
+        originTicks = priv::now();
+        originTime = std::chrono::steady_clock::now();
+    }
+
+    priv::enabled.store(true, std::memory_order_relaxed);
+}
+
+void setThreadName(const char* name) {
+    if (priv::enabled.load(std::memory_order_relaxed)) {
+        getThreadBuffer().name.store(name, std::memory_order_release);
+    }
+}
+
+bool write(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+
+    const double elapsedMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - originTime).count();
+    const double ticksPerMicrosecond = elapsedMicroseconds > 0.0 ? (priv::now() - originTicks) / elapsedMicroseconds : 1000.0;
+
+    bool first = true;
+
+    file << std::fixed << std::setprecision(3);
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    for (const std::unique_ptr<ThreadBuffer>& buffer : buffers) {
+        const char* name = buffer->name.load(std::memory_order_acquire);
+
+        if (name) {
+            file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id << ",\"args\":{\"name\":";
+            writeString(file, name);
+            file << "}}";
+
+            first = false;
+        }
+
+        const uint32_t count = buffer->count.load(std::memory_order_acquire);
+
+        // Timestamps are in microseconds, events recorded before start() can't exist
+        const Chunk* chunk = &buffer->first;
+
+        for (uint32_t i = 0; i < count; ++i) {
+            if (i && i % chunkSize == 0) {
+                chunk = chunk->next.load(std::memory_order_acquire);
+            }
+
+            const Event& event = chunk->events[i % chunkSize];
+
+            file << (first ? "" : ",\n") << "{\"name\":";
+            writeString(file, event.name);
+            file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id
+                 << ",\"ts\":" << (event.begin - originTicks) / ticksPerMicrosecond
+                 << ",\"dur\":" << (event.end - event.begin) / ticksPerMicrosecond << "}";
+
+            first = false;
+        }
+    }
+
+    file << "\n]}\n";
+
+    return !!file;
+}
+
+} // Trace
@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BlockCompress.hpp"
+#include "ImageFile.hpp"
+#include "MipFileWriter.hpp"
+#include "MipGenerator.hpp"
+
+// Cooks an image in a mip ordered texture, see MipFormat
+//
+// lug-cook-mips [--content color|linear|normal] [--kernel box|triangle|kaiser|lanczos3]
+//               [--format rgba8|auto|bc1|bc3|bc5] [--quality fast|normal|high] <cooked> <image>
+//
+// The mips of a color texture are filtered in linear space, the normals of a normal map are renormalized.
+// The auto format picks BC5 for the normal maps, BC3 for the translucent textures and BC1 otherwise.
+int main(int argc, char* argv[]) {
+    MipGenerator::Settings settings;
+    settings.threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    BlockCompress::Settings compressSettings;
+    compressSettings.format = BlockCompress::Format::Rgba8;
+    compressSettings.threadCount = settings.threadCount;
+
+    bool autoFormat = false;
+
+    int first = 1;
+
+    for (; first + 1 < argc && std::strncmp(argv[first], "--", 2) == 0; first += 2) {
+        const std::string option = argv[first];
+        const std::string value = argv[first + 1];
+
+        bool valid = false;
+
+        if (option == "--content") {
+            for (MipGenerator::Content content : {MipGenerator::Content::Color, MipGenerator::Content::Linear, MipGenerator::Content::Normal}) {
+                if (value == MipGenerator::getName(content)) {
+                    settings.content = content;
+                    valid = true;
+                }
+            }
+        } else if (option == "--kernel") {
+            for (MipGenerator::Kernel kernel : {MipGenerator::Kernel::Box, MipGenerator::Kernel::Triangle, MipGenerator::Kernel::Kaiser, MipGenerator::Kernel::Lanczos3}) {
+                if (value == MipGenerator::getName(kernel)) {
+                    settings.kernel = kernel;
+                    valid = true;
+                }
+            }
+        } else if (option == "--format") {
+            autoFormat = value == "auto";
+            valid = autoFormat;
+
+            for (BlockCompress::Format format : {BlockCompress::Format::Rgba8, BlockCompress::Format::Bc1, BlockCompress::Format::Bc3, BlockCompress::Format::Bc5}) {
+                if (value == BlockCompress::getName(format)) {
+                    compressSettings.format = format;
+                    valid = true;
+                }
+            }
+        } else if (option == "--quality") {
+            for (BlockCompress::Quality quality : {BlockCompress::Quality::Fast, BlockCompress::Quality::Normal, BlockCompress::Quality::High}) {
+                if (value == BlockCompress::getName(quality)) {
+                    compressSettings.quality = quality;
+                    valid = true;
+                }
+            }
+        }
+
+        if (!valid) {
+            std::cerr << "Invalid option " << option << " " << value << std::endl;
+            return 1;
+        }
+    }
+
+    if (argc - first != 2) {
+        std::cerr << "Usage: " << argv[0] << " [--content color|linear|normal] [--kernel box|triangle|kaiser|lanczos3]"
+                  << " [--format rgba8|auto|bc1|bc3|bc5] [--quality fast|normal|high] <cooked> <image>" << std::endl;
+        return 1;
+    }
+
+    const std::string cooked = argv[first];
+    const std::string image = argv[first + 1];
+
+    ImageFile::Image source;
+
+    if (!ImageFile::load(image, source, 4)) {
+        std::cerr << "Can't load " << image << std::endl;
+        return 1;
+    }
+
+    if (autoFormat) {
+        compressSettings.format = BlockCompress::selectFormat(source.texels.data(), size_t(source.width) * source.height, settings.content == MipGenerator::Content::Normal);
+    }
+
+    std::vector<MipGenerator::Level> levels;
+    MipGenerator::generate(source.width, source.height, source.texels.data(), settings, levels);
+
+    uint64_t uncompressedBytes = 0;
+    uint64_t compressedBytes = 0;
+    float psnr = 0.0f;
+    float milliseconds = 0.0f;
+
+    // The levels are compressed in place, the report compares them with the RGBA8 ones
+    if (compressSettings.format != BlockCompress::Format::Rgba8) {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<uint8_t> data;
+
+        for (MipGenerator::Level& level : levels) {
+            BlockCompress::encode(level.width, level.height, level.texels.data(), compressSettings, data);
+
+            if (&level == &levels.front()) {
+                psnr = BlockCompress::computePsnr(compressSettings.format, level.width, level.height, level.texels.data(), data.data());
+            }
+
+            uncompressedBytes += level.texels.size();
+            compressedBytes += data.size();
+
+            level.texels.swap(data);
+        }
+
+        milliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    if (!MipFileWriter::write(cooked, levels, compressSettings.format)) {
+        std::cerr << "Can't write " << cooked << std::endl;
+        return 1;
+    }
+
+    std::cout << "Cooked " << image << " (" << source.width << "x" << source.height << ", " << MipGenerator::getName(settings.content)
+              << ", " << MipGenerator::getName(settings.kernel) << " kernel) in " << cooked << std::endl;
+
+    if (compressSettings.format != BlockCompress::Format::Rgba8) {
+        std::cout << std::fixed << std::setprecision(1)
+                  << "    " << BlockCompress::getName(compressSettings.format) << " (" << BlockCompress::getName(compressSettings.quality) << " quality)"
+                  << " in " << milliseconds << " ms, PSNR " << psnr << " dB, "
+                  << uncompressedBytes / 1024.0 << " KB -> " << compressedBytes / 1024.0 << " KB" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "ArchiveWriter.hpp"
+
+// Packs the resources of a sample in an archive, see ArchiveFormat
+//
+// lug-pack-resources [--compress] <archive> <root> <path>...
+//
+// The paths are relative to the root, they are the ones the sample reads the resources with.
+int main(int argc, char* argv[]) {
+    int first = 1;
+    bool compress = false;
+
+    if (argc > first && std::strcmp(argv[first], "--compress") == 0) {
+        compress = true;
+        ++first;
+    }
+
+    if (argc - first < 2) {
+        std::cerr << "Usage: " << argv[0] << " [--compress] <archive> <root> <path>..." << std::endl;
+        return 1;
+    }
+
+    const std::string archive = argv[first];
+    const std::string root = argv[first + 1];
+
+    ArchiveWriter writer;
+
+    for (int i = first + 2; i < argc; ++i) {
+        const std::string path = argv[i];
+        std::ifstream file(root + "/" + path, std::ios::binary);
+
+        if (!file) {
+            std::cerr << "Can't open " << root << "/" << path << std::endl;
+            return 1;
+        }
+
+        std::vector<uint8_t> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+        if (!writer.add(path, std::move(data), compress)) {
+            std::cerr << path << " is listed twice" << std::endl;
+            return 1;
+        }
+    }
+
+    if (!writer.write(archive)) {
+        std::cerr << "Can't write " << archive << std::endl;
+        return 1;
+    }
+
+    std::cout << "Packed " << argc - first - 2 << " files in " << archive
+              << " (" << writer.getSize() << " bytes, " << writer.getStoredSize() << " stored)" << std::endl;
+
+    return 0;
+}